@@ -48,6 +48,7 @@
 #include "pbd/error.h"
 #include "pbd/basename.h"
 #include "pbd/compose.h"
+#include "pbd/debug.h"
 #include "pbd/failed_constructor.h"
 #include "pbd/enumwriter.h"
 #include "pbd/memento_command.h"
@@ -68,6 +69,7 @@
 #include "gtkmm2ext/popup.h"
 #include "gtkmm2ext/window_title.h"
 
+#include "ardour/analyser.h"
 #include "ardour/ardour.h"
 #include "ardour/audio_backend.h"
 #include "ardour/audioengine.h"
@@ -372,6 +374,9 @@ ARDOUR_UI::ARDOUR_UI (int *argcp, char **argvp[], const char* localedir)
 
 	ARDOUR::GUIIdle.connect (forever_connections, MISSING_INVALIDATOR, boost::bind(&ARDOUR_UI::gui_idle_handler, this), gui_context());
 
+	/* and transient analysis progress */
+	ARDOUR::Analyser::AnalysisProgress.connect (forever_connections, MISSING_INVALIDATOR, boost::bind (&ARDOUR_UI::analysis_progress, this, _1, _2), gui_context());
+
 	Config->ParameterChanged.connect ( forever_connections, MISSING_INVALIDATOR, boost::bind(&ARDOUR_UI::set_flat_buttons, this), gui_context() );
 	set_flat_buttons();
 
@@ -1269,6 +1274,10 @@ ARDOUR_UI::every_second ()
 	update_timecode_format ();
 	update_peak_thread_work ();
 
+	if (DEBUG_ENABLED (PBD::DEBUG::UIRequests)) {
+		trace_request_stats ();
+	}
+
 	if (nsm && nsm->is_active ()) {
 		nsm->check ();
 
@@ -1283,6 +1292,20 @@ ARDOUR_UI::every_second ()
 	}
 }
 
+/** Report how the GUI's request queues did over the last second */
+void
+ARDOUR_UI::trace_request_stats ()
+{
+#ifndef NDEBUG
+	RequestStats const s = request_stats ();
+	reset_request_stats ();
+
+	DEBUG_TRACE (PBD::DEBUG::UIRequests, string_compose ("%1 wakeups, %2 requests handled, %3 coalesced, max. %4 waiting, latency avg. %5 max. %6 usec\n",
+	                                                      s.wakeups, s.handled, s.coalesced, s.max_depth,
+	                                                      s.handled ? s.total_latency_us / (int64_t) s.handled : 0, s.max_latency_us));
+#endif
+}
+
 void
 ARDOUR_UI::every_point_one_seconds ()
 {
@@ -1481,6 +1504,18 @@ ARDOUR_UI::update_peak_thread_work ()
 	}
 }
 
+void
+ARDOUR_UI::analysis_progress (uint32_t done, uint32_t queued)
+{
+	char buf[64];
+	if (done < queued) {
+		snprintf (buf, sizeof (buf), _("Analysis: %u/%u"), done, queued);
+		analysis_label.set_markup (buf);
+	} else {
+		analysis_label.set_markup (X_(""));
+	}
+}
+
 void
 ARDOUR_UI::update_buffer_load ()
 {
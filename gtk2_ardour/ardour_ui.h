@@ -540,6 +540,9 @@ class ARDOUR_UI : public Gtkmm2ext::UI, public ARDOUR::SessionHandlePtr
 	Gtk::Label   peak_thread_work_label;
 	void update_peak_thread_work ();
 
+	Gtk::Label   analysis_label;
+	void analysis_progress (uint32_t done, uint32_t queued);
+
 	Gtk::Label   buffer_load_label;
 	void update_buffer_load ();
 
@@ -550,6 +553,7 @@ class ARDOUR_UI : public Gtkmm2ext::UI, public ARDOUR::SessionHandlePtr
 	void update_format ();
 
 	void every_second ();
+	void trace_request_stats ();
 	void every_point_one_seconds ();
 	void every_point_zero_something_seconds ();
 
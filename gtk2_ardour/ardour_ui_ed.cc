@@ -530,6 +530,8 @@ ARDOUR_UI::build_menu_bar ()
 	xrun_label.set_use_markup ();
 	peak_thread_work_label.set_name ("PeakThreadWork");
 	peak_thread_work_label.set_use_markup ();
+	analysis_label.set_name ("PeakThreadWork");
+	analysis_label.set_use_markup ();
 	buffer_load_label.set_name ("BufferLoad");
 	buffer_load_label.set_use_markup ();
 	sample_rate_label.set_name ("SampleRate");
@@ -560,6 +562,7 @@ ARDOUR_UI::build_menu_bar ()
 	hbox->pack_end (disk_space_label, false, false, 4);
 	hbox->pack_end (xrun_label, false, false, 4);
 	hbox->pack_end (peak_thread_work_label, false, false, 4);
+	hbox->pack_end (analysis_label, false, false, 4);
 	hbox->pack_end (cpu_load_label, false, false, 4);
 	hbox->pack_end (buffer_load_label, false, false, 4);
 	hbox->pack_end (sample_rate_label, false, false, 4);
@@ -578,6 +581,7 @@ ARDOUR_UI::build_menu_bar ()
 	_status_bar_visibility.add (&cpu_load_label,        X_("DSP"),       _("DSP"), true);
 	_status_bar_visibility.add (&xrun_label,            X_("XRun"),      _("X-run"), false);
 	_status_bar_visibility.add (&peak_thread_work_label,X_("Peakfile"),  _("Active Peak-file Work"), false);
+	_status_bar_visibility.add (&analysis_label,        X_("Analysis"),  _("Transient Analysis"), false);
 	_status_bar_visibility.add (&buffer_load_label,     X_("Buffers"),   _("Buffers"), true);
 	_status_bar_visibility.add (&sample_rate_label,     X_("Audio"),     _("Audio"), true);
 	_status_bar_visibility.add (&timecode_format_label, X_("TCFormat"),  _("Timecode Format"), true);
@@ -109,7 +109,7 @@ AutomationController::AutomationController(boost::shared_ptr<Automatable>
 	_screen_update_connection = Timers::rapid_connect (
 			sigc::mem_fun (*this, &AutomationController::display_effective_value));
 
-	ac->Changed.connect (_changed_connection, invalidator (*this), boost::bind (&AutomationController::value_changed, this), gui_context());
+	ac->Changed.connect (_changed_connection, coalescing_invalidator (*this), boost::bind (&AutomationController::value_changed, this), gui_context());
 
 	add(*_widget);
 	show_all();
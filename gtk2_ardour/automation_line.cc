@@ -1310,7 +1310,7 @@ AutomationLine::connect_to_list ()
 {
 	_list_connections.drop_connections ();
 
-	alist->StateChanged.connect (_list_connections, invalidator (*this), boost::bind (&AutomationLine::list_changed, this), gui_context());
+	alist->StateChanged.connect (_list_connections, coalescing_invalidator (*this), boost::bind (&AutomationLine::list_changed, this), gui_context());
 
 	alist->InterpolationChanged.connect (
 		_list_connections, invalidator (*this), boost::bind (&AutomationLine::interpolation_changed, this, _1), gui_context());
@@ -65,6 +65,7 @@
 #include "gtkmm2ext/choice.h"
 #include "gtkmm2ext/cell_renderer_pixbuf_toggle.h"
 
+#include "ardour/analyser.h"
 #include "ardour/audio_track.h"
 #include "ardour/audioengine.h"
 #include "ardour/audioregion.h"
@@ -743,6 +744,9 @@ Editor::Editor ()
 
 	Gtkmm2ext::Keyboard::the_keyboard().ZoomVerticalModifierReleased.connect (sigc::mem_fun (*this, &Editor::zoom_vertical_modifier_released));
 
+	/* sources may have been queued for analysis since the view last changed */
+	Analyser::AnalysisProgress.connect (*this, invalidator (*this), boost::bind (&Editor::queue_visible_analysis_priority, this), gui_context());
+
 	/* allow external control surfaces/protocols to do various things */
 
 	ControlProtocol::ZoomToSession.connect (*this, invalidator (*this), boost::bind (&Editor::temporal_zoom_session, this), gui_context());
@@ -4685,6 +4689,53 @@ Editor::visual_changer (const VisualChange& vc)
 	}
 
 	_summary->set_overlays_dirty ();
+
+	queue_visible_analysis_priority ();
+}
+
+/** Have the sources of the regions that are on screen analysed before the
+ *  others that are waiting. Deferred to an idle handler, since the view
+ *  often changes many times in a row.
+ */
+void
+Editor::queue_visible_analysis_priority ()
+{
+	if (!visible_analysis_priority_connection.connected ()) {
+		visible_analysis_priority_connection = Glib::signal_idle().connect (sigc::mem_fun (*this, &Editor::set_visible_analysis_priority));
+	}
+}
+
+bool
+Editor::set_visible_analysis_priority ()
+{
+	double const view_min_y = vertical_adjustment.get_value();
+	double const view_max_y = view_min_y + vertical_adjustment.get_page_size();
+	framepos_t const end = leftmost_frame + current_page_samples();
+
+	for (TrackViewList::const_iterator t = track_views.begin(); t != track_views.end(); ++t) {
+
+		if ((*t)->hidden() || (*t)->y_position() >= view_max_y || (*t)->y_position() + (*t)->effective_height() <= view_min_y) {
+			continue;
+		}
+
+		RouteTimeAxisView* rtv = dynamic_cast<RouteTimeAxisView*>(*t);
+		boost::shared_ptr<Track> tr;
+		boost::shared_ptr<Playlist> pl;
+
+		if (!rtv || !(tr = rtv->track()) || !(pl = tr->playlist())) {
+			continue;
+		}
+
+		boost::shared_ptr<RegionList> regions = pl->regions_touched (leftmost_frame, end);
+
+		for (RegionList::const_iterator r = regions->begin(); r != regions->end(); ++r) {
+			for (uint32_t n = 0; n < (*r)->n_channels(); ++n) {
+				Analyser::set_priority ((*r)->source (n), Analyser::Visible);
+			}
+		}
+	}
+
+	return false; /* one-shot */
 }
 
 struct EditorOrderTimeAxisSorter {
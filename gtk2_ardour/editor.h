@@ -1146,6 +1146,10 @@ class Editor : public PublicEditor, public PBD::ScopedConnectionList, public ARD
 	void visual_changer (const VisualChange&);
 	void ensure_visual_change_idle_handler ();
 
+	void queue_visible_analysis_priority ();
+	bool set_visible_analysis_priority ();
+	sigc::connection visible_analysis_priority_connection;
+
 	/* track views */
 	TrackViewList track_views;
 	std::pair<TimeAxisView*, double> trackview_by_y_position (double, bool trackview_relative_offset = true) const;
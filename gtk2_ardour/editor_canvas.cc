@@ -865,6 +865,8 @@ Editor::tie_vertical_scrolling ()
 	if (pending_visual_change.idle_handler_id < 0) {
 		_summary->set_overlays_dirty ();
 	}
+
+	queue_visible_analysis_priority ();
 }
 
 void
@@ -882,6 +884,8 @@ Editor::set_horizontal_position (double p)
 	}
 
 	update_video_timeline();
+
+	queue_visible_analysis_priority ();
 }
 
 void
@@ -4861,7 +4861,8 @@ Editor::reset_point_selection ()
 {
 	for (PointSelection::iterator i = selection->points.begin(); i != selection->points.end(); ++i) {
 		ARDOUR::AutomationList::iterator j = (*i)->model ();
-		(*j)->value = (*i)->line().the_list()->default_value ();
+		boost::shared_ptr<ARDOUR::AutomationList> list = (*i)->line().the_list ();
+		list->modify (j, (*j)->when, list->default_value ());
 	}
 }
 
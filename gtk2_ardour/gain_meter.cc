@@ -243,7 +243,7 @@ GainMeterBase::set_controls (boost::shared_ptr<Route> r,
 		gain_automation_state_changed ();
 	}
 
-	amp->gain_control()->Changed.connect (model_connections, invalidator (*this), boost::bind (&GainMeterBase::gain_changed, this), gui_context());
+	amp->gain_control()->Changed.connect (model_connections, coalescing_invalidator (*this), boost::bind (&GainMeterBase::gain_changed, this), gui_context());
 
 	gain_changed ();
 	show_gain ();
@@ -1176,12 +1176,12 @@ MidiRegionView::redisplay_model()
 
 	MidiModel::ReadLock lock(_model->read_lock());
 
-	MidiModel::Notes& notes (_model->notes());
+	const MidiModel::Notes& notes (_model->notes());
 	_optimization_iterator = _events.begin();
 
 	bool empty_when_starting = _events.empty();
 
-	for (MidiModel::Notes::iterator n = notes.begin(); n != notes.end(); ++n) {
+	for (MidiModel::Notes::const_iterator n = notes.begin(); n != notes.end(); ++n) {
 
 		boost::shared_ptr<NoteType> note (*n);
 		NoteBase* cne;
@@ -2229,7 +2229,7 @@ MidiRegionView::select_matching_notes (uint8_t notenum, uint16_t channel_mask, b
 	bool have_selection = !_selection.empty();
 	uint8_t low_note = 127;
 	uint8_t high_note = 0;
-	MidiModel::Notes& notes (_model->notes());
+	const MidiModel::Notes& notes (_model->notes());
 	_optimization_iterator = _events.begin();
 
 	if (extend && !have_selection) {
@@ -2265,7 +2265,7 @@ MidiRegionView::select_matching_notes (uint8_t notenum, uint16_t channel_mask, b
 
 	_no_sound_notes = true;
 
-	for (MidiModel::Notes::iterator n = notes.begin(); n != notes.end(); ++n) {
+	for (MidiModel::Notes::const_iterator n = notes.begin(); n != notes.end(); ++n) {
 
 		boost::shared_ptr<NoteType> note (*n);
 		NoteBase* cne;
@@ -2299,10 +2299,10 @@ MidiRegionView::select_matching_notes (uint8_t notenum, uint16_t channel_mask, b
 void
 MidiRegionView::toggle_matching_notes (uint8_t notenum, uint16_t channel_mask)
 {
-	MidiModel::Notes& notes (_model->notes());
+	const MidiModel::Notes& notes (_model->notes());
 	_optimization_iterator = _events.begin();
 
-	for (MidiModel::Notes::iterator n = notes.begin(); n != notes.end(); ++n) {
+	for (MidiModel::Notes::const_iterator n = notes.begin(); n != notes.end(); ++n) {
 
 		boost::shared_ptr<NoteType> note (*n);
 		NoteBase* cne;
@@ -120,7 +120,7 @@ PannerUI::set_panner (boost::shared_ptr<PannerShell> ps, boost::shared_ptr<Panne
 		return;
 	}
 
-	_panshell->Changed.connect (connections, invalidator (*this), boost::bind (&PannerUI::panshell_changed, this), gui_context());
+	_panshell->Changed.connect (connections, coalescing_invalidator (*this), boost::bind (&PannerUI::panshell_changed, this), gui_context());
 
         /* new panner object, force complete reset of panner GUI
          */
@@ -1750,6 +1750,16 @@ RCOptionEditor::RCOptionEditor ()
 		procs->set_note (string_compose (_("This setting will only take effect when %1 is restarted."), PROGRAM_NAME));
 
                 add_option (_("Misc"), procs);
+
+		bo = new BoolOption (
+			"parallel-plugin-instances",
+			_("Run replicated plugin instances in parallel"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_parallel_plugin_instances),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_parallel_plugin_instances)
+			);
+		Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+		                                    _("When a plugin is replicated once per channel, let each copy run on a different DSP thread. This can shorten the processing of a single heavy bus."));
+		add_option (_("Misc"), bo);
         }
 
 	add_option (_("Misc"), new OptionEditorHeading (S_("Options|Undo")));
@@ -1774,6 +1784,16 @@ RCOptionEditor::RCOptionEditor ()
 		     sigc::mem_fun (*_rc_config, &RCConfiguration::set_periodic_safety_backups)
 		     ));
 
+	bo = new BoolOption (
+		     "cache-session-state",
+		     _("Keep a binary cache of session files for faster loading"),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::get_cache_session_state),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::set_cache_session_state)
+		     );
+	add_option (_("Misc"), bo);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+					    _("When enabled, a binary copy of each session file is stored next to it and used when loading the session, as long as the session file has not changed."));
+
 	add_option (_("Misc"),
 	     new BoolOption (
 		     "only-copy-imported-files",
@@ -17,24 +17,57 @@
 
 */
 
+#include <algorithm>
+
+#include "pbd/compose.h"
+#include "pbd/cpus.h"
+#include "pbd/error.h"
+
 #include "ardour/analyser.h"
 #include "ardour/audiofilesource.h"
+#include "ardour/progress.h"
 #include "ardour/session_event.h"
 #include "ardour/transient_detector.h"
 
-#include "pbd/compose.h"
-#include "pbd/error.h"
 #include "i18n.h"
 
 using namespace std;
 using namespace ARDOUR;
 using namespace PBD;
 
+/** A source waiting for, or undergoing, analysis. The Progress base
+ *  lets a running analysis be cancelled.
+ */
+class Analyser::Job : public Progress
+{
+  public:
+	Job (boost::shared_ptr<Source> s, Priority p)
+		: source (s)
+		, priority (p)
+		, rerun (false)
+	{}
+
+	void stop () {
+		cancel ();
+	}
+
+	boost::weak_ptr<Source> source;
+	Priority priority;
+	bool rerun; ///< the source was re-queued while it was being analysed
+
+  private:
+	void set_overall_progress (float) {}
+};
+
 Analyser* Analyser::the_analyser = 0;
-Glib::Threads::Mutex Analyser::analysis_active_lock;
 Glib::Threads::Mutex Analyser::analysis_queue_lock;
 Glib::Threads::Cond  Analyser::SourcesToAnalyse;
-list<boost::weak_ptr<Source> > Analyser::analysis_queue;
+Glib::Threads::Cond  Analyser::AnalysisFinished;
+Analyser::JobList Analyser::analysis_queue;
+Analyser::JobList Analyser::active_jobs;
+uint32_t Analyser::jobs_done = 0;
+uint32_t Analyser::jobs_queued = 0;
+PBD::Signal2<void,uint32_t,uint32_t> Analyser::AnalysisProgress;
 
 Analyser::Analyser ()
 {
@@ -54,11 +87,30 @@ analyser_work ()
 void
 Analyser::init ()
 {
-	Glib::Threads::Thread::create (sigc::ptr_fun (analyser_work));
+	uint32_t const n_threads = max (1U, hardware_concurrency ());
+
+	for (uint32_t n = 0; n < n_threads; ++n) {
+		Glib::Threads::Thread::create (sigc::ptr_fun (analyser_work));
+	}
 }
 
+/** Add a job to the queue behind any others of the same or higher priority.
+ *  Caller must hold analysis_queue_lock.
+ */
 void
-Analyser::queue_source_for_analysis (boost::shared_ptr<Source> src, bool force)
+Analyser::enqueue (Job* job)
+{
+	JobList::iterator i = analysis_queue.begin ();
+
+	while (i != analysis_queue.end() && (*i)->priority >= job->priority) {
+		++i;
+	}
+
+	analysis_queue.insert (i, job);
+}
+
+void
+Analyser::queue_source_for_analysis (boost::shared_ptr<Source> src, bool force, Priority p)
 {
 	if (!src->can_be_analysed()) {
 		return;
@@ -69,8 +121,79 @@ Analyser::queue_source_for_analysis (boost::shared_ptr<Source> src, bool force)
 	}
 
 	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
-	analysis_queue.push_back (boost::weak_ptr<Source>(src));
-	SourcesToAnalyse.broadcast ();
+
+	for (JobList::iterator i = analysis_queue.begin(); i != analysis_queue.end(); ++i) {
+		if ((*i)->source.lock() == src) {
+			/* already waiting; never lower its priority here */
+			if ((*i)->priority < p) {
+				Job* job = *i;
+				analysis_queue.erase (i);
+				job->priority = p;
+				enqueue (job);
+			}
+			return;
+		}
+	}
+
+	for (JobList::iterator i = active_jobs.begin(); i != active_jobs.end(); ++i) {
+		if ((*i)->source.lock() == src) {
+			/* being analysed right now; never run a second analysis
+			 * of it alongside, but if forced, analyse it again once
+			 * the running one is done.
+			 */
+			if (force) {
+				(*i)->rerun = true;
+				(*i)->priority = max ((*i)->priority, p);
+			}
+			return;
+		}
+	}
+
+	enqueue (new Job (src, p));
+	++jobs_queued;
+	SourcesToAnalyse.signal ();
+}
+
+void
+Analyser::set_priority (boost::shared_ptr<Source> src, Priority p)
+{
+	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+
+	for (JobList::iterator i = analysis_queue.begin(); i != analysis_queue.end(); ++i) {
+		if ((*i)->source.lock() == src) {
+			Job* job = *i;
+			analysis_queue.erase (i);
+			job->priority = p;
+			enqueue (job);
+			return;
+		}
+	}
+}
+
+/** Remove a source from the queue, or stop its analysis if it has already
+ *  started. An interrupted analysis leaves the source's transients file
+ *  untouched.
+ */
+void
+Analyser::cancel (boost::shared_ptr<Source> src)
+{
+	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+
+	for (JobList::iterator i = analysis_queue.begin(); i != analysis_queue.end(); ) {
+		if ((*i)->source.lock() == src) {
+			delete *i;
+			i = analysis_queue.erase (i);
+			--jobs_queued;
+		} else {
+			++i;
+		}
+	}
+
+	for (JobList::iterator i = active_jobs.begin(); i != active_jobs.end(); ++i) {
+		if ((*i)->source.lock() == src) {
+			(*i)->stop ();
+		}
+	}
 }
 
 void
@@ -79,38 +202,72 @@ Analyser::work ()
 	SessionEvent::create_per_thread_pool ("Analyser", 64);
 
 	while (true) {
-		analysis_queue_lock.lock ();
 
-	  wait:
-		if (analysis_queue.empty()) {
-			SourcesToAnalyse.wait (analysis_queue_lock);
+		Job* job;
+
+		{
+			Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+
+			while (analysis_queue.empty()) {
+				SourcesToAnalyse.wait (analysis_queue_lock);
+			}
+
+			job = analysis_queue.front();
+			analysis_queue.pop_front();
+			active_jobs.push_back (job);
 		}
 
-		if (analysis_queue.empty()) {
-			goto wait;
+		{
+			boost::shared_ptr<AudioFileSource> afs = boost::dynamic_pointer_cast<AudioFileSource> (job->source.lock());
+
+			if (afs && afs->length(afs->timeline_position())) {
+				analyse_audio_file_source (afs, job);
+			}
 		}
 
-		boost::shared_ptr<Source> src (analysis_queue.front().lock());
-		analysis_queue.pop_front();
-		analysis_queue_lock.unlock ();
+		uint32_t done;
+		uint32_t queued;
+
+		{
+			/* declared first so that the last reference to the
+			 * source is never dropped with the queue lock held
+			 */
+			boost::shared_ptr<Source> src = job->source.lock();
+			Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+
+			active_jobs.remove (job);
+			done = ++jobs_done;
 
-		boost::shared_ptr<AudioFileSource> afs = boost::dynamic_pointer_cast<AudioFileSource> (src);
+			if (src && job->rerun && !job->cancelled()) {
+				enqueue (new Job (src, job->priority));
+				++jobs_queued;
+				SourcesToAnalyse.signal ();
+			}
 
-		if (afs && afs->length(afs->timeline_position())) {
-			Glib::Threads::Mutex::Lock lm (analysis_active_lock);
-			analyse_audio_file_source (afs);
+			queued = jobs_queued;
+
+			if (analysis_queue.empty() && active_jobs.empty()) {
+				jobs_done = 0;
+				jobs_queued = 0;
+			}
+
+			AnalysisFinished.broadcast ();
 		}
+
+		delete job;
+
+		AnalysisProgress (done, queued); /* EMIT SIGNAL */
 	}
 }
 
 void
-Analyser::analyse_audio_file_source (boost::shared_ptr<AudioFileSource> src)
+Analyser::analyse_audio_file_source (boost::shared_ptr<AudioFileSource> src, Progress* progress)
 {
 	AnalysisFeatureList results;
 
 	try {
 		TransientDetector td (src->sample_rate());
-		if (td.run (src->get_transients_path(), src.get(), 0, results) == 0) {
+		if (td.run (src->get_transients_path(), src.get(), 0, results, progress) == 0) {
 			src->set_been_analysed (true);
 		} else {
 			src->set_been_analysed (false);
@@ -122,10 +279,26 @@ Analyser::analyse_audio_file_source (boost::shared_ptr<AudioFileSource> src)
 	}
 }
 
+/** Drop everything that is queued, stop any analyses in progress and wait
+ *  for them to finish.
+ */
 void
 Analyser::flush ()
 {
-	Glib::Threads::Mutex::Lock lq (analysis_queue_lock);
-	Glib::Threads::Mutex::Lock la (analysis_active_lock);
+	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+
+	for (JobList::iterator i = analysis_queue.begin(); i != analysis_queue.end(); ++i) {
+		delete *i;
+	}
 	analysis_queue.clear();
+
+	for (JobList::iterator i = active_jobs.begin(); i != active_jobs.end(); ++i) {
+		(*i)->stop ();
+	}
+
+	jobs_queued = jobs_done + active_jobs.size();
+
+	while (!active_jobs.empty()) {
+		AnalysisFinished.wait (analysis_queue_lock);
+	}
 }
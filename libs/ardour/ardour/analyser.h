@@ -20,36 +20,68 @@
 #ifndef __ardour_analyser_h__
 #define __ardour_analyser_h__
 
+#include <list>
+
 #include <glibmm/threads.h>
 #include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include "pbd/signals.h"
 
 #include "ardour/libardour_visibility.h"
 
 namespace ARDOUR {
 
 class AudioFileSource;
+class Progress;
 class Source;
 class TransientDetector;
 
+/** Runs transient analysis of sources in the background, using a set of
+ *  threads sized to the number of CPUs. Sources with a higher priority are
+ *  analysed first; sources of the same priority in the order they were
+ *  queued. Results are written to each source's transients file.
+ */
 class LIBARDOUR_API Analyser {
 
   public:
 	Analyser();
 	~Analyser ();
 
+	enum Priority {
+		Background, ///< e.g. every audio source added to the session
+		Normal,
+		Visible     ///< sources that the user is looking at
+	};
+
 	static void init ();
-	static void queue_source_for_analysis (boost::shared_ptr<Source>, bool force);
+	static void queue_source_for_analysis (boost::shared_ptr<Source>, bool force, Priority p = Normal);
+	static void set_priority (boost::shared_ptr<Source>, Priority);
+	static void cancel (boost::shared_ptr<Source>);
 	static void work ();
 	static void flush ();
 
+	/** Emitted from an analysis thread each time a source has been dealt
+	 *  with. The parameters are the number of sources analysed and the
+	 *  number queued since the queue was last empty.
+	 */
+	static PBD::Signal2<void,uint32_t,uint32_t> AnalysisProgress;
+
   private:
+	class Job;
+	typedef std::list<Job*> JobList;
+
 	static Analyser* the_analyser;
-	static Glib::Threads::Mutex analysis_active_lock;
 	static Glib::Threads::Mutex analysis_queue_lock;
 	static Glib::Threads::Cond  SourcesToAnalyse;
-	static std::list<boost::weak_ptr<Source> > analysis_queue;
-
-	static void analyse_audio_file_source (boost::shared_ptr<AudioFileSource>);
+	static Glib::Threads::Cond  AnalysisFinished;
+	static JobList analysis_queue;
+	static JobList active_jobs;
+	static uint32_t jobs_done;
+	static uint32_t jobs_queued;
+
+	static void enqueue (Job*);
+	static void analyse_audio_file_source (boost::shared_ptr<AudioFileSource>, Progress*);
 };
 
 
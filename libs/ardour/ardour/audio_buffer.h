@@ -153,9 +153,11 @@ public:
 		Sample* dst = _data + dst_offset;
 		gain_t  gain_delta = (target - initial)/len;
 
+		/* derive the gain from the frame index rather than accumulating
+		 * it, so that iterations are independent and can be vectorized.
+		 */
 		for (framecnt_t n = 0; n < len; ++n) {
-			*dst++ += (*src++ * initial);
-			initial += gain_delta;
+			dst[n] += src[n] * (initial + n * gain_delta);
 		}
 
 		_silent = (_silent && initial == 0 && target == 0);
@@ -30,6 +30,8 @@
 
 #include <boost/utility.hpp>
 
+#include <glibmm/threads.h>
+
 #include "pbd/fastlog.h"
 #include "pbd/ringbufferNPT.h"
 #include "pbd/stateful.h"
@@ -144,6 +146,13 @@ class LIBARDOUR_API AudioDiskstream : public Diskstream
 	void non_realtime_input_change ();
 	void non_realtime_locate (framepos_t location);
 
+  protected:
+	friend class Butler;
+
+	/* Each butler worker thread refills with its own working buffers */
+	static void allocate_thread_working_buffers ();
+	static void free_thread_working_buffers ();
+
   protected:
 	friend class Auditioner;
 	friend class AudioTrack;
@@ -209,7 +218,7 @@ class LIBARDOUR_API AudioDiskstream : public Diskstream
 
 	/* The two central butler operations */
 	int do_flush (RunContext context, bool force = false);
-	int do_refill () { return _do_refill(_mixdown_buffer, _gain_buffer, 0); }
+	int do_refill ();
 
 
 	int read (Sample* buf, Sample* mixdown_buffer, float* gain_buffer,
@@ -252,6 +261,17 @@ class LIBARDOUR_API AudioDiskstream : public Diskstream
 	static Sample* _mixdown_buffer;
 	static gain_t* _gain_buffer;
 
+	struct WorkingBuffers {
+		WorkingBuffers ();
+		~WorkingBuffers ();
+
+		Sample* mixdown_buffer;
+		gain_t* gain_buffer;
+	};
+
+	/** Working buffers for do_refill in butler worker threads */
+	static Glib::Threads::Private<WorkingBuffers> _thread_working_buffers;
+
 	std::vector<boost::shared_ptr<AudioFileSource> > capturing_sources;
 
 	SerializedRCUManager<ChannelList> channels;
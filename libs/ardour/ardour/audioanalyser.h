@@ -29,6 +29,7 @@
 
 namespace ARDOUR {
 
+class Progress;
 class Readable;
 class Session;
 
@@ -59,7 +60,7 @@ class LIBARDOUR_API AudioAnalyser : public boost::noncopyable {
 	framecnt_t stepsize;
 
 	int initialize_plugin (AnalysisPluginKey name, float sample_rate);
-	int analyse (const std::string& path, Readable*, uint32_t channel);
+	int analyse (const std::string& path, Readable*, uint32_t channel, Progress* progress = 0);
 
 	/* instances of an analysis object will have this method called
 	   whenever there are results to process. if out is non-null,
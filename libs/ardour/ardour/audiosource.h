@@ -101,6 +101,9 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 	int prepare_for_peakfile_writes ();
 	void done_with_peakfile_writes (bool done = true);
 
+	bool peak_levels_stale () const;
+	int  build_peak_levels ();
+
 	/** @return true if the each source sample s must be clamped to -1 < s < 1 */
 	virtual bool clamped_at_unity () const = 0;
 
@@ -147,6 +150,17 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 				     bool force, bool intermediate_peaks_ready_signal,
 				     framecnt_t frames_per_peak);
 
+	/** Besides the peakfile itself (level 0) we keep coarser levels of
+	 *  peak data in files next to it, each summarizing peak_level_factor
+	 *  peaks of the level below, for reading at low zoom levels.
+	 */
+	static const uint32_t   n_peak_levels = 3;
+	static const framecnt_t peak_level_factor = 16;
+
+	static framecnt_t peak_level_fpp (uint32_t level);
+	std::string peak_level_path (uint32_t level) const;
+	void unlink_peak_level_files ();
+
   private:
 	bool _peaks_built;
 	/** This mutex is used to protect both the _peaks_built
@@ -159,6 +173,12 @@ class LIBARDOUR_API AudioSource : virtual public Source,
         Glib::Threads::Mutex _initialize_peaks_lock;
 
 	int        _peakfile_fd;
+	/* file descriptors and valid sizes of the coarse peak levels; [0] is unused */
+	int        _peak_level_fd[n_peak_levels];
+	off_t      _peak_level_byte_max[n_peak_levels];
+	/* scratch space for update_peak_level(), grown as needed */
+	std::vector<PeakData> _peak_level_src;
+	std::vector<PeakData> _peak_level_dst;
 	framecnt_t peak_leftover_cnt;
 	framecnt_t peak_leftover_size;
 	Sample*    peak_leftovers;
@@ -168,7 +188,15 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 	mutable double _last_scale;
 	mutable off_t _last_map_off;
 	mutable size_t  _last_raw_map_length;
+	mutable framecnt_t _last_fpp;
 	mutable boost::scoped_array<PeakData> peak_cache;
+
+	int  open_peak_level_files ();
+	void close_peak_level_files ();
+	int  update_peak_levels (framepos_t first_peak, framecnt_t npeaks);
+	int  update_peak_level (uint32_t level, framepos_t& first_peak, framecnt_t& npeaks);
+	bool peak_level_current (uint32_t level, time_t peakfile_mtime) const;
+	uint32_t peak_level_for_zoom (double samples_per_visual_peak) const;
 };
 
 }
@@ -42,6 +42,11 @@ public:
 
 	static void ensure_buffers (ChanCount howmany = ChanCount::ZERO, size_t custom = 0);
 
+	/** @return the number of ThreadBuffers, and so the number of threads
+	 *  that may be processing at once.
+	 */
+	static uint32_t n_thread_buffers () { return _n_thread_buffers; }
+
 private:
         static Glib::Threads::Mutex rb_mutex;
 
@@ -50,6 +55,7 @@ private:
 
 	static ThreadBufferFIFO* thread_buffers;
 	static ThreadBufferList* thread_buffers_list;
+	static uint32_t          _n_thread_buffers;
 };
 
 }
@@ -22,6 +22,9 @@
 
 #include <pthread.h>
 
+#include <string>
+#include <vector>
+
 #include <glibmm/threads.h>
 
 #include "pbd/crossthread.h"
@@ -35,6 +38,8 @@
 
 namespace ARDOUR {
 
+class Track;
+
 /**
  *  One of the Butler's functions is to clean up (ie delete) unused CrossThreadPools.
  *  When a thread with a CrossThreadPool terminates, its CTP is added to pool_trash.
@@ -65,6 +70,17 @@ class LIBARDOUR_API Butler : public SessionHandleRef
 
 	bool flush_tracks_to_disk_after_locate (boost::shared_ptr<RouteList>, uint32_t& errors);
 
+	/** Time spent by the butler refilling track playback buffers */
+	struct RefillStats {
+		RefillStats () : runs (0), total_us (0), max_us (0) {}
+		uint64_t runs;     ///< number of passes over tracks that needed a refill
+		int64_t  total_us; ///< total time taken by these passes
+		int64_t  max_us;   ///< longest pass
+	};
+
+	RefillStats refill_stats () const;
+	void reset_refill_stats ();
+
 	static void* _thread_work(void *arg);
 	void*         thread_work();
 
@@ -93,6 +109,59 @@ private:
 
 	bool flush_tracks_to_disk_normal (boost::shared_ptr<RouteList>, uint32_t& errors);
 
+	typedef std::vector<boost::shared_ptr<Track> > TrackList;
+
+	void tracks_to_refill (RouteList const &, TrackList&) const;
+	bool refill_track (boost::shared_ptr<Track>);
+	bool flush_track (boost::shared_ptr<Track>, uint32_t& errors);
+
+	/** A set of threads that work through a list of tracks in order, each
+	 *  thread taking the next track that nobody has taken yet.
+	 */
+	class WorkerPool {
+	  public:
+		enum Job {
+			Refill,
+			Flush
+		};
+
+		WorkerPool (Butler&, Job);
+		~WorkerPool ();
+
+		int start (uint32_t n_threads);
+		void stop ();
+
+		void submit (TrackList const &);
+		bool wait (uint32_t& errors);
+
+	  private:
+		Butler&  _butler;
+		Job      _job;
+
+		std::vector<pthread_t> _threads;
+
+		Glib::Threads::Mutex _lock;
+		Glib::Threads::Cond  _work_cond;
+		Glib::Threads::Cond  _done_cond;
+
+		TrackList _tracks;
+		size_t    _next;
+		uint32_t  _busy;
+		bool      _outstanding;
+		uint32_t  _errors;
+		bool      _quit;
+
+		static void* _thread_work (void* arg);
+		void thread_work ();
+	};
+
+	WorkerPool* _refill_workers;
+	WorkerPool* _flush_workers;
+
+	mutable Glib::Threads::Mutex _stats_lock;
+	RefillStats _refill_stats;
+	void add_refill_time (int64_t us);
+
 	/**
 	 * Add request to butler thread request queue
 	 */
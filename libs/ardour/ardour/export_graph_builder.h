@@ -23,10 +23,11 @@
 
 #include "ardour/export_handler.h"
 
-#include "audiographer/utils/identity_vertex.h"
+#include "audiographer/sink.h"
 
 #include <boost/ptr_container/ptr_list.hpp>
 #include <glibmm/threadpool.h>
+#include <glibmm/threads.h>
 
 namespace AudioGrapher {
 	class SampleRateConverter;
@@ -54,8 +55,9 @@ class LIBARDOUR_API ExportGraphBuilder
 	typedef ExportHandler::FileSpec FileSpec;
 
 	typedef boost::shared_ptr<AudioGrapher::Sink<Sample> > FloatSinkPtr;
-	typedef boost::shared_ptr<AudioGrapher::IdentityVertex<Sample> > IdentityVertexPtr;
-	typedef std::map<ExportChannelPtr,  IdentityVertexPtr> ChannelMap;
+	typedef boost::shared_ptr<AudioGrapher::Threader<Sample> > ThreaderPtr;
+	// Channel data read for the current cycle
+	typedef std::map<ExportChannelPtr, Sample const *> ChannelMap;
 
   public:
 
@@ -143,14 +145,26 @@ class LIBARDOUR_API ExportGraphBuilder
 
 		/// Returns true when finished
 		bool process ();
+		bool finished () const { return _finished; }
+
+		/// Sink which runs one process() cycle, for running normalizers in parallel
+		FloatSinkPtr pass_sink () { return pass; }
 
 	                                        private:
 		typedef boost::shared_ptr<AudioGrapher::PeakReader> PeakReaderPtr;
 		typedef boost::shared_ptr<AudioGrapher::Normalizer> NormalizerPtr;
 		typedef boost::shared_ptr<AudioGrapher::TmpFile<Sample> > TmpFilePtr;
-		typedef boost::shared_ptr<AudioGrapher::Threader<Sample> > ThreaderPtr;
 		typedef boost::shared_ptr<AudioGrapher::AllocatingProcessContext<Sample> > BufferPtr;
 
+		class Pass : public AudioGrapher::Sink<Sample> {
+		  public:
+			Pass (Normalizer & normalizer) : normalizer (normalizer) {}
+			void process (AudioGrapher::ProcessContext<Sample> const &) { normalizer.process (); }
+			using AudioGrapher::Sink<Sample>::process;
+		  private:
+			Normalizer & normalizer;
+		};
+
 		void start_post_processing();
 
 		ExportGraphBuilder & parent;
@@ -163,6 +177,8 @@ class LIBARDOUR_API ExportGraphBuilder
 		TmpFilePtr      tmp_file;
 		NormalizerPtr   normalizer;
 		ThreaderPtr     threader;
+		FloatSinkPtr    pass;
+		bool            _finished;
 		boost::ptr_list<SFC> children;
 
 		PBD::ScopedConnection post_processing_connection;
@@ -215,6 +231,7 @@ class LIBARDOUR_API ExportGraphBuilder
 	class ChannelConfig {
 	    public:
 		ChannelConfig (ExportGraphBuilder & parent, FileSpec const & new_config, ChannelMap & channel_map);
+		FloatSinkPtr sink ();
 		void add_child (FileSpec const & new_config);
 		void remove_children (bool remove_out_files);
 		bool operator== (FileSpec const & other_config) const;
@@ -223,8 +240,20 @@ class LIBARDOUR_API ExportGraphBuilder
 		typedef boost::shared_ptr<AudioGrapher::Interleaver<Sample> > InterleaverPtr;
 		typedef boost::shared_ptr<AudioGrapher::Chunker<Sample> > ChunkerPtr;
 
+		/// Feeds the interleaver from the channel data read for the current cycle
+		class Input : public AudioGrapher::Sink<Sample> {
+		  public:
+			Input (ChannelConfig & config) : config (config) {}
+			void process (AudioGrapher::ProcessContext<Sample> const & c);
+			using AudioGrapher::Sink<Sample>::process;
+		  private:
+			ChannelConfig & config;
+		};
+
 		ExportGraphBuilder &      parent;
 		FileSpec                  config;
+		ChannelMap const &        channel_map;
+		FloatSinkPtr              input;
 		boost::ptr_list<SilenceHandler> children;
 		InterleaverPtr            interleaver;
 		ChunkerPtr                chunker;
@@ -244,8 +273,19 @@ class LIBARDOUR_API ExportGraphBuilder
 	framecnt_t process_buffer_frames;
 
 	std::list<Normalizer *> normalizers;
+	Glib::Threads::Mutex    normalizers_lock;
 
 	Glib::ThreadPool thread_pool;
+
+	/* Channel configurations, and normalizers in the second pass, are
+	 * independent of each other and are processed in parallel. This
+	 * uses a pool of its own, as normalizers use thread_pool for
+	 * their outputs while running.
+	 */
+	bool             parallel;
+	Glib::ThreadPool parallel_thread_pool;
+	ThreaderPtr      channel_config_threader;
+	ThreaderPtr      normalizer_threader;
 };
 
 } // namespace ARDOUR
@@ -32,6 +32,7 @@ namespace ARDOUR {
 	LIBARDOUR_API extern const char* const backup_suffix;
 	LIBARDOUR_API extern const char* const temp_suffix;
 	LIBARDOUR_API extern const char* const history_suffix;
+	LIBARDOUR_API extern const char* const statecache_suffix;
 	LIBARDOUR_API extern const char* const export_preset_suffix;
 	LIBARDOUR_API extern const char* const export_format_suffix;
 
@@ -29,8 +29,10 @@
 #include <boost/shared_ptr.hpp>
 
 #include <glib.h>
+#include <glibmm/threads.h>
 
 #include "pbd/semutils.h"
+#include "pbd/work_stealing_deque.h"
 
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
@@ -41,6 +43,7 @@ namespace ARDOUR
 {
 
 class GraphNode;
+class GraphSubNode;
 class Graph;
 
 class Route;
@@ -52,6 +55,8 @@ typedef boost::shared_ptr<GraphNode> node_ptr_t;
 typedef std::list< node_ptr_t > node_list_t;
 typedef std::set< node_ptr_t > node_set_t;
 
+typedef PBD::WorkStealingDeque<GraphNode*> GraphNodeQueue;
+
 class LIBARDOUR_API Graph : public SessionHandleRef
 {
 public:
@@ -66,7 +71,7 @@ public:
 	void dec_ref();
 	void restart_cycle();
 
-	bool run_one();
+	bool run_one (uint32_t thread_id);
 	void helper_thread();
 	void main_thread();
 
@@ -81,6 +86,8 @@ public:
 
 	void process_one_route (Route * route);
 
+	void run_sub_nodes (GraphSubNode** nodes, uint32_t n_nodes);
+
 	void clear_other_chain ();
 
 	bool in_process_thread () const;
@@ -94,12 +101,29 @@ private:
 	void reset_thread_list ();
 	void drop_threads ();
 
+	uint32_t register_thread ();
+	bool find_node (uint32_t thread_id, GraphNode*&);
+	bool take_execution_token ();
+	void wake_one ();
+
 	node_list_t _nodes_rt[2];
 
 	node_list_t _init_trigger_list[2];
 
-	std::vector<GraphNode *> _trigger_queue;
-	pthread_mutex_t          _trigger_mutex;
+	/** One queue of triggered nodes per processing thread. A thread pushes the
+	 *  nodes it triggers onto its own queue, and steals from the others when
+	 *  its own queue runs dry.
+	 */
+	std::vector<GraphNodeQueue*> _trigger_queues;
+	/** The number of processing threads that have picked their queue */
+	volatile gint _registered_threads;
+	/** The calling thread's trigger queue */
+	static Glib::Threads::Private<GraphNodeQueue> _thread_trigger_queue;
+	/** One semaphore per processing thread, on which it sleeps while other
+	 *  threads finish sub-nodes that it handed out.
+	 */
+	std::vector<PBD::Semaphore*> _sub_node_sems;
+	static Glib::Threads::Private<PBD::Semaphore> _thread_sub_node_sem;
 
 	PBD::Semaphore _execution_sem;
 
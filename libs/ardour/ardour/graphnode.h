@@ -27,6 +27,12 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include <glib.h>
+
+namespace PBD {
+	class Semaphore;
+}
+
 namespace ARDOUR
 {
 
@@ -46,7 +52,7 @@ class LIBARDOUR_API GraphNode
 
 	void prep( int chain );
 	void dec_ref();
-	void finish( int chain );
+	virtual void finish( int chain );
 
 	virtual void process();
 
@@ -63,6 +69,28 @@ class LIBARDOUR_API GraphNode
 	gint _init_refcount[2];
 };
 
+/** A piece of work that a node hands out to the graph's threads while it is
+ *  itself being processed, e.g.\ one instance of a replicated plugin.
+ *  Sub-nodes are not part of the graph's topology; see Graph::run_sub_nodes().
+ */
+class LIBARDOUR_API GraphSubNode : public GraphNode
+{
+    public:
+	GraphSubNode();
+
+	void finish( int chain );
+
+	virtual void process() = 0;
+
+    private:
+	friend class Graph;
+
+	/** The count of unfinished sub-nodes in the batch that we belong to */
+	gint* _pending;
+	/** Signalled when the last sub-node of the batch has finished */
+	PBD::Semaphore* _done;
+};
+
 }
 
 #endif
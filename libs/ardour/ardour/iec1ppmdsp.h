@@ -33,6 +33,9 @@ public:
     float read (void);
     void reset ();
 
+    // Process n_meters meters, one buffer each, using ARDOUR::ppm_process.
+    static void process (Iec1ppmdsp * const *meters, float const * const *bufs, unsigned int n_meters, int n);
+
     static void init (float fsamp);
 
 private:
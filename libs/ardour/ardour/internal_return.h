@@ -20,6 +20,9 @@
 #ifndef __ardour_internal_return_h__
 #define __ardour_internal_return_h__
 
+#include <vector>
+
+#include "pbd/rcu.h"
 
 #include "ardour/ardour.h"
 #include "ardour/return.h"
@@ -29,10 +32,19 @@ namespace ARDOUR {
 
 class InternalSend;
 
+/** Collects the output of the InternalSends that target a route.
+ *
+ *  Sends do not hand their buffers to the return; instead each send adds
+ *  its output into a partial sum kept for the process thread it runs in,
+ *  so sends running concurrently never touch the same data and no lock is
+ *  needed. When the return runs it mixes the partial sums from the current
+ *  process pass into its buffers.
+ */
 class LIBARDOUR_API InternalReturn : public Return
 {
   public:
 	InternalReturn (Session&);
+	~InternalReturn ();
 
 	XMLNode& state (bool full);
 	XMLNode& get_state ();
@@ -40,15 +52,33 @@ class LIBARDOUR_API InternalReturn : public Return
 	void run (BufferSet& bufs, framepos_t start_frame, framepos_t end_frame, pframes_t nframes, bool);
 	bool configure_io (ChanCount, ChanCount);
 	bool can_support_io_configuration (const ChanCount& in, ChanCount& out);
+	int  set_block_size (pframes_t);
 
 	void add_send (InternalSend *);
 	void remove_send (InternalSend *);
 
+	/** Add the output of a send to what this return will deliver in the
+	 *  current process pass. Must be called from a process thread.
+	 */
+	void accumulate (BufferSet const &, pframes_t nframes);
+
   private:
+	typedef std::list<InternalSend*> SendList;
+
 	/** sends that we are receiving data from */
-	std::list<InternalSend*> _sends;
-	/** mutex to protect _sends */
-	Glib::Threads::Mutex _sends_mutex;
+	SerializedRCUManager<SendList> _sends;
+
+	/** The sum of the sends that one process thread has run for us */
+	struct Partial {
+		BufferSet bufs;
+		/** the Session::process_pass() that bufs belongs to */
+		gint      pass;
+	};
+
+	/** partial sums, indexed by ProcessThread::thread_index() */
+	std::vector<Partial*> _partials;
+
+	void ensure_partials (ChanCount, pframes_t);
 };
 
 } // namespace ARDOUR
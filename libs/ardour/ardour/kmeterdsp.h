@@ -33,10 +33,15 @@ public:
     float read ();
     void reset ();
 
+    // Process n_meters meters, one buffer each, using ARDOUR::kmeter_process.
+    static void process (Kmeterdsp * const *meters, float const * const *bufs, unsigned int n_meters, int n);
+
     static void init (int fsamp);
 
 private:
 
+    void update (float z1, float z2);
+
     float          _z1;          // filter state
     float          _z2;          // filter state
     float          _rms;         // max rms value since last read()
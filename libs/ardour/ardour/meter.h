@@ -103,6 +103,7 @@ private:
 	std::vector<Iec1ppmdsp *> _iec1meter;
 	std::vector<Iec2ppmdsp *> _iec2meter;
 	std::vector<Vumeterdsp *> _vumeter;
+	std::vector<Sample const *> _meter_bufs; // per-cycle audio data, one per meter
 
 	MeterType _meter_type;
 };
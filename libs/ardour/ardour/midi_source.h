@@ -212,11 +212,27 @@ class LIBARDOUR_API MidiSource : virtual public Source, public boost::enable_sha
 	boost::shared_ptr<MidiModel> _model;
 	bool                         _writing;
 
-	mutable Evoral::Sequence<Evoral::Beats>::const_iterator _model_iter;
-	mutable bool                                            _model_iter_valid;
+	/** Where one reader of the model got to.  A source may be read by several
+	 *  regions at once (in different playlists, or linked regions in the same
+	 *  one); each reader which carries on from where it stopped picks up the
+	 *  cursor it left there, so readers do not make each other seek.
+	 */
+	struct ModelCursor {
+		ModelCursor () : valid (false), source_start (0), read_end (0), last_used (0) {}
+
+		Evoral::Sequence<Evoral::Beats>::const_iterator iter;
+		bool       valid;
+		framepos_t source_start; ///< source start position of the last read
+		framepos_t read_end;     ///< end of the last read
+		uint64_t   last_used;
+	};
+
+	static const size_t max_model_cursors = 8;
+
+	mutable ModelCursor _model_cursors[max_model_cursors];
+	mutable uint64_t    _model_cursor_clock;
 
 	mutable Evoral::Beats _length_beats;
-	mutable framepos_t    _last_read_end;
 
 	/** The total duration of the current capture. */
 	framepos_t _capture_length;
@@ -43,6 +43,12 @@ extern "C" {
 }
 
 LIBARDOUR_API void  x86_sse_find_peaks                 (const float * buf, uint32_t nsamples, float *min, float *max);
+
+/* SSE meter ballistics, four channels at a time */
+
+LIBARDOUR_API void  x86_sse_kmeter_process             (const float * const * bufs, uint32_t n_channels, uint32_t nframes, float omega, float *z1, float *z2);
+LIBARDOUR_API void  x86_sse_ppm_process                (const float * const * bufs, uint32_t n_channels, uint32_t nframes, float w1, float w2, float w3, float *z1, float *z2, float *m);
+LIBARDOUR_API void  x86_sse_vumeter_process            (const float * const * bufs, uint32_t n_channels, uint32_t nframes, float w, float *z1, float *z2, float *m);
 LIBARDOUR_API void  x86_sse_avx_find_peaks             (const float * buf, uint32_t nsamples, float *min, float *max);
 
 /* debug wrappers for SSE functions */
@@ -74,4 +80,8 @@ LIBARDOUR_API void  default_mix_buffers_with_gain     (ARDOUR::Sample * dst, con
 LIBARDOUR_API void  default_mix_buffers_no_gain       (ARDOUR::Sample * dst, const ARDOUR::Sample * src, ARDOUR::pframes_t nframes);
 LIBARDOUR_API void  default_copy_vector				  (ARDOUR::Sample * dst, const ARDOUR::Sample * src, ARDOUR::pframes_t nframes);
 
+LIBARDOUR_API void  default_kmeter_process            (const ARDOUR::Sample * const * bufs, uint32_t n_channels, ARDOUR::pframes_t nframes, float omega, float *z1, float *z2);
+LIBARDOUR_API void  default_ppm_process               (const ARDOUR::Sample * const * bufs, uint32_t n_channels, ARDOUR::pframes_t nframes, float w1, float w2, float w3, float *z1, float *z2, float *m);
+LIBARDOUR_API void  default_vumeter_process           (const ARDOUR::Sample * const * bufs, uint32_t n_channels, ARDOUR::pframes_t nframes, float w, float *z1, float *z2, float *m);
+
 #endif /* __ardour_mix_h__ */
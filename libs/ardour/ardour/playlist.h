@@ -24,6 +24,7 @@
 #include <set>
 #include <map>
 #include <list>
+#include <vector>
 #include <boost/shared_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/utility.hpp>
@@ -323,6 +324,8 @@ public:
 	void _set_sort_id ();
 
 	boost::shared_ptr<RegionList> regions_touched_locked (framepos_t start, framepos_t end);
+	void regions_touched_locked (framepos_t start, framepos_t end, std::vector<boost::shared_ptr<Region> >&, bool read_order);
+	void invalidate_region_index ();
 
 	void notify_region_removed (boost::shared_ptr<Region>);
 	void notify_region_added (boost::shared_ptr<Region>);
@@ -400,6 +403,16 @@ public:
 	void coalesce_and_check_crossfades (std::list<Evoral::Range<framepos_t> >);
 	boost::shared_ptr<RegionList> find_regions_at (framepos_t);
 
+	class RegionIndex;
+
+	/** Overlap index of `regions', built on demand after any change
+	 *  to them and protected by _region_index_lock.
+	 */
+	boost::shared_ptr<RegionIndex const> _region_index;
+	Glib::Threads::Mutex _region_index_lock;
+
+	boost::shared_ptr<RegionIndex const> region_index ();
+
 	framepos_t _end_space;  //this is used when we are pasting a range with extra space at the end
 };
 
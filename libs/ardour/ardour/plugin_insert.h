@@ -31,6 +31,8 @@
 #include "ardour/parameter_descriptor.h"
 #include "ardour/processor.h"
 #include "ardour/automation_control.h"
+#include "ardour/chan_mapping.h"
+#include "ardour/graphnode.h"
 
 class XMLNode;
 
@@ -39,6 +41,7 @@ namespace ARDOUR {
 class Session;
 class Route;
 class Plugin;
+class BufferSet;
 
 /** Plugin inserts: send data through a plugin
  */
@@ -177,6 +180,26 @@ class LIBARDOUR_API PluginInsert : public Processor
 	typedef std::vector<boost::shared_ptr<Plugin> > Plugins;
 	Plugins _plugins;
 
+	/** Runs one of our plugin instances on whichever DSP thread picks it up */
+	class InstanceNode : public GraphSubNode {
+	  public:
+		InstanceNode (boost::shared_ptr<Plugin> p) : plugin (p), bufs (0), nframes (0), offset (0) {}
+		void process ();
+
+		boost::shared_ptr<Plugin> plugin;
+		BufferSet* bufs;
+		ChanMapping in_map;
+		ChanMapping out_map;
+		pframes_t nframes;
+		framecnt_t offset;
+	};
+
+	/** One node per entry in _plugins, for running them in parallel */
+	std::vector<GraphSubNode*> _instance_nodes;
+
+	void reset_instance_nodes ();
+	bool can_run_instances_in_parallel (BufferSet const &) const;
+
 	boost::weak_ptr<Plugin> _impulseAnalysisPlugin;
 
 	framecnt_t _signal_analysis_collected_nframes;
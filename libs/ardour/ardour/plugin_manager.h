@@ -141,7 +141,10 @@ class LIBARDOUR_API PluginManager : public boost::noncopyable {
 	int lxvst_discover_from_path (std::string path, bool cache_only = false);
 	int lxvst_discover (std::string path, bool cache_only = false);
 
-	int ladspa_discover (std::string path);
+	int ladspa_discover (std::string path, ARDOUR::PluginInfoList& found);
+	void add_ladspa_plugin_info (PluginInfoPtr);
+	XMLNode& ladspa_info_state (PluginInfo const &) const;
+	PluginInfoPtr ladspa_info_from_state (XMLNode const &, std::string const & path);
 
 	std::string get_ladspa_category (uint32_t id);
 	std::vector<uint32_t> ladspa_plugin_whitelist;
@@ -39,6 +39,8 @@ namespace ARDOUR {
 
 class PortEngine;
 class AudioBackend;
+class AudioPort;
+class MidiPort;
 
 class LIBARDOUR_API PortManager
 {
@@ -146,6 +148,30 @@ class LIBARDOUR_API PortManager
 	 */
 	boost::shared_ptr<Ports> _cycle_ports;
 
+	/** The ports that ::cycle_start() and ::cycle_end() must visit, as
+	 *  flat lists split by type and direction.  Audio inputs need nothing
+	 *  more than their buffer offset resetting, so they go in `idle'.
+	 *  Audio outputs are always processed in full, even when they are not
+	 *  connected, because other code (e.g. export) may read them.
+	 */
+	struct CyclePorts {
+		CyclePorts (boost::shared_ptr<Ports> p) : ports (p) {}
+
+		boost::shared_ptr<Ports> ports; ///< all ports, keeping those below alive
+		std::vector<AudioPort*>  audio_outputs;
+		std::vector<MidiPort*>   midi_inputs;
+		std::vector<MidiPort*>   midi_outputs;
+		std::vector<Port*>       idle;
+
+		void add (Port*);
+		void remove (Port*);
+	};
+
+	SerializedRCUManager<CyclePorts> cycle_port_lists;
+	boost::shared_ptr<CyclePorts>    _cycle_lists;
+
+	void update_cycle_ports (Port* changed, bool removed);
+
 	void fade_out (gain_t, gain_t, pframes_t);
 	void silence (pframes_t nframes);
 	void silence_outputs (pframes_t nframes);
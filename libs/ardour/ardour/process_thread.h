@@ -54,6 +54,11 @@ public:
 	static gain_t* send_gain_automation_buffer ();
 	static pan_t** pan_automation_buffer ();
 
+	/** @return the index of the calling thread's buffers, which no other
+	 *  process thread shares; see BufferManager::n_thread_buffers()
+	 */
+	static uint32_t thread_index ();
+
 protected:
 	void session_going_away ();
 
@@ -32,12 +32,26 @@ namespace ARDOUR {
 	typedef void  (*mix_buffers_no_gain_t)		(ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
 	typedef void  (*copy_vector_t)			    (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
 
+	/* multichannel meter ballistics: run the filters of n_channels meters,
+	 * one buffer per channel, updating the per-channel state arrays in place.
+	 * The result is the same as running each meter on its own, but the
+	 * runtime selected kernel can process several channels in parallel.
+	 * The meters' static process() methods stage their state through
+	 * fixed-size arrays for these, so that they stay realtime safe.
+	 */
+	typedef void  (*kmeter_process_t)           (const ARDOUR::Sample * const *, uint32_t, pframes_t, float, float *, float *);
+	typedef void  (*ppm_process_t)              (const ARDOUR::Sample * const *, uint32_t, pframes_t, float, float, float, float *, float *, float *);
+	typedef void  (*vumeter_process_t)          (const ARDOUR::Sample * const *, uint32_t, pframes_t, float, float *, float *, float *);
+
 	LIBARDOUR_API extern compute_peak_t		compute_peak;
 	LIBARDOUR_API extern find_peaks_t               find_peaks;
 	LIBARDOUR_API extern apply_gain_to_buffer_t	apply_gain_to_buffer;
 	LIBARDOUR_API extern mix_buffers_with_gain_t	mix_buffers_with_gain;
 	LIBARDOUR_API extern mix_buffers_no_gain_t	mix_buffers_no_gain;
 	LIBARDOUR_API extern copy_vector_t			copy_vector;
+	LIBARDOUR_API extern kmeter_process_t		kmeter_process;
+	LIBARDOUR_API extern ppm_process_t		ppm_process;
+	LIBARDOUR_API extern vumeter_process_t		vumeter_process;
 }
 
 #endif /* __ardour_runtime_functions_h__ */
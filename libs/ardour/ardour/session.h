@@ -241,6 +241,15 @@ class LIBARDOUR_API Session : public PBD::StatefulDestructible, public PBD::Scop
 	Butler* butler() { return _butler; }
 	void butler_transport_work ();
 
+	/** @return the graph used for multi-threaded processing, or 0 if we only use one DSP thread */
+	boost::shared_ptr<Graph> process_graph () const { return _process_graph; }
+
+	/** @return a number that changes each time the routes are run, so that
+	 *  processors can tell whether data left by another route belongs to
+	 *  the current pass.
+	 */
+	guint process_pass () const { return g_atomic_int_get (&_process_pass); }
+
 	void refresh_disk_space ();
 
 	int load_diskstreams_2X (XMLNode const &, int);
@@ -1514,6 +1523,7 @@ class LIBARDOUR_API Session : public PBD::StatefulDestructible, public PBD::Scop
 	/* routes stuff */
 
 	boost::shared_ptr<Graph> _process_graph;
+	mutable gint             _process_pass;
 
 	SerializedRCUManager<RouteList>  routes;
 
@@ -25,7 +25,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include "pbd/pool.h"
-#include "pbd/ringbuffer.h"
+#include "pbd/mpmc_queue.h"
 #include "pbd/event_loop.h"
 
 #include "ardour/libardour_visibility.h"
@@ -149,7 +149,7 @@ private:
 
 class SessionEventManager {
 public:
-	SessionEventManager () : pending_events (2048),
+	SessionEventManager () : pending_events (2048), spare_nodes (2048, (SessionEvent*) 0),
 	                         auto_loop_event(0), punch_out_event(0), punch_in_event(0) {}
 	virtual ~SessionEventManager() {}
 
@@ -158,12 +158,22 @@ public:
 	void clear_events (SessionEvent::Type type, boost::function<void (void)> after);
 
 protected:
-	RingBuffer<SessionEvent*> pending_events;
+	/** events queued by any thread, for the process thread to merge */
+	PBD::MPMCQueue<SessionEvent*> pending_events;
 	typedef std::list<SessionEvent *> Events;
-	Events           events;
+	Events           events; ///< sorted by action frame
 	Events           immediate_events;
 	Events::iterator next_event;
 
+	/** unused list nodes, spliced into and out of events and
+	 *  immediate_events so that the process thread does not allocate.
+	 */
+	Events           spare_nodes;
+
+	Events::iterator insert_event (Events&, Events::iterator, SessionEvent*);
+	Events::iterator erase_event (Events&, Events::iterator);
+	void insert_sorted_event (SessionEvent*);
+
 	/* there can only ever be one of each of these */
 
 	SessionEvent *auto_loop_event;
@@ -27,6 +27,8 @@
 
 namespace ARDOUR {
 
+class InterleavedReadCache;
+
 class LIBARDOUR_API SndFileSource : public AudioFileSource {
   public:
 	/** Constructor to be called for existing external-to-session files */
@@ -89,6 +91,8 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 	SNDFILE* _sndfile;
 	SF_INFO _info;
 	BroadcastInfo *_broadcast_info;
+	/** shared by the sources of the channels of a multichannel file */
+	boost::shared_ptr<InterleavedReadCache> _read_cache;
 
 	void init_sndfile ();
 	int open();
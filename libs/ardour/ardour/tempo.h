@@ -29,6 +29,7 @@
 #include "pbd/undo.h"
 #include "pbd/stateful.h"
 #include "pbd/statefuldestructible.h"
+#include "pbd/rcu.h"
 
 #include "evoral/types.hpp"
 
@@ -245,6 +246,11 @@ class LIBARDOUR_API TempoMap : public PBD::StatefulDestructible
 	void get_grid (BBTPointList::const_iterator&, BBTPointList::const_iterator&,
 	               framepos_t start, framepos_t end);
 
+	/* realtime safe: return the position of the first beat at or
+	   after @p pos, and set @p bbt to its bar and beat.
+	*/
+	framepos_t beat_at_or_after_rt (framepos_t pos, Timecode::BBT_Time& bbt) const;
+
 	/* TEMPO- AND METER-SENSITIVE FUNCTIONS
 
 	   bbt_time(), bbt_time_rt(), frame_time() and bbt_duration_at()
@@ -257,9 +263,8 @@ class LIBARDOUR_API TempoMap : public PBD::StatefulDestructible
 
 	void bbt_time (framepos_t when, Timecode::BBT_Time&);
 
-	/* realtime safe variant of ::bbt_time(), will throw
-	   std::logic_error if the map is not large enough
-	   to provide an answer.
+	/* realtime safe variant of ::bbt_time(), which reads the
+	   current snapshot of the map without taking any lock.
 	*/
 	void       bbt_time_rt (framepos_t when, Timecode::BBT_Time&);
 	framepos_t frame_time (const Timecode::BBT_Time&);
@@ -339,26 +344,70 @@ class LIBARDOUR_API TempoMap : public PBD::StatefulDestructible
 	static Tempo    _default_tempo;
 	static Meter    _default_meter;
 
+	/** A stretch of the grid, from one metric change to the next, over
+	 *  which beats are evenly spaced. Beat @a k of a section (counting
+	 *  from zero) lies at frame_exact + k * beat_frames.
+	 */
+	struct Section {
+		double              frame_exact; ///< position of the first beat
+		framepos_t          frame;       ///< frame_exact, rounded as for a BBTPoint
+		double              beat_frames; ///< distance between grid beats
+		double              tick_frames; ///< frames per beat of the tempo, used for ticks
+		int64_t             index;       ///< number of beats between 1|1 and the first beat
+		uint32_t            bar;
+		uint32_t            beat;
+		uint32_t            beats_per_bar;
+		const MeterSection* meter;
+		const TempoSection* tempo;
+
+		framepos_t frame_at (int64_t k) const { return llrint (frame_exact + k * beat_frames); }
+		Timecode::BBT_Time bbt_at (int64_t k) const {
+			const int64_t n = (beat - 1) + k;
+			return Timecode::BBT_Time (bar + n / beats_per_bar, (n % beats_per_bar) + 1, 0);
+		}
+
+		/* comparators for searching a list of sections */
+		static bool frame_less (framepos_t f, const Section& s) { return f < s.frame; }
+		static bool index_less (int64_t i, const Section& s) { return i < s.index; }
+		static bool bbt_less (const Timecode::BBT_Time& b, const Section& s) {
+			return b.bars < s.bar || (b.bars == s.bar && b.beats < s.beat);
+		}
+	};
+
+	typedef std::vector<Section> Sections;
+
 	Metrics                       metrics;
 	framecnt_t                    _frame_rate;
 	mutable Glib::Threads::RWLock lock;
+
+	/** The grid as an immutable table of sections, rebuilt after each
+	 *  change to the metrics. Readers take a snapshot without locking.
+	 */
+	SerializedRCUManager<Sections> _sections;
+
+	/** Beats of the grid, only materialized (from 1|1) as far as get_grid()
+	 *  and the rounding functions have needed so far.
+	 */
 	BBTPointList                  _map;
 
-	void recompute_map (bool reassign_tempo_bbt, framepos_t end = -1);
+	void recompute_map (bool reassign_tempo_bbt);
+	void compute_sections (Sections&, TempoSection* tempo, MeterSection* meter, Metrics::iterator next_metric);
 	void extend_map (framepos_t end);
 	void require_map_to (framepos_t pos);
-	void require_map_to (const Timecode::BBT_Time&);
-	void _extend_map (TempoSection* tempo, MeterSection* meter,
-	                  Metrics::iterator next_metric,
-	                  Timecode::BBT_Time current, framepos_t current_frame, framepos_t end);
+
+	static Sections::const_iterator section_at (const Sections&, framepos_t);
+	static Sections::const_iterator section_at (const Sections&, const Timecode::BBT_Time&);
+	static Sections::const_iterator section_at_index (const Sections&, int64_t);
+	static int64_t beat_before_or_at (const Sections&, framepos_t, Sections::const_iterator&);
+	static int64_t beat_before_or_at (const Sections&, const Timecode::BBT_Time&, Sections::const_iterator&);
 
 	BBTPointList::const_iterator bbt_before_or_at (framepos_t);
-	BBTPointList::const_iterator bbt_before_or_at (const Timecode::BBT_Time&);
 	BBTPointList::const_iterator bbt_after_or_at (framepos_t);
 
 	framepos_t round_to_type (framepos_t fr, RoundMode dir, BBTPointType);
 	void bbt_time (framepos_t, Timecode::BBT_Time&, const BBTPointList::const_iterator&);
-	framecnt_t bbt_duration_at_unlocked (const Timecode::BBT_Time& when, const Timecode::BBT_Time& bbt, int dir);
+	void bbt_time (const Sections&, framepos_t, Timecode::BBT_Time&) const;
+	framecnt_t bbt_duration_at_unlocked (const Sections&, const Timecode::BBT_Time& when, const Timecode::BBT_Time& bbt, int dir) const;
 
 	const MeterSection& first_meter() const;
 	MeterSection&       first_meter();
@@ -32,7 +32,7 @@ class BufferSet;
 
 class LIBARDOUR_API ThreadBuffers {
 public:
-	ThreadBuffers ();
+	ThreadBuffers (uint32_t index);
 	~ThreadBuffers ();
 
 	void ensure_buffers (ChanCount howmany = ChanCount::ZERO, size_t custom = 0);
@@ -46,6 +46,8 @@ public:
 	gain_t*    send_gain_automation_buffer;
 	pan_t**    pan_automation_buffer;
 	uint32_t   npan_buffers;
+	/** unique within the set created by the BufferManager, from 0 */
+	uint32_t   index;
 
 private:
 	void allocate_pan_automation_buffers (framecnt_t nframes, uint32_t howmany, bool force);
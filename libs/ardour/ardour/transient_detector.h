@@ -25,6 +25,7 @@
 namespace ARDOUR {
 
 class AudioSource;
+class Progress;
 class Readable;
 class Session;
 
@@ -42,7 +43,7 @@ public:
 	float get_threshold () const;
 	float get_sensitivity () const;
 
-	int run (const std::string& path, Readable*, uint32_t channel, AnalysisFeatureList& results);
+	int run (const std::string& path, Readable*, uint32_t channel, AnalysisFeatureList& results, Progress* progress = 0);
 	void update_positions (Readable* src, uint32_t channel, AnalysisFeatureList& results);
 
 	static void cleanup_transients (AnalysisFeatureList&, float sr, float gap_msecs);
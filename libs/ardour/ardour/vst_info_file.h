@@ -23,6 +23,8 @@
 
 #include "ardour/libardour_visibility.h"
 #include "ardour/vst_types.h"
+#include <set>
+#include <string>
 #include <vector>
 
 /* Cache File extensions */
@@ -52,6 +54,16 @@ enum VSTScanMode {
 
 LIBARDOUR_API extern void vstfx_free_info_list (std::vector<VSTInfo *> *infos);
 
+#ifndef VST_SCANNER_APP
+/** Run the external scanner app on each of @a dllpaths that has neither a
+ *  cache file nor a blacklist entry, running up to @a n_jobs scans at once.
+ *  Afterwards vstfx_get_info_*() will find the results in the cache.
+ *  @param scanned Filled in with the DLLs that the scanner was run on,
+ *  which must not be scanned again.
+ */
+LIBARDOUR_API extern void vstfx_scan_with_app (std::vector<std::string> const & dllpaths, uint32_t n_jobs, std::set<std::string>& scanned);
+#endif
+
 #ifdef LXVST_SUPPORT
 LIBARDOUR_API extern std::vector<VSTInfo*> * vstfx_get_info_lx (char *, enum VSTScanMode mode = VST_SCAN_USE_APP);
 #endif
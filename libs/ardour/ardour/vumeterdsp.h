@@ -33,6 +33,9 @@ public:
     float read (void);
     void reset ();
 
+    // Process n_meters meters, one buffer each, using ARDOUR::vumeter_process.
+    static void process (Vumeterdsp * const *meters, float const * const *bufs, unsigned int n_meters, int n);
+
     static void init (float fsamp);
 
 private:
@@ -50,7 +50,12 @@ public:
 };
 
 /**
-   A worker thread for non-realtime tasks scheduled in the audio thread.
+   A queue of non-realtime tasks scheduled in the audio thread.
+
+   The work is done by a pool of threads shared by all Workers, whose size
+   is given by the plugin-worker-threads configuration variable. A Worker is
+   only ever serviced by one of these threads at a time, so its requests are
+   handled, and its responses delivered, in the order they were scheduled.
 */
 class LIBARDOUR_API Worker
 {
@@ -76,7 +81,16 @@ public:
 	void emit_responses();
 
 private:
-	void run();
+	class Pool;
+	friend class Pool;
+
+	/**
+	   Handle all complete requests in the ring (pool thread).
+	   @param buf buffer for request bodies, grown as required.
+	   @param buf_size size of @a buf.
+	*/
+	void run_requests(void*& buf, size_t& buf_size);
+
 	/**
 	   Peek in RB, get size and check if a block of 'size' is available.
 
@@ -92,10 +106,11 @@ private:
 	RingBuffer<uint8_t>*   _requests;
 	RingBuffer<uint8_t>*   _responses;
 	uint8_t*               _response;
-	PBD::Semaphore  _sem;
-	bool                   _exit;
-	Glib::Threads::Thread* _thread;
+	gint                   _pending; ///< 1 if requests were written since we were last serviced
+	gint                   _active;  ///< 1 while a pool thread is servicing us
 
+	static Glib::Threads::Mutex _pool_lock;
+	static Pool*                _pool;
 };
 
 } // namespace ARDOUR
@@ -65,6 +65,7 @@ using namespace PBD;
 
 Sample* AudioDiskstream::_mixdown_buffer       = 0;
 gain_t* AudioDiskstream::_gain_buffer          = 0;
+Glib::Threads::Private<AudioDiskstream::WorkingBuffers> AudioDiskstream::_thread_working_buffers;
 
 AudioDiskstream::AudioDiskstream (Session &sess, const string &name, Diskstream::Flag flag)
 	: Diskstream(sess, name, flag)
@@ -151,6 +152,31 @@ AudioDiskstream::free_working_buffers()
 	_gain_buffer          = 0;
 }
 
+AudioDiskstream::WorkingBuffers::WorkingBuffers ()
+{
+	/* same size as the shared buffers, see allocate_working_buffers() */
+	mixdown_buffer = new Sample[2*1048576];
+	gain_buffer    = new gain_t[2*1048576];
+}
+
+AudioDiskstream::WorkingBuffers::~WorkingBuffers ()
+{
+	delete [] mixdown_buffer;
+	delete [] gain_buffer;
+}
+
+void
+AudioDiskstream::allocate_thread_working_buffers ()
+{
+	_thread_working_buffers.replace (new WorkingBuffers);
+}
+
+void
+AudioDiskstream::free_thread_working_buffers ()
+{
+	_thread_working_buffers.replace (0);
+}
+
 void
 AudioDiskstream::non_realtime_input_change ()
 {
@@ -1097,6 +1123,18 @@ AudioDiskstream::_do_refill_with_alloc (bool partial_fill)
 	return ret;
 }
 
+int
+AudioDiskstream::do_refill ()
+{
+	WorkingBuffers* wb = _thread_working_buffers.get ();
+
+	if (wb) {
+		return _do_refill (wb->mixdown_buffer, wb->gain_buffer, 0);
+	}
+
+	return _do_refill (_mixdown_buffer, _gain_buffer, 0);
+}
+
 /** Get some more data from disk and put it in our channels' playback_bufs,
  *  if there is suitable space in them.
  *
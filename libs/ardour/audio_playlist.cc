@@ -21,6 +21,8 @@
 
 #include <cstdlib>
 
+#include <glibmm/threads.h>
+
 #include "ardour/types.h"
 #include "ardour/debug.h"
 #include "ardour/audioplaylist.h"
@@ -138,16 +140,10 @@ AudioPlaylist::AudioPlaylist (boost::shared_ptr<const AudioPlaylist> other, fram
 	/* this constructor does NOT notify others (session) */
 }
 
-/** Sort by descending layer and then by ascending position */
-struct ReadSorter {
-    bool operator() (boost::shared_ptr<Region> a, boost::shared_ptr<Region> b) {
-	    if (a->layer() != b->layer()) {
-		    return a->layer() > b->layer();
-	    }
+typedef std::vector<boost::shared_ptr<Region> > ReadRegions;
 
-	    return a->position() < b->position();
-    }
-};
+/** Per-thread list of the regions involved in a read, re-used to avoid allocation */
+static Glib::Threads::Private<ReadRegions> thread_read_regions;
 
 /** A segment of region that needs to be read */
 struct Segment {
@@ -188,11 +184,18 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, fr
 
 	Playlist::RegionReadLock rl (this);
 
+	ReadRegions* all = thread_read_regions.get ();
+
+	if (!all) {
+		all = new ReadRegions;
+		thread_read_regions.set (all);
+	}
+
 	/* Find all the regions that are involved in the bit we are reading,
-	   and sort them by descending layer and ascending position.
+	   in descending layer and ascending position order.
 	*/
-	boost::shared_ptr<RegionList> all = regions_touched_locked (start, start + cnt - 1);
-	all->sort (ReadSorter ());
+	all->clear ();
+	regions_touched_locked (start, start + cnt - 1, *all, true);
 
 	/* This will be a list of the bits of our read range that we have
 	   handled completely (ie for which no more regions need to be read).
@@ -204,7 +207,7 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, fr
 	list<Segment> to_do;
 
 	/* Now go through the `all' list filling in `to_do' and `done' */
-	for (RegionList::iterator i = all->begin(); i != all->end(); ++i) {
+	for (ReadRegions::iterator i = all->begin(); i != all->end(); ++i) {
 		boost::shared_ptr<AudioRegion> ar = boost::dynamic_pointer_cast<AudioRegion> (*i);
 
 		/* muted regions don't figure into it at all */
@@ -253,6 +256,9 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, fr
 		i->region->read_at (buf + i->range.from - start, mixdown_buffer, gain_buffer, i->range.from, i->range.to - i->range.from + 1, chan_n);
 	}
 
+	/* don't keep the regions alive until this thread's next read */
+	all->clear ();
+
 	return cnt;
 }
 
@@ -298,6 +304,7 @@ AudioPlaylist::destroy_region (boost::shared_ptr<Region> region)
 
 			if ((*i) == region) {
 				regions.erase (i);
+				invalidate_region_index ();
 				changed = true;
 			}
 
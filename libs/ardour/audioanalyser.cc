@@ -24,11 +24,13 @@
 #include "pbd/gstdio_compat.h"
 #include <glibmm/miscutils.h>
 #include <glibmm/fileutils.h>
+#include <glibmm/threads.h>
 
 #include "pbd/error.h"
 #include "pbd/failed_constructor.h"
 
 #include "ardour/audioanalyser.h"
+#include "ardour/progress.h"
 #include "ardour/readable.h"
 
 #include <cstring>
@@ -40,6 +42,11 @@ using namespace Vamp;
 using namespace PBD;
 using namespace ARDOUR;
 
+/* the VAMP plugin loader keeps shared state, and analysers may be created
+   and destroyed by several threads at once
+*/
+static Glib::Threads::Mutex loader_lock;
+
 AudioAnalyser::AudioAnalyser (float sr, AnalysisPluginKey key)
 	: sample_rate (sr)
 	, plugin_key (key)
@@ -54,6 +61,7 @@ AudioAnalyser::AudioAnalyser (float sr, AnalysisPluginKey key)
 
 AudioAnalyser::~AudioAnalyser ()
 {
+	Glib::Threads::Mutex::Lock lm (loader_lock);
 	delete plugin;
 }
 
@@ -62,6 +70,7 @@ AudioAnalyser::initialize_plugin (AnalysisPluginKey key, float sr)
 {
 	using namespace Vamp::HostExt;
 
+	Glib::Threads::Mutex::Lock lm (loader_lock);
 	PluginLoader* loader (PluginLoader::getInstance());
 
 	plugin = loader->loadPlugin (key, sr, PluginLoader::ADAPT_ALL_SAFE);
@@ -100,7 +109,7 @@ AudioAnalyser::reset ()
 }
 
 int
-AudioAnalyser::analyse (const string& path, Readable* src, uint32_t channel)
+AudioAnalyser::analyse (const string& path, Readable* src, uint32_t channel, Progress* progress)
 {
 	stringstream outss;
 	Plugin::FeatureSet features;
@@ -118,6 +127,13 @@ AudioAnalyser::analyse (const string& path, Readable* src, uint32_t channel)
 
 		framecnt_t to_read;
 
+		if (progress) {
+			if (progress->cancelled ()) {
+				goto out;
+			}
+			progress->set_progress ((float) pos / len);
+		}
+
 		/* read from source */
 
 		to_read = min ((len - pos), (framecnt_t) bufsize);
@@ -76,6 +76,9 @@ bool AudioSource::_build_peakfiles = false;
 
 #define _FPP 256
 
+const uint32_t   AudioSource::n_peak_levels;
+const framecnt_t AudioSource::peak_level_factor;
+
 AudioSource::AudioSource (Session& s, const string& name)
 	: Source (s, DataType::AUDIO, name)
 	, _length (0)
@@ -89,7 +92,12 @@ AudioSource::AudioSource (Session& s, const string& name)
 	, _last_scale (0.0)
 	, _last_map_off (0)
 	, _last_raw_map_length (0)
+	, _last_fpp (0)
 {
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		_peak_level_fd[l] = -1;
+		_peak_level_byte_max[l] = 0;
+	}
 }
 
 AudioSource::AudioSource (Session& s, const XMLNode& node)
@@ -105,7 +113,13 @@ AudioSource::AudioSource (Session& s, const XMLNode& node)
 	, _last_scale (0.0)
 	, _last_map_off (0)
 	, _last_raw_map_length (0)
+	, _last_fpp (0)
 {
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		_peak_level_fd[l] = -1;
+		_peak_level_byte_max[l] = 0;
+	}
+
 	if (set_state (node, Stateful::loading_state_version)) {
 		throw failed_constructor();
 	}
@@ -124,6 +138,8 @@ AudioSource::~AudioSource ()
 		_peakfile_fd = -1;
 	}
 
+	close_peak_level_files ();
+
 	delete [] peak_leftovers;
 }
 
@@ -230,6 +246,15 @@ AudioSource::rename_peakfile (string newpath)
 		}
 	}
 
+	for (uint32_t l = 1; l < n_peak_levels; ++l) {
+		string const oldlevel = peak_level_path (l);
+		string const newlevel = string_compose ("%1.%2", newpath, peak_level_fpp (l));
+		if (Glib::file_test (oldlevel, Glib::FILE_TEST_EXISTS) && g_rename (oldlevel.c_str(), newlevel.c_str()) != 0) {
+			/* not fatal, the level will be rebuilt */
+			::g_unlink (oldlevel.c_str());
+		}
+	}
+
 	_peakpath = newpath;
 
 	return 0;
@@ -306,7 +331,12 @@ AudioSource::initialize_peakfile (const string& audio_path, const bool in_sessio
 		}
 	}
 
-	if (!empty() && !_peaks_built && _build_missing_peakfiles && _build_peakfiles) {
+	/* missing or stale coarse levels are left to SourceFactory's peak
+	   building thread (see peak_levels_stale()); until then reads use
+	   the peakfile.
+	*/
+
+	if (!empty() && _build_missing_peakfiles && _build_peakfiles && !_peaks_built) {
 		build_peaks_from_scratch ();
 	}
 
@@ -334,7 +364,93 @@ AudioSource::write (Sample *dst, framecnt_t cnt)
 int
 AudioSource::read_peaks (PeakData *peaks, framecnt_t npeaks, framepos_t start, framecnt_t cnt, double samples_per_visual_peak) const
 {
-	return read_peaks_with_fpp (peaks, npeaks, start, cnt, samples_per_visual_peak, _FPP);
+	return read_peaks_with_fpp (peaks, npeaks, start, cnt, samples_per_visual_peak, peak_level_fpp (peak_level_for_zoom (samples_per_visual_peak)));
+}
+
+/** @return the coarsest complete level of peak data that still has at least
+ *  one stored peak per visual peak.
+ */
+uint32_t
+AudioSource::peak_level_for_zoom (double samples_per_visual_peak) const
+{
+	GStatBuf peakfile;
+
+	if (samples_per_visual_peak < peak_level_fpp (1) || g_stat (_peakpath.c_str(), &peakfile) != 0) {
+		return 0;
+	}
+
+	for (uint32_t level = n_peak_levels - 1; level > 0; --level) {
+		if (samples_per_visual_peak >= peak_level_fpp (level) && peak_level_current (level, peakfile.st_mtime)) {
+			return level;
+		}
+	}
+
+	return 0;
+}
+
+/** @return true if @a level is complete and no older than the peakfile
+ *  (last modified at @a peakfile_mtime), so that it was not left behind by
+ *  a peakfile that has since been rebuilt.
+ */
+bool
+AudioSource::peak_level_current (uint32_t level, time_t peakfile_mtime) const
+{
+	GStatBuf statbuf;
+
+	if (g_stat (peak_level_path (level).c_str(), &statbuf) != 0) {
+		return false;
+	}
+
+	return statbuf.st_size > 0 &&
+		statbuf.st_size >= (off_t) ((_length / peak_level_fpp (level)) * sizeof (PeakData)) &&
+		statbuf.st_mtime >= peakfile_mtime;
+}
+
+/** @return true if the peakfile is built but the coarse levels are missing,
+ *  incomplete or older than it, so that build_peak_levels() should be run.
+ */
+bool
+AudioSource::peak_levels_stale () const
+{
+	if (empty() || !_peaks_built || !_build_missing_peakfiles || !_build_peakfiles) {
+		return false;
+	}
+
+	GStatBuf peakfile;
+
+	if (g_stat (_peakpath.c_str(), &peakfile) != 0) {
+		return false;
+	}
+
+	for (uint32_t level = 1; level < n_peak_levels; ++level) {
+		if (!peak_level_current (level, peakfile.st_mtime)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+framecnt_t
+AudioSource::peak_level_fpp (uint32_t level)
+{
+	framecnt_t fpp = _FPP;
+
+	while (level--) {
+		fpp *= peak_level_factor;
+	}
+
+	return fpp;
+}
+
+string
+AudioSource::peak_level_path (uint32_t level) const
+{
+	if (level == 0) {
+		return _peakpath;
+	}
+
+	return string_compose ("%1.%2", _peakpath, peak_level_fpp (level));
 }
 
 /** @param peaks Buffer to write peak data.
@@ -363,9 +479,17 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, framecnt_t npeaks, framepos_t
 
 	GStatBuf statbuf;
 
+	string peakpath = _peakpath;
+
+	for (uint32_t level = 1; level < n_peak_levels; ++level) {
+		if (peak_level_fpp (level) == samples_per_file_peak) {
+			peakpath = peak_level_path (level);
+		}
+	}
+
 	expected_peaks = (cnt / (double) samples_per_file_peak);
-	if (g_stat (_peakpath.c_str(), &statbuf) != 0) {
-		error << string_compose (_("Cannot open peakfile @ %1 for size check (%2)"), _peakpath, strerror (errno)) << endmsg;
+	if (g_stat (peakpath.c_str(), &statbuf) != 0) {
+		error << string_compose (_("Cannot open peakfile @ %1 for size check (%2)"), peakpath, strerror (errno)) << endmsg;
 		return -1;
 	}
 
@@ -386,10 +510,10 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, framecnt_t npeaks, framepos_t
 		const off_t expected_file_size = (_length / (double) samples_per_file_peak) * sizeof (PeakData);
 
 		if (statbuf.st_size < expected_file_size) {
-			warning << string_compose (_("peak file %1 is truncated from %2 to %3"), _peakpath, expected_file_size, statbuf.st_size) << endmsg;
+			warning << string_compose (_("peak file %1 is truncated from %2 to %3"), peakpath, expected_file_size, statbuf.st_size) << endmsg;
 			const_cast<AudioSource*>(this)->build_peaks_from_scratch ();
-			if (g_stat (_peakpath.c_str(), &statbuf) != 0) {
-				error << string_compose (_("Cannot open peakfile @ %1 for size check (%2) after rebuild"), _peakpath, strerror (errno)) << endmsg;
+			if (g_stat (peakpath.c_str(), &statbuf) != 0) {
+				error << string_compose (_("Cannot open peakfile @ %1 for size check (%2) after rebuild"), peakpath, strerror (errno)) << endmsg;
 			}
 			if (statbuf.st_size < expected_file_size) {
 				fatal << "peak file is still truncated after rebuild" << endmsg;
@@ -398,10 +522,10 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, framecnt_t npeaks, framepos_t
 		}
 	}
 
-	ScopedFileDescriptor sfd (g_open (_peakpath.c_str(), O_RDONLY, 0444));
+	ScopedFileDescriptor sfd (g_open (peakpath.c_str(), O_RDONLY, 0444));
 
 	if (sfd < 0) {
-		error << string_compose (_("Cannot open peakfile @ %1 for reading (%2)"), _peakpath, strerror (errno)) << endmsg;
+		error << string_compose (_("Cannot open peakfile @ %1 for reading (%2)"), peakpath, strerror (errno)) << endmsg;
 		return -1;
 	}
 
@@ -459,7 +583,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, framecnt_t npeaks, framepos_t
 		off_t  map_delta = map_off - read_map_off;
 		size_t map_length = bytes_to_read + map_delta;
 
-		if (_first_run  || (_last_scale != samples_per_visual_peak) || (_last_map_off != map_off) || (_last_raw_map_length  < bytes_to_read)) {
+		if (_first_run  || (_last_scale != samples_per_visual_peak) || (_last_fpp != samples_per_file_peak) || (_last_map_off != map_off) || (_last_raw_map_length  < bytes_to_read)) {
 			peak_cache.reset (new PeakData[npeaks]);
 			char* addr;
 #ifdef PLATFORM_WINDOWS
@@ -470,13 +594,13 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, framecnt_t npeaks, framepos_t
 
 			map_handle = CreateFileMapping(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
 			if (map_handle == NULL) {
-				error << string_compose (_("map failed - could not create file mapping for peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not create file mapping for peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 
 			view_handle = MapViewOfFile(map_handle, FILE_MAP_READ, 0, read_map_off, map_length);
 			if (view_handle == NULL) {
-				error << string_compose (_("map failed - could not map peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not map peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 
@@ -487,13 +611,13 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, framecnt_t npeaks, framepos_t
 			err_flag = UnmapViewOfFile (view_handle);
 			err_flag = CloseHandle(map_handle);
 			if(!err_flag) {
-				error << string_compose (_("unmap failed - could not unmap peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("unmap failed - could not unmap peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 #else
 			addr = (char*) mmap (0, map_length, PROT_READ, MAP_PRIVATE, sfd, read_map_off);
 			if (addr ==  MAP_FAILED) {
-				error << string_compose (_("map failed - could not mmap peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not mmap peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 
@@ -506,6 +630,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, framecnt_t npeaks, framepos_t
 
 			_first_run = false;
 			_last_scale = samples_per_visual_peak;
+			_last_fpp = samples_per_file_peak;
 			_last_map_off = map_off;
 			_last_raw_map_length = bytes_to_read;
 		}
@@ -552,7 +677,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, framecnt_t npeaks, framepos_t
 		size_t raw_map_length = chunksize * sizeof(PeakData);
 		size_t map_length = (chunksize * sizeof(PeakData)) + map_delta;
 
-		if (_first_run || (_last_scale != samples_per_visual_peak) || (_last_map_off != map_off) || (_last_raw_map_length < raw_map_length)) {
+		if (_first_run || (_last_scale != samples_per_visual_peak) || (_last_fpp != samples_per_file_peak) || (_last_map_off != map_off) || (_last_raw_map_length < raw_map_length)) {
 			peak_cache.reset (new PeakData[npeaks]);
 			boost::scoped_array<PeakData> staging (new PeakData[chunksize]);
 
@@ -565,13 +690,13 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, framecnt_t npeaks, framepos_t
 
 			map_handle = CreateFileMapping(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
 			if (map_handle == NULL) {
-				error << string_compose (_("map failed - could not create file mapping for peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not create file mapping for peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 
 			view_handle = MapViewOfFile(map_handle, FILE_MAP_READ, 0, read_map_off, map_length);
 			if (view_handle == NULL) {
-				error << string_compose (_("map failed - could not map peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not map peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 
@@ -582,13 +707,13 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, framecnt_t npeaks, framepos_t
 			err_flag = UnmapViewOfFile (view_handle);
 			err_flag = CloseHandle(map_handle);
 			if(!err_flag) {
-				error << string_compose (_("unmap failed - could not unmap peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("unmap failed - could not unmap peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 #else
 			addr = (char*) mmap (0, map_length, PROT_READ, MAP_PRIVATE, sfd, read_map_off);
 			if (addr ==  MAP_FAILED) {
-				error << string_compose (_("map failed - could not mmap peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not mmap peakfile %1."), peakpath) << endmsg;
 				return -1;
 			}
 
@@ -622,6 +747,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, framecnt_t npeaks, framepos_t
 
 			_first_run = false;
 			_last_scale = samples_per_visual_peak;
+			_last_fpp = samples_per_file_peak;
 			_last_map_off = map_off;
 			_last_raw_map_length = raw_map_length;
 		}
@@ -784,6 +910,7 @@ AudioSource::build_peaks_from_scratch ()
 	if (ret) {
 		DEBUG_TRACE (DEBUG::Peaks, string_compose("Could not write peak data, attempting to remove peakfile %1\n", _peakpath));
 		::g_unlink (_peakpath.c_str());
+		unlink_peak_level_files ();
 	}
 
 	return ret;
@@ -797,8 +924,10 @@ AudioSource::close_peakfile ()
 		close (_peakfile_fd);
 		_peakfile_fd = -1;
 	}
+	close_peak_level_files ();
 	if (!_peakpath.empty()) {
 		::g_unlink (_peakpath.c_str());
+		unlink_peak_level_files ();
 	}
 	_peaks_built = false;
 	return 0;
@@ -815,9 +944,68 @@ AudioSource::prepare_for_peakfile_writes ()
 		error << string_compose(_("AudioSource: cannot open _peakpath (c) \"%1\" (%2)"), _peakpath, strerror (errno)) << endmsg;
 		return -1;
 	}
+
+	if (open_peak_level_files ()) {
+		close (_peakfile_fd);
+		_peakfile_fd = -1;
+		return -1;
+	}
+
+	/* enough for the level updates after writes of up to 1024 peaks
+	   (a quarter of a million frames), so that those do not allocate
+	*/
+	framecnt_t const prealloc = 1024 + 2 * peak_level_factor;
+
+	if ((framecnt_t) _peak_level_src.size() < prealloc) {
+		_peak_level_src.resize (prealloc);
+		_peak_level_dst.resize (prealloc / peak_level_factor);
+	}
+
 	return 0;
 }
 
+int
+AudioSource::open_peak_level_files ()
+{
+	for (uint32_t l = 1; l < n_peak_levels; ++l) {
+
+		if (_peak_level_fd[l] >= 0) {
+			continue;
+		}
+
+		string const path = peak_level_path (l);
+
+		if ((_peak_level_fd[l] = g_open (path.c_str(), O_CREAT|O_RDWR, 0664)) < 0) {
+			error << string_compose(_("AudioSource: cannot open peak level file \"%1\" (%2)"), path, strerror (errno)) << endmsg;
+			close_peak_level_files ();
+			return -1;
+		}
+
+		_peak_level_byte_max[l] = lseek (_peak_level_fd[l], 0, SEEK_END);
+	}
+
+	return 0;
+}
+
+void
+AudioSource::close_peak_level_files ()
+{
+	for (uint32_t l = 1; l < n_peak_levels; ++l) {
+		if (_peak_level_fd[l] >= 0) {
+			close (_peak_level_fd[l]);
+			_peak_level_fd[l] = -1;
+		}
+	}
+}
+
+void
+AudioSource::unlink_peak_level_files ()
+{
+	for (uint32_t l = 1; l < n_peak_levels; ++l) {
+		::g_unlink (peak_level_path (l).c_str());
+	}
+}
+
 void
 AudioSource::done_with_peakfile_writes (bool done)
 {
@@ -826,6 +1014,7 @@ AudioSource::done_with_peakfile_writes (bool done)
 			close (_peakfile_fd);
 			_peakfile_fd = -1;
 		}
+		close_peak_level_files ();
 		return;
 	}
 
@@ -841,6 +1030,7 @@ AudioSource::done_with_peakfile_writes (bool done)
 
 	close (_peakfile_fd);
 	_peakfile_fd = -1;
+	close_peak_level_files ();
 }
 
 /** @param first_frame Offset from the source start of the first frame to
@@ -902,6 +1092,10 @@ AudioSource::compute_and_write_peaks (Sample* buf, framecnt_t first_frame, frame
 
 			_peak_byte_max = max (_peak_byte_max, (off_t) (byte + sizeof(PeakData)));
 
+			if (fpp == _FPP && update_peak_levels (peak_leftover_frame / fpp, 1)) {
+				return -1;
+			}
+
 			{
 				Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
 				PeakRangeReady (peak_leftover_frame, peak_leftover_cnt); /* EMIT SIGNAL */
@@ -1028,6 +1222,10 @@ AudioSource::compute_and_write_peaks (Sample* buf, framecnt_t first_frame, frame
 
 	_peak_byte_max = max (_peak_byte_max, (off_t) (first_peak_byte + bytes_to_write));
 
+	if (fpp == _FPP && update_peak_levels (first_frame / fpp, peaks_computed)) {
+		return -1;
+	}
+
 	if (frames_done) {
 		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
 		PeakRangeReady (first_frame, frames_done); /* EMIT SIGNAL */
@@ -1039,6 +1237,135 @@ AudioSource::compute_and_write_peaks (Sample* buf, framecnt_t first_frame, frame
 	return 0;
 }
 
+/** Recompute the coarse peak levels after peaks
+ *  [first_peak, first_peak + npeaks) of the peakfile have been written.
+ *  The peakfile and the level files must be open.
+ */
+int
+AudioSource::update_peak_levels (framepos_t first_peak, framecnt_t npeaks)
+{
+	for (uint32_t level = 1; level < n_peak_levels && npeaks > 0; ++level) {
+		if (update_peak_level (level, first_peak, npeaks)) {
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/** Recompute the peaks of @a level that summarize the given range of peaks of
+ *  the level below, and return the range of recomputed peaks in
+ *  @a first_peak and @a npeaks.
+ */
+int
+AudioSource::update_peak_level (uint32_t level, framepos_t& first_peak, framecnt_t& npeaks)
+{
+	int const src_fd = (level == 1) ? _peakfile_fd : _peak_level_fd[level - 1];
+	int const dst_fd = _peak_level_fd[level];
+	framecnt_t const src_peaks = ((level == 1) ? _peak_byte_max : _peak_level_byte_max[level - 1]) / sizeof (PeakData);
+
+	if (src_fd < 0 || dst_fd < 0) {
+		return -1;
+	}
+
+	framepos_t const src_end = min ((framepos_t) (first_peak + npeaks), (framepos_t) src_peaks);
+
+	if (src_end <= first_peak) {
+		npeaks = 0;
+		return 0;
+	}
+
+	/* the first and one-past-the-last peak of this level that we touch */
+	framepos_t const first = first_peak / peak_level_factor;
+	framepos_t const end = (src_end + peak_level_factor - 1) / peak_level_factor;
+
+	framepos_t const src_first = first * peak_level_factor;
+	framecnt_t const src_cnt = min ((framecnt_t) ((end - first) * peak_level_factor), (framecnt_t) (src_peaks - src_first));
+
+	if ((framecnt_t) _peak_level_src.size() < src_cnt) {
+		_peak_level_src.resize (src_cnt);
+	}
+	if ((framecnt_t) _peak_level_dst.size() < end - first) {
+		_peak_level_dst.resize (end - first);
+	}
+
+	PeakData* src = &_peak_level_src[0];
+	PeakData* dst = &_peak_level_dst[0];
+
+	ssize_t const bytes_to_read = src_cnt * sizeof (PeakData);
+
+	if (lseek (src_fd, src_first * sizeof (PeakData), SEEK_SET) != (off_t) (src_first * sizeof (PeakData)) ||
+	    ::read (src_fd, src, bytes_to_read) != bytes_to_read) {
+		error << string_compose(_("%1: could not read peak file data (%2)"), _name, strerror (errno)) << endmsg;
+		return -1;
+	}
+
+	for (framecnt_t n = 0; n < end - first; ++n) {
+		framecnt_t const b = n * peak_level_factor;
+		framecnt_t const e = min ((framecnt_t) (b + peak_level_factor), src_cnt);
+
+		dst[n] = src[b];
+
+		for (framecnt_t i = b + 1; i < e; ++i) {
+			dst[n].max = max (dst[n].max, src[i].max);
+			dst[n].min = min (dst[n].min, src[i].min);
+		}
+	}
+
+	off_t const first_byte = first * sizeof (PeakData);
+	ssize_t const bytes_to_write = (end - first) * sizeof (PeakData);
+
+	if (lseek (dst_fd, first_byte, SEEK_SET) != first_byte ||
+	    ::write (dst_fd, dst, bytes_to_write) != bytes_to_write) {
+		error << string_compose(_("%1: could not write peak file data (%2)"), _name, strerror (errno)) << endmsg;
+		return -1;
+	}
+
+	_peak_level_byte_max[level] = max (_peak_level_byte_max[level], (off_t) (first_byte + bytes_to_write));
+
+	first_peak = first;
+	npeaks = end - first;
+
+	return 0;
+}
+
+/** Create the coarse peak levels from an existing peakfile */
+int
+AudioSource::build_peak_levels ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	DEBUG_TRACE (DEBUG::Peaks, string_compose ("Building peak levels for %1\n", _peakpath));
+
+	if (prepare_for_peakfile_writes ()) {
+		return -1;
+	}
+
+	/* a multiple of the coarsest level's size, so that each level
+	 * is computed once per chunk.
+	 */
+	framecnt_t const chunk = peak_level_fpp (n_peak_levels - 1) / _FPP * 256;
+	framecnt_t const npeaks = _peak_byte_max / sizeof (PeakData);
+	int ret = 0;
+
+	for (framepos_t p = 0; p < npeaks; p += chunk) {
+		if (update_peak_levels (p, min (chunk, npeaks - p))) {
+			ret = -1;
+			break;
+		}
+	}
+
+	close (_peakfile_fd);
+	_peakfile_fd = -1;
+	close_peak_level_files ();
+
+	if (ret) {
+		unlink_peak_level_files ();
+	}
+
+	return ret;
+}
+
 void
 AudioSource::truncate_peakfile ()
 {
@@ -1059,6 +1386,15 @@ AudioSource::truncate_peakfile ()
 						 _peakpath, _peak_byte_max, errno) << endmsg;
 		}
 	}
+
+	for (uint32_t l = 1; l < n_peak_levels; ++l) {
+		if (_peak_level_fd[l] >= 0 && lseek (_peak_level_fd[l], 0, SEEK_END) > _peak_level_byte_max[l]) {
+			if (ftruncate (_peak_level_fd[l], _peak_level_byte_max[l])) {
+				error << string_compose (_("could not truncate peakfile %1 to %2 (error: %3)"),
+				                         peak_level_path (l), _peak_level_byte_max[l], errno) << endmsg;
+			}
+		}
+	}
 }
 
 framecnt_t
@@ -520,6 +520,26 @@ Automatable::find_next_event (double now, double end, Evoral::ControlEvent& next
 			continue;
 		}
 
+		{
+			/* binary search for the first event after now */
+			Glib::Threads::RWLock::ReaderLock lm (alist->lock(), Glib::Threads::TRY_LOCK);
+
+			if (lm.locked()) {
+				Evoral::ControlList::ScopedArrays arrays (*alist);
+
+				if (arrays.valid()) {
+					size_t n = arrays->lower_bound (now);
+					while (n < arrays->when.size() && arrays->when[n] <= now) {
+						++n;
+					}
+					if (n < arrays->when.size() && arrays->when[n] < end && arrays->when[n] < next_event.when) {
+						next_event.when = arrays->when[n];
+					}
+					continue;
+				}
+			}
+		}
+
 		for (i = lower_bound (alist->begin(), alist->end(), &cp, Evoral::ControlList::time_comparator);
 		     i != alist->end() && (*i)->when < end; ++i) {
 			if ((*i)->when > now) {
@@ -29,6 +29,7 @@ using namespace PBD;
 
 RingBufferNPT<ThreadBuffers*>* BufferManager::thread_buffers = 0;
 std::list<ThreadBuffers*>* BufferManager::thread_buffers_list = 0;
+uint32_t BufferManager::_n_thread_buffers = 0;
 Glib::Threads::Mutex BufferManager::rb_mutex;
 
 using std::cerr;
@@ -39,12 +40,13 @@ BufferManager::init (uint32_t size)
 {
         thread_buffers = new ThreadBufferFIFO (size+1); // must be one larger than requested
 	thread_buffers_list = new ThreadBufferList;
+	_n_thread_buffers = size;
 
         /* and populate with actual ThreadBuffers
          */
 
         for (uint32_t n = 0; n < size; ++n) {
-                ThreadBuffers* ts = new ThreadBuffers;
+                ThreadBuffers* ts = new ThreadBuffers (n);
                 thread_buffers->write (&ts, 1);
 		thread_buffers_list->push_back (ts);
         }
@@ -25,8 +25,11 @@
 #include <poll.h>
 #endif
 
+#include <algorithm>
+
 #include "pbd/error.h"
 #include "pbd/pthread_utils.h"
+#include "ardour/audio_diskstream.h"
 #include "ardour/debug.h"
 #include "ardour/butler.h"
 #include "ardour/io.h"
@@ -41,6 +44,12 @@ using namespace PBD;
 
 namespace ARDOUR {
 
+struct PlaybackLoadSorter {
+	bool operator() (std::pair<float, boost::shared_ptr<Track> > const & a, std::pair<float, boost::shared_ptr<Track> > const & b) const {
+		return a.first < b.first;
+	}
+};
+
 Butler::Butler(Session& s)
 	: SessionHandleRef (s)
 	, thread()
@@ -50,6 +59,8 @@ Butler::Butler(Session& s)
 	, midi_dstream_buffer_size(0)
 	, pool_trash(16)
 	, _xthread (true)
+	, _refill_workers (0)
+	, _flush_workers (0)
 {
 	g_atomic_int_set(&should_do_transport_work, 0);
 	SessionEvent::pool->set_trash (&pool_trash);
@@ -122,6 +133,26 @@ Butler::start_thread()
 
 	should_run = false;
 
+	/* with more than one butler thread, tracks are refilled and flushed
+	 * by pools of workers; the butler thread itself only hands out work.
+	 */
+	uint32_t const n_workers = Config->get_butler_threads ();
+
+	if (n_workers > 1) {
+		_refill_workers = new WorkerPool (*this, WorkerPool::Refill);
+		_flush_workers = new WorkerPool (*this, WorkerPool::Flush);
+
+		if (_refill_workers->start (n_workers) || _flush_workers->start (n_workers)) {
+			error << _("Session: could not create butler worker threads") << endmsg;
+			/* stops and joins whatever threads did get started */
+			delete _refill_workers;
+			delete _flush_workers;
+			_refill_workers = 0;
+			_flush_workers = 0;
+			return -1;
+		}
+	}
+
 	if (pthread_create_and_store ("disk butler", &thread, _thread_work, this)) {
 		error << _("Session: could not create butler thread") << endmsg;
 		return -1;
@@ -145,7 +176,13 @@ Butler::terminate_thread ()
                 DEBUG_TRACE (DEBUG::Butler, string_compose ("%1: ask butler to quit @ %2\n", DEBUG_THREAD_SELF, g_get_monotonic_time()));
 		queue_request (Request::Quit);
 		pthread_join (thread, &status);
+		have_thread = false;
 	}
+
+	delete _refill_workers;
+	_refill_workers = 0;
+	delete _flush_workers;
+	_flush_workers = 0;
 }
 
 void *
@@ -162,7 +199,6 @@ Butler::thread_work ()
 	uint32_t err = 0;
 
 	bool disk_work_outstanding = false;
-	RouteList::iterator i;
 
 	while (true) {
 		DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 butler main loop, disk work outstanding ? %2 @ %3\n", DEBUG_THREAD_SELF, disk_work_outstanding, g_get_monotonic_time()));
@@ -224,51 +260,70 @@ Butler::thread_work ()
 		RouteList rl_with_auditioner = *rl;
 		rl_with_auditioner.push_back (_session.the_auditioner());
 
-		for (i = rl_with_auditioner.begin(); !transport_work_requested() && should_run && i != rl_with_auditioner.end(); ++i) {
+		TrackList to_refill;
+		tracks_to_refill (rl_with_auditioner, to_refill);
+
+		int64_t const refill_start = g_get_monotonic_time ();
+
+		if (_refill_workers) {
+
+			/* capture data is written by its own set of threads,
+			   while the others read.
+			*/
 
-			boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+			TrackList to_flush;
 
-			if (!tr) {
-				continue;
+			for (RouteList::iterator r = rl->begin(); r != rl->end(); ++r) {
+				boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*r);
+				if (tr) {
+					to_flush.push_back (tr);
+				}
 			}
 
-			boost::shared_ptr<IO> io = tr->input ();
+			_flush_workers->submit (to_flush);
+			_refill_workers->submit (to_refill);
+
+			disk_work_outstanding = _refill_workers->wait (err);
 
-			if (io && !io->active()) {
-				/* don't read inactive tracks */
-				DEBUG_TRACE (DEBUG::Butler, string_compose ("butler skips inactive track %1\n", tr->name()));
-				continue;
+			if (!to_refill.empty ()) {
+				add_refill_time (g_get_monotonic_time () - refill_start);
 			}
-			DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), tr->playback_buffer_load()));
-			switch (tr->do_refill ()) {
-			case 0:
-				DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
-				break;
-
-			case 1:
-				DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name()));
+
+			if (_flush_workers->wait (err)) {
 				disk_work_outstanding = true;
-				break;
+			}
 
-			default:
-				error << string_compose(_("Butler read ahead failure on dstream %1"), (*i)->name()) << endmsg;
-                                std::cerr << string_compose(_("Butler read ahead failure on dstream %1"), (*i)->name()) << std::endl;
-				break;
+			if (!err && transport_work_requested()) {
+				DEBUG_TRACE (DEBUG::Butler, "transport work requested during refill/flush, back to restart\n");
+				goto restart;
 			}
 
-		}
+		} else {
 
-		if (i != rl_with_auditioner.begin() && i != rl_with_auditioner.end()) {
-			/* we didn't get to all the streams */
-			disk_work_outstanding = true;
-		}
+			TrackList::iterator t;
 
-		if (!err && transport_work_requested()) {
-			DEBUG_TRACE (DEBUG::Butler, "transport work requested during refill, back to restart\n");
-			goto restart;
-		}
+			for (t = to_refill.begin(); !transport_work_requested() && should_run && t != to_refill.end(); ++t) {
+				if (refill_track (*t)) {
+					disk_work_outstanding = true;
+				}
+			}
+
+			if (t != to_refill.begin()) {
+				add_refill_time (g_get_monotonic_time () - refill_start);
+			}
+
+			if (t != to_refill.begin() && t != to_refill.end()) {
+				/* we didn't get to all the streams */
+				disk_work_outstanding = true;
+			}
+
+			if (!err && transport_work_requested()) {
+				DEBUG_TRACE (DEBUG::Butler, "transport work requested during refill, back to restart\n");
+				goto restart;
+			}
 
-		disk_work_outstanding = flush_tracks_to_disk_normal (rl, err);
+			disk_work_outstanding = flush_tracks_to_disk_normal (rl, err);
+		}
 
 		if (err && _session.actively_recording()) {
 			/* stop the transport and try to catch as much possible
@@ -307,6 +362,120 @@ Butler::thread_work ()
 	return (0);
 }
 
+void
+Butler::add_refill_time (int64_t us)
+{
+	Glib::Threads::Mutex::Lock lm (_stats_lock);
+	++_refill_stats.runs;
+	_refill_stats.total_us += us;
+	_refill_stats.max_us = std::max (_refill_stats.max_us, us);
+}
+
+Butler::RefillStats
+Butler::refill_stats () const
+{
+	Glib::Threads::Mutex::Lock lm (_stats_lock);
+	return _refill_stats;
+}
+
+void
+Butler::reset_refill_stats ()
+{
+	Glib::Threads::Mutex::Lock lm (_stats_lock);
+	_refill_stats = RefillStats ();
+}
+
+/** Fill @a tracks with the tracks in @a rl that need to be read from disk,
+ *  those with the least data left in their playback buffers first.
+ */
+void
+Butler::tracks_to_refill (RouteList const & rl, TrackList& tracks) const
+{
+	/* take each track's load once; it keeps changing while we sort */
+	std::vector<std::pair<float, boost::shared_ptr<Track> > > loads;
+
+	for (RouteList::const_iterator i = rl.begin(); i != rl.end(); ++i) {
+
+		boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+
+		if (!tr) {
+			continue;
+		}
+
+		boost::shared_ptr<IO> io = tr->input ();
+
+		if (io && !io->active()) {
+			/* don't read inactive tracks */
+			DEBUG_TRACE (DEBUG::Butler, string_compose ("butler skips inactive track %1\n", tr->name()));
+			continue;
+		}
+
+		loads.push_back (std::make_pair (tr->playback_buffer_load (), tr));
+	}
+
+	std::stable_sort (loads.begin(), loads.end(), PlaybackLoadSorter ());
+
+	tracks.clear ();
+
+	for (std::vector<std::pair<float, boost::shared_ptr<Track> > >::iterator i = loads.begin(); i != loads.end(); ++i) {
+		tracks.push_back (i->second);
+	}
+}
+
+/** @return true if the track has more to read */
+bool
+Butler::refill_track (boost::shared_ptr<Track> tr)
+{
+	DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), tr->playback_buffer_load()));
+
+	switch (tr->do_refill ()) {
+	case 0:
+		DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
+		break;
+
+	case 1:
+		DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name()));
+		return true;
+
+	default:
+		error << string_compose(_("Butler read ahead failure on dstream %1"), tr->name()) << endmsg;
+		std::cerr << string_compose(_("Butler read ahead failure on dstream %1"), tr->name()) << std::endl;
+		break;
+	}
+
+	return false;
+}
+
+/** @return true if the track has more to write */
+bool
+Butler::flush_track (boost::shared_ptr<Track> tr, uint32_t& errors)
+{
+	/* note that we still try to flush diskstreams attached to inactive routes
+	 */
+
+	DEBUG_TRACE (DEBUG::Butler, string_compose ("butler flushes track %1 capture load %2\n", tr->name(), tr->capture_buffer_load()));
+
+	switch (tr->do_flush (ButlerContext, false)) {
+	case 0:
+		DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush complete for %1\n", tr->name()));
+		break;
+
+	case 1:
+		DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush not finished for %1\n", tr->name()));
+		return true;
+
+	default:
+		errors++;
+		error << string_compose(_("Butler write-behind failure on dstream %1"), tr->name()) << endmsg;
+		std::cerr << string_compose(_("Butler write-behind failure on dstream %1"), tr->name()) << std::endl;
+		/* don't break - try to flush all streams in case they
+		   are split across disks.
+		*/
+	}
+
+	return false;
+}
+
 bool
 Butler::flush_tracks_to_disk_normal (boost::shared_ptr<RouteList> rl, uint32_t& errors)
 {
@@ -322,30 +491,8 @@ Butler::flush_tracks_to_disk_normal (boost::shared_ptr<RouteList> rl, uint32_t&
 			continue;
 		}
 
-		/* note that we still try to flush diskstreams attached to inactive routes
-		 */
-
-		int ret;
-
-		DEBUG_TRACE (DEBUG::Butler, string_compose ("butler flushes track %1 capture load %2\n", tr->name(), tr->capture_buffer_load()));
-		ret = tr->do_flush (ButlerContext, false);
-		switch (ret) {
-		case 0:
-			DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush complete for %1\n", tr->name()));
-			break;
-
-		case 1:
-			DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush not finished for %1\n", tr->name()));
+		if (flush_track (tr, errors)) {
 			disk_work_outstanding = true;
-			break;
-
-		default:
-			errors++;
-			error << string_compose(_("Butler write-behind failure on dstream %1"), (*i)->name()) << endmsg;
-			std::cerr << string_compose(_("Butler write-behind failure on dstream %1"), (*i)->name()) << std::endl;
-			/* don't break - try to flush all streams in case they
-			   are split across disks.
-			*/
 		}
 	}
 
@@ -488,6 +635,159 @@ Butler::empty_pool_trash ()
 	}
 }
 
+Butler::WorkerPool::WorkerPool (Butler& b, Job j)
+	: _butler (b)
+	, _job (j)
+	, _next (0)
+	, _busy (0)
+	, _outstanding (false)
+	, _errors (0)
+	, _quit (false)
+{
+}
+
+Butler::WorkerPool::~WorkerPool ()
+{
+	stop ();
+}
+
+int
+Butler::WorkerPool::start (uint32_t n_threads)
+{
+	for (uint32_t n = 0; n < n_threads; ++n) {
+		pthread_t t;
+		if (pthread_create_and_store (_job == Refill ? "disk reader" : "disk writer", &t, _thread_work, this)) {
+			return -1;
+		}
+		_threads.push_back (t);
+	}
+
+	return 0;
+}
+
+void
+Butler::WorkerPool::stop ()
+{
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		_quit = true;
+		_work_cond.broadcast ();
+	}
+
+	for (std::vector<pthread_t>::iterator i = _threads.begin(); i != _threads.end(); ++i) {
+		void* status;
+		pthread_join (*i, &status);
+	}
+
+	_threads.clear ();
+}
+
+/** Hand out a new list of tracks to the workers. Must not be called
+ *  until wait() has returned for the previous list.
+ */
+void
+Butler::WorkerPool::submit (TrackList const & tracks)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	_tracks = tracks;
+	_next = 0;
+	_outstanding = false;
+	_errors = 0;
+
+	_work_cond.broadcast ();
+}
+
+/** Wait until every track passed to submit() has been dealt with.
+ *  @param errors incremented by the number of write errors.
+ *  @return true if some track has more work to do.
+ */
+bool
+Butler::WorkerPool::wait (uint32_t& errors)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	while (_busy > 0 || _next < _tracks.size ()) {
+		_done_cond.wait (_lock);
+	}
+
+	_tracks.clear ();
+	errors += _errors;
+
+	return _outstanding;
+}
+
+void*
+Butler::WorkerPool::_thread_work (void* arg)
+{
+	SessionEvent::create_per_thread_pool (X_("butler worker events"), 64);
+	pthread_set_name (X_("butler worker"));
+	((WorkerPool*) arg)->thread_work ();
+	return 0;
+}
+
+void
+Butler::WorkerPool::thread_work ()
+{
+	if (_job == Refill) {
+		AudioDiskstream::allocate_thread_working_buffers ();
+	}
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	while (true) {
+
+		while (!_quit && _next >= _tracks.size ()) {
+			_work_cond.wait (_lock);
+		}
+
+		if (_quit) {
+			break;
+		}
+
+		if (_butler.transport_work_requested () || !_butler.should_run) {
+			/* give up on the rest of the list so that the butler
+			   can get on with the transport work straight away
+			*/
+			_next = _tracks.size ();
+			_outstanding = true;
+			if (_busy == 0) {
+				_done_cond.signal ();
+			}
+			continue;
+		}
+
+		boost::shared_ptr<Track> tr = _tracks[_next++];
+		++_busy;
+
+		lm.release ();
+
+		bool outstanding;
+		uint32_t errors = 0;
+
+		if (_job == Refill) {
+			outstanding = _butler.refill_track (tr);
+		} else {
+			outstanding = _butler.flush_track (tr, errors);
+		}
+
+		lm.acquire ();
+
+		_outstanding = _outstanding || outstanding;
+		_errors += errors;
+
+		if (--_busy == 0 && _next >= _tracks.size ()) {
+			_done_cond.signal ();
+		}
+	}
+
+	lm.release ();
+
+	if (_job == Refill) {
+		AudioDiskstream::free_thread_working_buffers ();
+	}
+}
+
 void
 Butler::drop_references ()
 {
@@ -55,6 +55,10 @@ namespace ARDOUR {
 ExportGraphBuilder::ExportGraphBuilder (Session const & session)
 	: session (session)
 	, thread_pool (hardware_concurrency())
+	, parallel (hardware_concurrency() > 1)
+	, parallel_thread_pool (hardware_concurrency())
+	, channel_config_threader (new Threader<Sample> (parallel_thread_pool))
+	, normalizer_threader (new Threader<Sample> (parallel_thread_pool))
 {
 	process_buffer_frames = session.engine().samples_per_cycle();
 }
@@ -68,12 +72,21 @@ ExportGraphBuilder::process (framecnt_t frames, bool last_cycle)
 {
 	assert(frames <= process_buffer_frames);
 
+	// Each channel is read only once, its data is shared by all channel configurations
 	for (ChannelMap::iterator it = channels.begin(); it != channels.end(); ++it) {
-		Sample const * process_buffer = 0;
-		it->first->read (process_buffer, frames);
-		ConstProcessContext<Sample> context(process_buffer, frames, 1);
-		if (last_cycle) { context().set_flag (ProcessContext<Sample>::EndOfInput); }
-		it->second->process (context);
+		it->second = 0;
+		it->first->read (it->second, frames);
+	}
+
+	ConstProcessContext<Sample> context(0, frames, 1);
+	if (last_cycle) { context().set_flag (ProcessContext<Sample>::EndOfInput); }
+
+	if (channel_configs.size() > 1 && parallel) {
+		channel_config_threader->process (context);
+	} else {
+		for (ChannelConfigList::iterator it = channel_configs.begin(); it != channel_configs.end(); ++it) {
+			it->sink()->process (context);
+		}
 	}
 
 	return 0;
@@ -82,8 +95,20 @@ ExportGraphBuilder::process (framecnt_t frames, bool last_cycle)
 bool
 ExportGraphBuilder::process_normalize ()
 {
+	if (normalizers.size() > 1 && parallel) {
+		normalizer_threader->clear_outputs ();
+		for (std::list<Normalizer *>::iterator it = normalizers.begin(); it != normalizers.end(); ++it) {
+			normalizer_threader->add_output ((*it)->pass_sink ());
+		}
+		normalizer_threader->process (ConstProcessContext<Sample> (0, 0, 1));
+	} else {
+		for (std::list<Normalizer *>::iterator it = normalizers.begin(); it != normalizers.end(); ++it) {
+			(*it)->process ();
+		}
+	}
+
 	for (std::list<Normalizer *>::iterator it = normalizers.begin(); it != normalizers.end(); /* ++ in loop */) {
-		if ((*it)->process()) {
+		if ((*it)->finished()) {
 			it = normalizers.erase (it);
 		} else {
 			++it;
@@ -107,6 +132,8 @@ void
 ExportGraphBuilder::reset ()
 {
 	timespan.reset();
+	channel_config_threader->clear_outputs ();
+	normalizer_threader->clear_outputs ();
 	channel_configs.clear ();
 	channels.clear ();
 	normalizers.clear ();
@@ -117,6 +144,9 @@ ExportGraphBuilder::cleanup (bool remove_out_files/*=false*/)
 {
 	ChannelConfigList::iterator iter = channel_configs.begin();
 
+	channel_config_threader->clear_outputs ();
+	normalizer_threader->clear_outputs ();
+
 	while (iter != channel_configs.end() ) {
 		iter->remove_children(remove_out_files);
 		iter = channel_configs.erase(iter);
@@ -185,6 +215,7 @@ ExportGraphBuilder::add_split_config (FileSpec const & config)
 
 	// No duplicate channel config found, create new one
 	channel_configs.push_back (new ChannelConfig (*this, config, channels));
+	channel_config_threader->add_output (channel_configs.back().sink());
 }
 
 /* Encoder */
@@ -368,6 +399,8 @@ ExportGraphBuilder::SFC::operator== (FileSpec const & other_config) const
 
 ExportGraphBuilder::Normalizer::Normalizer (ExportGraphBuilder & parent, FileSpec const & new_config, framecnt_t /*max_frames*/)
 	: parent (parent)
+	, pass (new Pass (*this))
+	, _finished (false)
 {
 	std::string tmpfile_path = parent.session.session_directory().export_path();
 	tmpfile_path = Glib::build_filename(tmpfile_path, "XXXXXX");
@@ -446,7 +479,8 @@ bool
 ExportGraphBuilder::Normalizer::process()
 {
 	framecnt_t frames_read = tmp_file->read (*buffer);
-	return frames_read != buffer->frames();
+	_finished = frames_read != buffer->frames();
+	return _finished;
 }
 
 void
@@ -455,6 +489,9 @@ ExportGraphBuilder::Normalizer::start_post_processing()
 	normalizer->set_peak (peak_reader->get_peak());
 	tmp_file->seek (0, SEEK_SET);
 	tmp_file->add_output (normalizer);
+
+	// Channel configurations may reach the end of input concurrently
+	Glib::Threads::Mutex::Lock lm (parent.normalizers_lock);
 	parent.normalizers.push_back (this);
 }
 
@@ -598,6 +635,8 @@ ExportGraphBuilder::SilenceHandler::operator== (FileSpec const & other_config) c
 
 ExportGraphBuilder::ChannelConfig::ChannelConfig (ExportGraphBuilder & parent, FileSpec const & new_config, ChannelMap & channel_map)
 	: parent (parent)
+	, channel_map (channel_map)
+	, input (new Input (*this))
 {
 	typedef ExportChannelConfiguration::ChannelList ChannelList;
 
@@ -617,19 +656,35 @@ ExportGraphBuilder::ChannelConfig::ChannelConfig (ExportGraphBuilder & parent, F
 	interleaver->add_output(chunker);
 
 	ChannelList const & channel_list = config.channel_config->get_channels();
+	for (ChannelList::const_iterator it = channel_list.begin(); it != channel_list.end(); ++it) {
+		channel_map.insert (std::make_pair (*it, (Sample const *) 0));
+	}
+
+	add_child (new_config);
+}
+
+ExportGraphBuilder::FloatSinkPtr
+ExportGraphBuilder::ChannelConfig::sink ()
+{
+	return input;
+}
+
+void
+ExportGraphBuilder::ChannelConfig::Input::process (ProcessContext<Sample> const & c)
+{
+	typedef ExportChannelConfiguration::ChannelList ChannelList;
+
+	ChannelList const & channel_list = config.config.channel_config->get_channels();
 	unsigned chan = 0;
 	for (ChannelList::const_iterator it = channel_list.begin(); it != channel_list.end(); ++it, ++chan) {
-		ChannelMap::iterator map_it = channel_map.find (*it);
-		if (map_it == channel_map.end()) {
-			std::pair<ChannelMap::iterator, bool> result_pair =
-				channel_map.insert (std::make_pair (*it, IdentityVertexPtr (new IdentityVertex<Sample> ())));
-			assert (result_pair.second);
-			map_it = result_pair.first;
+		ChannelMap::const_iterator map_it = config.channel_map.find (*it);
+		assert (map_it != config.channel_map.end());
+		ConstProcessContext<Sample> context (map_it->second, c.frames(), 1);
+		if (c.has_flag (ProcessContext<Sample>::EndOfInput)) {
+			context().set_flag (ProcessContext<Sample>::EndOfInput);
 		}
-		map_it->second->add_output (interleaver->input (chan));
+		config.interleaver->input (chan)->process (context);
 	}
-
-	add_child (new_config);
 }
 
 void
@@ -137,6 +137,9 @@ apply_gain_to_buffer_t  ARDOUR::apply_gain_to_buffer = 0;
 mix_buffers_with_gain_t ARDOUR::mix_buffers_with_gain = 0;
 mix_buffers_no_gain_t   ARDOUR::mix_buffers_no_gain = 0;
 copy_vector_t			ARDOUR::copy_vector = 0;
+kmeter_process_t        ARDOUR::kmeter_process = 0;
+ppm_process_t           ARDOUR::ppm_process = 0;
+vumeter_process_t       ARDOUR::vumeter_process = 0;
 
 PBD::Signal1<void,std::string> ARDOUR::BootMessage;
 PBD::Signal3<void,std::string,std::string,bool> ARDOUR::PluginScanMessage;
@@ -186,6 +189,9 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_sse_avx_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
+			kmeter_process        = x86_sse_kmeter_process;
+			ppm_process           = x86_sse_ppm_process;
+			vumeter_process       = x86_sse_vumeter_process;
 
 			generic_mix_functions = false;
 
@@ -200,6 +206,9 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_sse_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
+			kmeter_process        = x86_sse_kmeter_process;
+			ppm_process           = x86_sse_ppm_process;
+			vumeter_process       = x86_sse_vumeter_process;
 
 			generic_mix_functions = false;
 
@@ -218,6 +227,9 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain  = veclib_mix_buffers_with_gain;
 			mix_buffers_no_gain    = veclib_mix_buffers_no_gain;
 			copy_vector            = default_copy_vector;
+			kmeter_process         = default_kmeter_process;
+			ppm_process            = default_ppm_process;
+			vumeter_process        = default_vumeter_process;
 
 			generic_mix_functions = false;
 
@@ -238,6 +250,9 @@ setup_hardware_optimization (bool try_optimization)
 		mix_buffers_with_gain = default_mix_buffers_with_gain;
 		mix_buffers_no_gain   = default_mix_buffers_no_gain;
 		copy_vector           = default_copy_vector;
+		kmeter_process        = default_kmeter_process;
+		ppm_process           = default_ppm_process;
+		vumeter_process       = default_vumeter_process;
 
 		info << "No H/W specific optimizations in use" << endmsg;
 	}
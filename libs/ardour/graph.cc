@@ -22,10 +22,12 @@
 
 #include "pbd/compose.h"
 #include "pbd/debug_rt_alloc.h"
+#include "pbd/error.h"
 #include "pbd/pthread_utils.h"
 
 #include "ardour/debug.h"
 #include "ardour/graph.h"
+#include "ardour/graphnode.h"
 #include "ardour/types.h"
 #include "ardour/session.h"
 #include "ardour/route.h"
@@ -51,21 +53,20 @@ int alloc_allowed ()
 }
 #endif
 
+static void do_not_delete_the_queue (void*) { }
+
+Glib::Threads::Private<GraphNodeQueue> Graph::_thread_trigger_queue (do_not_delete_the_queue);
+Glib::Threads::Private<PBD::Semaphore> Graph::_thread_sub_node_sem (do_not_delete_the_queue);
+
 Graph::Graph (Session & session)
         : SessionHandleRef (session)
         , _threads_active (false)
+	, _registered_threads (0)
 	, _execution_sem ("graph_execution", 0)
 	, _callback_start_sem ("graph_start", 0)
 	, _callback_done_sem ("graph_done", 0)
 	, _cleanup_sem ("graph_cleanup", 0)
 {
-        pthread_mutex_init( &_trigger_mutex, NULL);
-
-	/* XXX: rather hacky `fix' to stop _trigger_queue.push_back() allocating
-	   memory in the RT thread.
-	*/
-	_trigger_queue.reserve (8192);
-
         _execution_tokens = 0;
 
         _current_chain = 0;
@@ -117,6 +118,26 @@ Graph::reset_thread_list ()
                 drop_threads ();
         }
 
+	/* Each thread gets its own queue of triggered nodes. A node is
+	   triggered at most once per cycle, so 8192 slots per thread means
+	   that a push can never fail in practice.
+	*/
+	for (vector<GraphNodeQueue*>::iterator i = _trigger_queues.begin(); i != _trigger_queues.end(); ++i) {
+		delete *i;
+	}
+	_trigger_queues.clear ();
+
+	for (vector<PBD::Semaphore*>::iterator i = _sub_node_sems.begin(); i != _sub_node_sems.end(); ++i) {
+		delete *i;
+	}
+	_sub_node_sems.clear ();
+
+	for (uint32_t i = 0; i < num_threads; ++i) {
+		_trigger_queues.push_back (new GraphNodeQueue (8192));
+		_sub_node_sems.push_back (new PBD::Semaphore ("graph_sub_nodes", 0));
+	}
+	_registered_threads = 0;
+
         _threads_active = true;
 
 	if (AudioEngine::instance()->create_process_thread (boost::bind (&Graph::main_thread, this)) != 0) {
@@ -140,7 +161,6 @@ Graph::session_going_away()
         _nodes_rt[1].clear();
         _init_trigger_list[0].clear();
         _init_trigger_list[1].clear();
-        _trigger_queue.clear();
 }
 
 void
@@ -152,18 +172,24 @@ Graph::drop_threads ()
         uint32_t thread_count = AudioEngine::instance()->process_thread_count ();
 
         for (unsigned int i=0; i < thread_count; i++) {
-		pthread_mutex_lock (&_trigger_mutex);
 		_execution_sem.signal ();
-		pthread_mutex_unlock (&_trigger_mutex);
         }
 
-	pthread_mutex_lock (&_trigger_mutex);
         _callback_start_sem.signal ();
-	pthread_mutex_unlock (&_trigger_mutex);
 
 	AudioEngine::instance()->join_process_threads ();
 
 	_execution_tokens = 0;
+
+	for (vector<GraphNodeQueue*>::iterator i = _trigger_queues.begin(); i != _trigger_queues.end(); ++i) {
+		delete *i;
+	}
+	_trigger_queues.clear ();
+
+	for (vector<PBD::Semaphore*>::iterator i = _sub_node_sems.begin(); i != _sub_node_sems.end(); ++i) {
+		delete *i;
+	}
+	_sub_node_sems.clear ();
 }
 
 void
@@ -217,20 +243,61 @@ Graph::prep()
         _finished_refcount = _init_finished_refcount[chain];
 
 	/* Trigger the initial nodes for processing, which are the ones at the `input' end */
-	pthread_mutex_lock (&_trigger_mutex);
         for (i=_init_trigger_list[chain].begin(); i!=_init_trigger_list[chain].end(); i++) {
-		/* don't use ::trigger here, as we have already locked the mutex */
-                _trigger_queue.push_back (i->get ());
+                trigger (i->get ());
         }
-	pthread_mutex_unlock (&_trigger_mutex);
 }
 
+/** Queue a node for processing. Must be called from one of our processing
+ *  threads; the node goes onto that thread's own queue.
+ */
 void
 Graph::trigger (GraphNode* n)
 {
-	pthread_mutex_lock (&_trigger_mutex);
-        _trigger_queue.push_back (n);
-	pthread_mutex_unlock (&_trigger_mutex);
+	GraphNodeQueue* q = _thread_trigger_queue.get ();
+	assert (q);
+
+	if (!q->push (n)) {
+		/* cannot happen as long as there are fewer nodes than queue slots */
+		fatal << _("programming error: graph trigger queue overflow") << endmsg;
+		abort (); /*NOTREACHED*/
+	}
+
+	/* The calling thread will run the first node on its queue itself
+	   when it is done with its current one; anything beyond that is
+	   stealable work, so wake up a sleeping thread to take it.
+	*/
+	if (q->read_space () > 1) {
+		wake_one ();
+	}
+}
+
+/** Wake up one sleeping processing thread, if there is one */
+void
+Graph::wake_one ()
+{
+	if (take_execution_token ()) {
+		DEBUG_TRACE(DEBUG::ProcessThreads, string_compose ("%1 signals\n", pthread_name()));
+		_execution_sem.signal ();
+	}
+}
+
+/** Atomically decrement the number of sleeping threads, unless it is zero.
+ *  @return true if a token was taken.
+ */
+bool
+Graph::take_execution_token ()
+{
+	gint et;
+
+	do {
+		et = g_atomic_int_get (&_execution_tokens);
+		if (et <= 0) {
+			return false;
+		}
+	} while (!g_atomic_int_compare_and_exchange (&_execution_tokens, et, et - 1));
+
+	return true;
 }
 
 /** Called when a node at the `output' end of the chain (ie one that has no-one to feed)
@@ -348,54 +415,74 @@ Graph::rechain (boost::shared_ptr<RouteList> routelist, GraphEdges const & edges
         dump(chain);
 }
 
-/** Called by both the main thread and all helpers.
- *  @return true to quit, false to carry on.
+/** Pick the next node to run: the most recently triggered one from our own
+ *  queue if there is one, otherwise the oldest one from any other thread's
+ *  queue.
+ *  @return true if a node was found.
  */
 bool
-Graph::run_one()
+Graph::find_node (uint32_t thread_id, GraphNode*& n)
 {
-        GraphNode* to_run;
+	uint32_t const nq = _trigger_queues.size ();
 
-        pthread_mutex_lock (&_trigger_mutex);
-        if (_trigger_queue.size()) {
-                to_run = _trigger_queue.back();
-                _trigger_queue.pop_back();
-        } else {
-                to_run = 0;
-        }
+	if (_trigger_queues[thread_id]->pop (n)) {
+		return true;
+	}
 
-	/* the number of threads that are asleep */
-	int et = _execution_tokens;
-	/* the number of nodes that need to be run */
-	int ts = _trigger_queue.size();
+	for (uint32_t i = 1; i < nq; ++i) {
+		if (_trigger_queues[(thread_id + i) % nq]->steal (n)) {
+			return true;
+		}
+	}
 
-	/* hence how many threads to wake up */
-        int wakeup = min (et, ts);
-	/* update the number of threads that will still be sleeping */
-        _execution_tokens -= wakeup;
+	return false;
+}
 
-        DEBUG_TRACE(DEBUG::ProcessThreads, string_compose ("%1 signals %2\n", pthread_name(), wakeup));
+/** Called by a processing thread when it starts up.
+ *  @return the index of the thread's trigger queue.
+ */
+uint32_t
+Graph::register_thread ()
+{
+	uint32_t const thread_id = g_atomic_int_add (&_registered_threads, 1);
+	assert (thread_id < _trigger_queues.size ());
+	_thread_trigger_queue.set (_trigger_queues[thread_id]);
+	_thread_sub_node_sem.set (_sub_node_sems[thread_id]);
+	return thread_id;
+}
 
-        for (int i = 0; i < wakeup; i++) {
-                _execution_sem.signal ();
-        }
+/** Called by both the main thread and all helpers.
+ *  @return true to quit, false to carry on.
+ */
+bool
+Graph::run_one (uint32_t thread_id)
+{
+        GraphNode* to_run = 0;
+
+        while (!find_node (thread_id, to_run)) {
+
+		/* There is nothing to do; announce that we are going to sleep */
+		g_atomic_int_inc (&_execution_tokens);
+
+		/* A node may have been queued by another thread after we
+		   looked, but before it could see our token. Look again
+		   now that the token is visible.
+		*/
+		if (find_node (thread_id, to_run)) {
+			if (!take_execution_token ()) {
+				/* somebody took our token and will signal us; eat that */
+				_execution_sem.wait ();
+			}
+			break;
+		}
 
-        while (to_run == 0) {
-                _execution_tokens += 1;
-                pthread_mutex_unlock (&_trigger_mutex);
                 DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 goes to sleep\n", pthread_name()));
                 _execution_sem.wait ();
                 if (!_threads_active) {
                         return true;
                 }
                 DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 is awake\n", pthread_name()));
-                pthread_mutex_lock (&_trigger_mutex);
-                if (_trigger_queue.size()) {
-                        to_run = _trigger_queue.back();
-                        _trigger_queue.pop_back();
-                }
         }
-        pthread_mutex_unlock (&_trigger_mutex);
 
         to_run->process();
         to_run->finish (_current_chain);
@@ -414,8 +501,10 @@ Graph::helper_thread()
 
         pt->get_buffers();
 
+	uint32_t const thread_id = register_thread ();
+
         while(1) {
-                if (run_one()) {
+                if (run_one (thread_id)) {
                         break;
                 }
         }
@@ -433,6 +522,8 @@ Graph::main_thread()
 
         pt->get_buffers();
 
+	uint32_t const thread_id = register_thread ();
+
   again:
         _callback_start_sem.wait ();
 
@@ -453,7 +544,7 @@ Graph::main_thread()
 	/* This loop will run forever */
         while (1) {
 		DEBUG_TRACE(DEBUG::ProcessThreads, "main thread runs one graph node\n");
-                if (run_one()) {
+                if (run_one (thread_id)) {
                         break;
                 }
         }
@@ -596,6 +687,75 @@ Graph::process_one_route (Route* route)
         }
 }
 
+/** Run a batch of sub-nodes, and return once all of them have finished.
+ *
+ *  Must be called from within GraphNode::process() of a node that one of our
+ *  threads is running. The calling thread runs the first sub-node itself and
+ *  queues the others, where idle graph threads can steal them. It then runs
+ *  those that nobody has taken, and waits for the rest. If we are not called
+ *  from a graph thread, all sub-nodes are run one after another.
+ */
+void
+Graph::run_sub_nodes (GraphSubNode** nodes, uint32_t n_nodes)
+{
+	GraphNodeQueue* q = _thread_trigger_queue.get ();
+
+	if (!q || n_nodes < 2) {
+		for (uint32_t i = 0; i < n_nodes; ++i) {
+			nodes[i]->process ();
+		}
+		return;
+	}
+
+	gint pending = n_nodes;
+	PBD::Semaphore* done = _thread_sub_node_sem.get ();
+
+	for (uint32_t i = 0; i < n_nodes; ++i) {
+		nodes[i]->_pending = &pending;
+		nodes[i]->_done = done;
+	}
+
+	/* queue in reverse order, so that we pop them in order below */
+	for (uint32_t i = n_nodes - 1; i > 0; --i) {
+		if (q->push (nodes[i])) {
+			wake_one ();
+		} else {
+			nodes[i]->process ();
+			nodes[i]->finish (_current_chain);
+		}
+	}
+
+	nodes[0]->process ();
+	nodes[0]->finish (_current_chain);
+
+	/* Run what is left of our batch on our own queue. Anything else
+	   there is a route that must wait until we are done with ours.
+	*/
+	GraphNode* n;
+
+	while (g_atomic_int_get (&pending) > 0 && q->pop (n)) {
+		bool ours = false;
+		for (uint32_t i = 1; i < n_nodes; ++i) {
+			if (n == nodes[i]) {
+				ours = true;
+				break;
+			}
+		}
+		if (!ours) {
+			q->push (n);
+			break;
+		}
+		n->process ();
+		n->finish (_current_chain);
+	}
+
+	/* Sleep until the sub-nodes that other threads stole are done. The
+	   last sub-node to finish signals exactly once per batch, so if that
+	   was one of ours this returns at once.
+	*/
+	done->wait ();
+}
+
 bool
 Graph::in_process_thread () const
 {
@@ -78,3 +78,19 @@ GraphNode::process()
 {
         _graph->process_one_route (dynamic_cast<Route *>(this));
 }
+
+GraphSubNode::GraphSubNode ()
+	: GraphNode (boost::shared_ptr<Graph> ())
+	, _pending (0)
+	, _done (0)
+{
+}
+
+/** Called by whichever graph thread ran us */
+void
+GraphSubNode::finish (int)
+{
+	if (g_atomic_int_dec_and_test (_pending)) {
+		_done->signal ();
+	}
+}
@@ -19,6 +19,7 @@
 
 #include <math.h>
 #include "ardour/iec1ppmdsp.h"
+#include "ardour/runtime_functions.h"
 
 
 float Iec1ppmdsp::_w1;
@@ -77,6 +78,39 @@ void Iec1ppmdsp::process (float const *p, int n)
 }
 
 
+void Iec1ppmdsp::process (Iec1ppmdsp * const *meters, float const * const *bufs, unsigned int n_meters, int n)
+{
+    const unsigned int chunk = 64;
+    float z1 [chunk];
+    float z2 [chunk];
+    float m [chunk];
+
+    for (unsigned int c = 0; c < n_meters; c += chunk)
+    {
+	const unsigned int nc = n_meters - c < chunk ? n_meters - c : chunk;
+
+	for (unsigned int i = 0; i < nc; ++i)
+	{
+	    Iec1ppmdsp *d = meters [c + i];
+	    z1 [i] = d->_z1 > 20 ? 20 : (d->_z1 < 0 ? 0 : d->_z1);
+	    z2 [i] = d->_z2 > 20 ? 20 : (d->_z2 < 0 ? 0 : d->_z2);
+	    m [i] = d->_res ? 0 : d->_m;
+	    d->_res = false;
+	}
+
+	ARDOUR::ppm_process (bufs + c, nc, n < 0 ? 0 : n, _w1, _w2, _w3, z1, z2, m);
+
+	for (unsigned int i = 0; i < nc; ++i)
+	{
+	    Iec1ppmdsp *d = meters [c + i];
+	    d->_z1 = z1 [i] + 1e-10f;
+	    d->_z2 = z2 [i] + 1e-10f;
+	    d->_m = m [i];
+	}
+    }
+}
+
+
 float Iec1ppmdsp::read (void)
 {
     _res = true;
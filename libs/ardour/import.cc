@@ -23,6 +23,8 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <deque>
+#include <list>
 #include <string>
 #include <climits>
 #include <cerrno>
@@ -42,6 +44,7 @@
 
 #include "pbd/basename.h"
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
 
 #include "evoral/SMF.hpp"
 
@@ -227,82 +230,237 @@ compose_status_message (const string& path,
 	return string_compose (_("Copying %1"), Glib::path_get_basename (path));
 }
 
-static void
-write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
-                               vector<boost::shared_ptr<Source> >& newfiles)
+/** Imports one audio file as a two-stage pipeline. One thread reads
+ *  (and if necessary resamples) the source and de-interleaves it; the
+ *  other writes each channel to its new mono file, which computes its
+ *  peaks from the same buffers as it goes. A fixed set of blocks is
+ *  handed back and forth, so neither stage allocates and neither waits
+ *  for the other unless it is a whole queue ahead.
+ */
+class AudioImportJob
 {
-	const framecnt_t nframes = ResampledImportableSource::blocksize;
-	boost::shared_ptr<AudioFileSource> afs;
-	uint32_t channels = source->channels();
-	if (channels == 0) {
-		return;
+  public:
+	AudioImportJob (boost::shared_ptr<ImportableSource>, vector<boost::shared_ptr<Source> > const &, ImportStatus&);
+	~AudioImportJob ();
+
+	bool start ();
+	void wait ();
+
+	bool finished () const { return g_atomic_int_get (&_finished); }
+	float progress () const { return _progress; }
+
+  private:
+	struct Block {
+		Block (uint32_t channels, framecnt_t size) : nframes (0), nsamples (0) {
+			for (uint32_t n = 0; n < channels; ++n) {
+				data.push_back (boost::shared_array<Sample> (new Sample[size]));
+			}
+		}
+
+		vector<boost::shared_array<Sample> > data;
+		framecnt_t nframes;  ///< frames per channel
+		framecnt_t nsamples; ///< interleaved samples read from the source
+	};
+
+	static const uint32_t n_blocks = 8;
+
+	boost::shared_ptr<ImportableSource> _source;
+	vector<boost::shared_ptr<AudioFileSource> > _newfiles;
+	ImportStatus& _status;
+	uint32_t _channels;
+	double _total_samples;
+
+	vector<Block*> _blocks;
+	deque<Block*> _free;
+	deque<Block*> _full; ///< a null block marks the end of the data
+	Glib::Threads::Mutex _lock;
+	Glib::Threads::Cond _cond;
+
+	Glib::Threads::Thread* _decoder;
+	Glib::Threads::Thread* _writer;
+
+	float _progress_base;
+	float _progress_multiplier;
+	volatile float _progress;
+	mutable gint _finished;
+
+	Block* get_free_block ();
+	void queue_block (Block*);
+	Block* get_full_block ();
+	void release_block (Block*);
+
+	float normalizing_gain (Sample*, framecnt_t nframes);
+	void decode ();
+	void write ();
+};
+
+AudioImportJob::AudioImportJob (boost::shared_ptr<ImportableSource> source, vector<boost::shared_ptr<Source> > const & newfiles, ImportStatus& status)
+	: _source (source)
+	, _status (status)
+	, _channels (source->channels())
+	, _total_samples (source->ratio() * source->length() * source->channels())
+	, _decoder (0)
+	, _writer (0)
+	, _progress_base (0)
+	, _progress_multiplier (1)
+	, _progress (0)
+	, _finished (0)
+{
+	for (vector<boost::shared_ptr<Source> >::const_iterator i = newfiles.begin(); i != newfiles.end(); ++i) {
+		_newfiles.push_back (boost::dynamic_pointer_cast<AudioFileSource> (*i));
 	}
+}
 
-	boost::scoped_array<float> data(new float[nframes * channels]);
-	vector<boost::shared_array<Sample> > channel_data;
+AudioImportJob::~AudioImportJob ()
+{
+	wait ();
 
-	for (uint32_t n = 0; n < channels; ++n) {
-		channel_data.push_back(boost::shared_array<Sample>(new Sample[nframes]));
+	for (vector<Block*>::iterator b = _blocks.begin(); b != _blocks.end(); ++b) {
+		delete *b;
 	}
+}
 
-	float gain = 1;
+bool
+AudioImportJob::start ()
+{
+	if (_channels == 0) {
+		g_atomic_int_set (&_finished, 1);
+		return true;
+	}
 
-	boost::shared_ptr<AudioSource> s = boost::dynamic_pointer_cast<AudioSource> (newfiles[0]);
-	assert (s);
+	const framecnt_t block_frames = (ResampledImportableSource::blocksize + _channels - 1) / _channels;
 
-	status.progress = 0.0f;
-	float progress_multiplier = 1;
-	float progress_base = 0;
+	for (uint32_t n = 0; n < n_blocks; ++n) {
+		_blocks.push_back (new Block (_channels, block_frames));
+		_free.push_back (_blocks.back());
+	}
 
-	if (!source->clamped_at_unity() && s->clamped_at_unity()) {
+	try {
+		_writer = Glib::Threads::Thread::create (sigc::mem_fun (*this, &AudioImportJob::write));
+	} catch (Glib::Threads::ThreadError&) {
+		return false;
+	}
 
-		/* The source we are importing from can return sample values with a magnitude greater than 1,
-		   and the file we are writing the imported data to cannot handle such values.  Compute the gain
-		   factor required to normalize the input sources to have a magnitude of less than 1.
-		*/
+	try {
+		_decoder = Glib::Threads::Thread::create (sigc::mem_fun (*this, &AudioImportJob::decode));
+	} catch (Glib::Threads::ThreadError&) {
+		queue_block (0);
+		wait ();
+		return false;
+	}
 
-		float peak = 0;
-		uint32_t read_count = 0;
+	return true;
+}
 
-		while (!status.cancel) {
-			framecnt_t const nread = source->read (data.get(), nframes);
-			if (nread == 0) {
-				break;
-			}
+void
+AudioImportJob::wait ()
+{
+	if (_decoder) {
+		_decoder->join ();
+		_decoder = 0;
+	}
 
-			peak = compute_peak (data.get(), nread, peak);
+	if (_writer) {
+		_writer->join ();
+		_writer = 0;
+	}
+}
 
-			read_count += nread;
-			status.progress = 0.5 * read_count / (source->ratio() * source->length() * channels);
-		}
+AudioImportJob::Block*
+AudioImportJob::get_free_block ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	while (_free.empty()) {
+		_cond.wait (_lock);
+	}
+	Block* b = _free.front();
+	_free.pop_front ();
+	return b;
+}
 
-		if (peak >= 1) {
-			/* we are out of range: compute a gain to fix it */
-			gain = (1 - FLT_EPSILON) / peak;
-		}
+void
+AudioImportJob::queue_block (Block* b)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	_full.push_back (b);
+	_cond.broadcast ();
+}
 
-		source->seek (0);
-		progress_multiplier = 0.5;
-		progress_base = 0.5;
+AudioImportJob::Block*
+AudioImportJob::get_full_block ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	while (_full.empty()) {
+		_cond.wait (_lock);
 	}
+	Block* b = _full.front();
+	_full.pop_front ();
+	return b;
+}
 
+void
+AudioImportJob::release_block (Block* b)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	_free.push_back (b);
+	_cond.broadcast ();
+}
+
+/** Read the whole source to find the gain that keeps it within the range
+ *  of files that clamp at unity. Leaves the source at its start.
+ */
+float
+AudioImportJob::normalizing_gain (Sample* data, framecnt_t nframes)
+{
+	float peak = 0;
 	framecnt_t read_count = 0;
 
-	while (!status.cancel) {
+	while (!_status.cancel) {
+		framecnt_t const nread = _source->read (data, nframes);
+		if (nread == 0) {
+			break;
+		}
 
-		framecnt_t nread, nfread;
-		uint32_t x;
-		uint32_t chn;
+		peak = compute_peak (data, nread, peak);
 
-		if ((nread = source->read (data.get(), nframes)) == 0) {
-#ifdef PLATFORM_WINDOWS
-			/* Flush the data once we've finished importing the file. Windows can  */
-			/* cache the data for very long periods of time (perhaps not writing   */
-			/* it to disk until Ardour closes). So let's force it to flush now.    */
-			for (chn = 0; chn < channels; ++chn)
-				if ((afs = boost::dynamic_pointer_cast<AudioFileSource>(newfiles[chn])) != 0)
-					afs->flush ();
-#endif
+		read_count += nread;
+		_progress = 0.5 * read_count / _total_samples;
+	}
+
+	_source->seek (0);
+
+	if (peak >= 1) {
+		/* we are out of range: compute a gain to fix it */
+		return (1 - FLT_EPSILON) / peak;
+	}
+
+	return 1;
+}
+
+void
+AudioImportJob::decode ()
+{
+	const framecnt_t nframes = ResampledImportableSource::blocksize;
+	boost::scoped_array<float> data (new float[nframes]);
+	float gain = 1;
+
+	if (!_source->clamped_at_unity() && _newfiles[0]->clamped_at_unity()) {
+
+		/* The source we are importing from can return sample values with a magnitude greater than 1,
+		   and the file we are writing the imported data to cannot handle such values.  Compute the gain
+		   factor required to normalize the input sources to have a magnitude of less than 1.
+		*/
+
+		gain = normalizing_gain (data.get(), nframes);
+		_progress_multiplier = 0.5;
+		_progress_base = 0.5;
+	}
+
+	while (!_status.cancel) {
+
+		framecnt_t const nread = _source->read (data.get(), nframes);
+
+		if (nread == 0) {
 			break;
 		}
 
@@ -311,28 +469,95 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 			apply_gain_to_buffer (data.get(), nread, gain);
 		}
 
-		nfread = nread / channels;
+		Block* b = get_free_block ();
 
-		/* de-interleave */
+		b->nframes = nread / _channels;
+		b->nsamples = nread;
 
-		for (chn = 0; chn < channels; ++chn) {
+		/* de-interleave */
 
+		for (uint32_t chn = 0; chn < _channels; ++chn) {
+			Sample* out = b->data[chn].get();
 			framecnt_t n;
-			for (x = chn, n = 0; n < nfread; x += channels, ++n) {
-				channel_data[chn][n] = (Sample) data[x];
+			uint32_t x;
+			for (x = chn, n = 0; n < b->nframes; x += _channels, ++n) {
+				out[n] = data[x];
 			}
 		}
 
-		/* flush to disk */
+		queue_block (b);
+	}
+
+	queue_block (0);
+}
+
+void
+AudioImportJob::write ()
+{
+	framecnt_t written = 0;
+	Block* b;
 
-		for (chn = 0; chn < channels; ++chn) {
-			if ((afs = boost::dynamic_pointer_cast<AudioFileSource>(newfiles[chn])) != 0) {
-				afs->write (channel_data[chn].get(), nfread);
+	while ((b = get_full_block ()) != 0) {
+
+		/* write to disk; each file builds its peaks from this data */
+
+		for (uint32_t chn = 0; chn < _channels; ++chn) {
+			if (_newfiles[chn]) {
+				_newfiles[chn]->write (b->data[chn].get(), b->nframes);
 			}
 		}
 
-		read_count += nread;
-		status.progress = progress_base + progress_multiplier * read_count / (source->ratio () * source->length() * channels);
+		written += b->nsamples;
+		_progress = _progress_base + _progress_multiplier * written / _total_samples;
+
+		release_block (b);
+	}
+
+#ifdef PLATFORM_WINDOWS
+	/* Flush the data once we've finished importing the file. Windows can  */
+	/* cache the data for very long periods of time (perhaps not writing   */
+	/* it to disk until Ardour closes). So let's force it to flush now.    */
+	for (uint32_t chn = 0; chn < _channels; ++chn) {
+		if (_newfiles[chn]) {
+			_newfiles[chn]->flush ();
+		}
+	}
+#endif
+
+	g_atomic_int_set (&_finished, 1);
+}
+
+typedef list<AudioImportJob*> AudioImportJobs;
+
+/** Wait until no more than @param max_running audio imports are still
+ *  running, reporting their combined progress meanwhile.
+ */
+static void
+wait_for_audio_imports (AudioImportJobs& jobs, size_t max_running, ImportStatus& status)
+{
+	while (true) {
+
+		float progress = 0;
+
+		for (AudioImportJobs::iterator i = jobs.begin(); i != jobs.end(); ) {
+			if ((*i)->finished ()) {
+				delete *i;
+				i = jobs.erase (i);
+			} else {
+				progress += (*i)->progress ();
+				++i;
+			}
+		}
+
+		if (!jobs.empty()) {
+			status.progress = progress / jobs.size();
+		}
+
+		if (jobs.size() <= max_running) {
+			break;
+		}
+
+		Glib::usleep (20000);
 	}
 }
 
@@ -456,6 +681,10 @@ Session::import_files (ImportStatus& status)
 	boost::shared_ptr<AudioFileSource> afs;
 	boost::shared_ptr<SMFSource> smfs;
 	uint32_t channels = 0;
+	AudioImportJobs audio_jobs;
+
+	/* each audio import uses two threads */
+	size_t const max_audio_jobs = max (1U, hardware_concurrency() / 2);
 
 	status.sources.clear ();
 
@@ -473,8 +702,8 @@ Session::import_files (ImportStatus& status)
 				channels = source->channels();
 			} catch (const failed_constructor& err) {
 				error << string_compose(_("Import: cannot open input sound file \"%1\""), (*p)) << endmsg;
-				status.done = status.cancel = true;
-				return;
+				status.cancel = true;
+				break;
 			}
 
 		} else {
@@ -484,8 +713,8 @@ Session::import_files (ImportStatus& status)
 				channels = smf_reader->num_tracks();
 			} catch (...) {
 				error << _("Import: error opening MIDI file") << endmsg;
-				status.done = status.cancel = true;
-				return;
+				status.cancel = true;
+				break;
 			}
 		}
 
@@ -522,16 +751,32 @@ Session::import_files (ImportStatus& status)
 		if (source) { // audio
 			status.doing_what = compose_status_message (*p, source->samplerate(),
 			                                            frame_rate(), status.current, status.total);
-			write_audio_data_to_new_files (source.get(), status, newfiles);
+
+			AudioImportJob* job = new AudioImportJob (source, newfiles, status);
+
+			if (!job->start ()) {
+				error << string_compose (_("Import: cannot start import of \"%1\""), (*p)) << endmsg;
+				delete job;
+				status.cancel = true;
+				break;
+			}
+
+			audio_jobs.push_back (job);
+
+			/* leave room for the next file */
+			wait_for_audio_imports (audio_jobs, max_audio_jobs - 1, status);
+
 		} else if (smf_reader.get()) { // midi
 			status.doing_what = string_compose(_("Loading MIDI file %1"), *p);
 			write_midi_data_to_new_files (smf_reader.get(), status, newfiles);
+			status.progress = 0;
 		}
 
 		++status.current;
-		status.progress = 0;
 	}
 
+	wait_for_audio_imports (audio_jobs, 0, status);
+
 	if (!status.cancel) {
 		struct tm* now;
 		time_t xnow;
@@ -16,21 +16,30 @@
     Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 */
 
-#include <glibmm/threads.h>
-
+#include "ardour/buffer_manager.h"
 #include "ardour/internal_return.h"
 #include "ardour/internal_send.h"
+#include "ardour/process_thread.h"
 #include "ardour/route.h"
+#include "ardour/session.h"
 
 using namespace std;
 using namespace ARDOUR;
 
 InternalReturn::InternalReturn (Session& s)
 	: Return (s, true)
+	, _sends (new SendList)
 {
         _display_to_user = false;
 }
 
+InternalReturn::~InternalReturn ()
+{
+	for (vector<Partial*>::iterator p = _partials.begin(); p != _partials.end(); ++p) {
+		delete *p;
+	}
+}
+
 void
 InternalReturn::run (BufferSet& bufs, framepos_t /*start_frame*/, framepos_t /*end_frame*/, pframes_t nframes, bool)
 {
@@ -38,12 +47,17 @@ InternalReturn::run (BufferSet& bufs, framepos_t /*start_frame*/, framepos_t /*e
 		return;
 	}
 
-	Glib::Threads::Mutex::Lock lm (_sends_mutex, Glib::Threads::TRY_LOCK);
+	if (!_sends.reader()->empty ()) {
+
+		/* any partial sum that was not written during this pass is
+		   left over from an earlier one, and must be ignored.
+		*/
 
-	if (lm.locked ()) {
-		for (list<InternalSend*>::iterator i = _sends.begin(); i != _sends.end(); ++i) {
-			if ((*i)->active () && (!(*i)->source_route() || (*i)->source_route()->active())) {
-				bufs.merge_from ((*i)->get_buffers(), nframes);
+		gint const pass = _session.process_pass ();
+
+		for (vector<Partial*>::const_iterator p = _partials.begin(); p != _partials.end(); ++p) {
+			if (g_atomic_int_get (&(*p)->pass) == pass) {
+				bufs.merge_from ((*p)->bufs, nframes);
 			}
 		}
 	}
@@ -51,18 +65,57 @@ InternalReturn::run (BufferSet& bufs, framepos_t /*start_frame*/, framepos_t /*e
 	_active = _pending_active;
 }
 
+void
+InternalReturn::accumulate (BufferSet const & bufs, pframes_t nframes)
+{
+	uint32_t const t = ProcessThread::thread_index ();
+	assert (t < _partials.size ());
+
+	Partial* p = _partials[t];
+	gint const pass = _session.process_pass ();
+
+	if (g_atomic_int_get (&p->pass) != pass) {
+		/* first send to run in this thread during this pass */
+		p->bufs.read_from (bufs, nframes);
+		g_atomic_int_set (&p->pass, pass);
+	} else {
+		p->bufs.merge_from (bufs, nframes);
+	}
+}
+
 void
 InternalReturn::add_send (InternalSend* send)
 {
-	Glib::Threads::Mutex::Lock lm (_sends_mutex);
-	_sends.push_back (send);
+	RCUWriter<SendList> writer (_sends);
+	boost::shared_ptr<SendList> sl = writer.get_copy ();
+	sl->push_back (send);
 }
 
 void
 InternalReturn::remove_send (InternalSend* send)
 {
-	Glib::Threads::Mutex::Lock lm (_sends_mutex);
-	_sends.remove (send);
+	RCUWriter<SendList> writer (_sends);
+	boost::shared_ptr<SendList> sl = writer.get_copy ();
+	sl->remove (send);
+}
+
+void
+InternalReturn::ensure_partials (ChanCount count, pframes_t nframes)
+{
+	/* this is protected by the process lock */
+
+	uint32_t const n = BufferManager::n_thread_buffers ();
+
+	while (_partials.size() < n) {
+		Partial* p = new Partial;
+		g_atomic_int_set (&p->pass, _session.process_pass () - 1);
+		_partials.push_back (p);
+	}
+
+	for (vector<Partial*>::iterator p = _partials.begin(); p != _partials.end(); ++p) {
+		(*p)->bufs.ensure_buffers (count, nframes);
+		(*p)->bufs.set_count (count);
+	}
 }
 
 XMLNode&
@@ -91,5 +144,13 @@ bool
 InternalReturn::configure_io (ChanCount in, ChanCount out)
 {
 	IOProcessor::configure_io (in, out);
+	ensure_partials (in, _session.get_block_size ());
 	return true;
 }
+
+int
+InternalReturn::set_block_size (pframes_t nframes)
+{
+	ensure_partials (input_streams (), nframes);
+	return 0;
+}
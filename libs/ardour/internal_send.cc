@@ -227,7 +227,14 @@ InternalSend::run (BufferSet& bufs, framepos_t start_frame, framepos_t end_frame
 		}
 	}
 
-	/* target will pick up our output when it is ready */
+	/* hand our output to the target, which will pick it up when it runs */
+
+	if (_pending_active) {
+		boost::shared_ptr<InternalReturn> ir = _send_to->internal_return ();
+		if (ir) {
+			ir->accumulate (mixbufs, nframes);
+		}
+	}
 
   out:
 	_active = _pending_active;
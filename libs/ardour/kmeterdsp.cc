@@ -19,6 +19,7 @@
 
 #include <math.h>
 #include "ardour/kmeterdsp.h"
+#include "ardour/runtime_functions.h"
 
 
 float  Kmeterdsp::_omega;
@@ -75,6 +76,39 @@ void Kmeterdsp::process (float const *p, int n)
         z2 += 4 * _omega * (z1 - z2); // Update second filter.
     }
 
+    update (z1, z2);
+}
+
+void Kmeterdsp::process (Kmeterdsp * const *meters, float const * const *bufs, unsigned int n_meters, int n)
+{
+    const unsigned int chunk = 64;
+    float z1 [chunk];
+    float z2 [chunk];
+
+    for (unsigned int c = 0; c < n_meters; c += chunk)
+    {
+	const unsigned int nc = n_meters - c < chunk ? n_meters - c : chunk;
+
+	for (unsigned int i = 0; i < nc; ++i)
+	{
+	    const Kmeterdsp *k = meters [c + i];
+	    z1 [i] = k->_z1 > 50 ? 50 : (k->_z1 < 0 ? 0 : k->_z1);
+	    z2 [i] = k->_z2 > 50 ? 50 : (k->_z2 < 0 ? 0 : k->_z2);
+	}
+
+	ARDOUR::kmeter_process (bufs + c, nc, n < 0 ? 0 : n, _omega, z1, z2);
+
+	for (unsigned int i = 0; i < nc; ++i)
+	{
+	    meters [c + i]->update (z1 [i], z2 [i]);
+	}
+    }
+}
+
+void Kmeterdsp::update (float z1, float z2)
+{
+    float s;
+
     if (isnan(z1)) z1 = 0;
     if (isnan(z2)) z2 = 0;
     // Save filter state. The added constants avoid denormals.
@@ -17,6 +17,7 @@
     Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 */
 
+#include <set>
 #include <string>
 #include <vector>
 #include <limits>
@@ -113,6 +114,7 @@ public:
 	~LV2World ();
 
 	void load_bundled_plugins(bool verbose=false);
+	void load_new_plugins(bool verbose=false);
 
 	LilvWorld* world;
 
@@ -2598,6 +2600,49 @@ LV2World::load_bundled_plugins(bool verbose)
 	}
 }
 
+/** Load the bundles of plugins that were installed since the bundles were
+ *  loaded. Bundles that are loaded already are left alone, since lilv
+ *  replaces the plugins of a bundle that is loaded again, and existing
+ *  plugin instances and infos use those. The new bundles are found with a
+ *  world of their own.
+ */
+void
+LV2World::load_new_plugins(bool verbose)
+{
+	if (!_bundle_checked) {
+		load_bundled_plugins(verbose);
+		return;
+	}
+
+	LV2World scan;
+	scan.load_bundled_plugins();
+
+	const LilvPlugins* known = lilv_world_get_all_plugins(world);
+	const LilvPlugins* found = lilv_world_get_all_plugins(scan.world);
+
+	std::set<std::string> loaded;
+	LILV_FOREACH(plugins, i, known) {
+		loaded.insert(lilv_node_as_uri(lilv_plugin_get_bundle_uri(lilv_plugins_get(known, i))));
+	}
+
+	std::set<std::string> bundles;
+	LILV_FOREACH(plugins, i, found) {
+		const char* bundle = lilv_node_as_uri(lilv_plugin_get_bundle_uri(lilv_plugins_get(found, i)));
+		if (loaded.find(bundle) == loaded.end()) {
+			bundles.insert(bundle);
+		}
+	}
+
+	for (std::set<std::string>::const_iterator b = bundles.begin(); b != bundles.end(); ++b) {
+		if (verbose) {
+			cout << "Loading new LV2 bundle: " << *b << endl;
+		}
+		LilvNode *node = lilv_new_uri(world, b->c_str());
+		lilv_world_load_bundle(world, node);
+		lilv_node_free(node);
+	}
+}
+
 LV2PluginInfo::LV2PluginInfo (const char* plugin_uri)
 {
 	type = ARDOUR::LV2;
@@ -2704,12 +2749,15 @@ LV2PluginInfo::is_instrument () const
 PluginInfoList*
 LV2PluginInfo::discover()
 {
-	LV2World world;
-	world.load_bundled_plugins();
-	_world.load_bundled_plugins(true);
+	/* use the world that plugins are instantiated from, rather than
+	   loading every bundle into a second one. This may be a rescan, so
+	   add any plugins that were installed since, so that they are found
+	   and can be instantiated.
+	*/
+	_world.load_new_plugins(true);
 
 	PluginInfoList*    plugs   = new PluginInfoList;
-	const LilvPlugins* plugins = lilv_world_get_all_plugins(world.world);
+	const LilvPlugins* plugins = lilv_world_get_all_plugins(_world.world);
 
 	LILV_FOREACH(plugins, i, plugins) {
 		const LilvPlugin* p = lilv_plugins_get(plugins, i);
@@ -2725,7 +2773,7 @@ LV2PluginInfo::discover()
 			continue;
 		}
 
-		if (lilv_plugin_has_feature(p, world.lv2_inPlaceBroken)) {
+		if (lilv_plugin_has_feature(p, _world.lv2_inPlaceBroken)) {
 			warning << string_compose(
 			    _("Ignoring LV2 plugin \"%1\" since it cannot do inplace processing."),
 			    lilv_node_as_string(name)) << endmsg;
@@ -2735,8 +2783,8 @@ LV2PluginInfo::discover()
 
 #ifdef HAVE_LV2_1_2_0
 		LilvNodes *required_features = lilv_plugin_get_required_features (p);
-		if (lilv_nodes_contains (required_features, world.bufz_powerOf2BlockLength) ||
-				lilv_nodes_contains (required_features, world.bufz_fixedBlockLength)
+		if (lilv_nodes_contains (required_features, _world.bufz_powerOf2BlockLength) ||
+				lilv_nodes_contains (required_features, _world.bufz_fixedBlockLength)
 		   ) {
 			warning << string_compose(
 			    _("Ignoring LV2 plugin \"%1\" because its buffer-size requirements cannot be satisfied."),
@@ -2773,18 +2821,18 @@ LV2PluginInfo::discover()
 		int count_midi_in = 0;
 		for (uint32_t i = 0; i < lilv_plugin_get_num_ports(p); ++i) {
 			const LilvPort* port  = lilv_plugin_get_port_by_index(p, i);
-			if (lilv_port_is_a(p, port, world.atom_AtomPort)) {
+			if (lilv_port_is_a(p, port, _world.atom_AtomPort)) {
 				LilvNodes* buffer_types = lilv_port_get_value(
-					p, port, world.atom_bufferType);
+					p, port, _world.atom_bufferType);
 				LilvNodes* atom_supports = lilv_port_get_value(
-					p, port, world.atom_supports);
+					p, port, _world.atom_supports);
 
-				if (lilv_nodes_contains(buffer_types, world.atom_Sequence)
-						&& lilv_nodes_contains(atom_supports, world.midi_MidiEvent)) {
-					if (lilv_port_is_a(p, port, world.lv2_InputPort)) {
+				if (lilv_nodes_contains(buffer_types, _world.atom_Sequence)
+						&& lilv_nodes_contains(atom_supports, _world.midi_MidiEvent)) {
+					if (lilv_port_is_a(p, port, _world.lv2_InputPort)) {
 						count_midi_in++;
 					}
-					if (lilv_port_is_a(p, port, world.lv2_OutputPort)) {
+					if (lilv_port_is_a(p, port, _world.lv2_OutputPort)) {
 						count_midi_out++;
 					}
 				}
@@ -2795,18 +2843,18 @@ LV2PluginInfo::discover()
 
 		info->n_inputs.set_audio(
 			lilv_plugin_get_num_ports_of_class(
-				p, world.lv2_InputPort, world.lv2_AudioPort, NULL));
+				p, _world.lv2_InputPort, _world.lv2_AudioPort, NULL));
 		info->n_inputs.set_midi(
 			lilv_plugin_get_num_ports_of_class(
-				p, world.lv2_InputPort, world.ev_EventPort, NULL)
+				p, _world.lv2_InputPort, _world.ev_EventPort, NULL)
 			+ count_midi_in);
 
 		info->n_outputs.set_audio(
 			lilv_plugin_get_num_ports_of_class(
-				p, world.lv2_OutputPort, world.lv2_AudioPort, NULL));
+				p, _world.lv2_OutputPort, _world.lv2_AudioPort, NULL));
 		info->n_outputs.set_midi(
 			lilv_plugin_get_num_ports_of_class(
-				p, world.lv2_OutputPort, world.ev_EventPort, NULL)
+				p, _world.lv2_OutputPort, _world.ev_EventPort, NULL)
 			+ count_midi_out);
 
 		info->unique_id = lilv_node_as_uri(lilv_plugin_get_uri(p));
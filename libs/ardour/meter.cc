@@ -157,24 +157,33 @@ PeakMeter::run (BufferSet& bufs, framepos_t /*start_frame*/, framepos_t /*end_fr
 			} else {
 				_peak_power[n] = -std::numeric_limits<float>::infinity();
 			}
-			_peak_power[n] = max(_peak_power[n], accurate_coefficient_to_dB(_peak_buffer[n]));
+			if (_peak_buffer[n] > 0) {
+				/* a zero peak is -inf dB, which can never raise the meter */
+				_peak_power[n] = max(_peak_power[n], accurate_coefficient_to_dB(_peak_buffer[n]));
+			}
 			// integration buffer, retain peaks > 49Hz
 			if (_bufcnt > zoh) {
 				_peak_buffer[n] = 0;
 			}
 		}
 
+		_meter_bufs[i] = bufs.get_audio(i).data();
+	}
+
+	/* ballistic meters process all channels together, several at a time */
+
+	if (n_audio > 0) {
 		if (_meter_type & (MeterKrms | MeterK20 | MeterK14 | MeterK12)) {
-			_kmeter[i]->process(bufs.get_audio(i).data(), nframes);
+			Kmeterdsp::process (&_kmeter[0], &_meter_bufs[0], n_audio, nframes);
 		}
 		if (_meter_type & (MeterIEC1DIN | MeterIEC1NOR)) {
-			_iec1meter[i]->process(bufs.get_audio(i).data(), nframes);
+			Iec1ppmdsp::process (&_iec1meter[0], &_meter_bufs[0], n_audio, nframes);
 		}
 		if (_meter_type & (MeterIEC2BBC | MeterIEC2EBU)) {
-			_iec2meter[i]->process(bufs.get_audio(i).data(), nframes);
+			Iec2ppmdsp::process (&_iec2meter[0], &_meter_bufs[0], n_audio, nframes);
 		}
 		if (_meter_type & MeterVU) {
-			_vumeter[i]->process(bufs.get_audio(i).data(), nframes);
+			Vumeterdsp::process (&_vumeter[0], &_meter_bufs[0], n_audio, nframes);
 		}
 	}
 
@@ -304,6 +313,8 @@ PeakMeter::set_max_channels (const ChanCount& chn)
 	assert(_iec2meter.size() == n_audio);
 	assert(_vumeter.size() == n_audio);
 
+	_meter_bufs.resize (n_audio);
+
 	reset();
 	reset_max();
 }
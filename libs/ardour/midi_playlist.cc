@@ -347,6 +347,7 @@ MidiPlaylist::destroy_region (boost::shared_ptr<Region> region)
 
 			if ((*i) == region) {
 				regions.erase (i);
+				invalidate_region_index ();
 				changed = true;
 			}
 
@@ -60,9 +60,8 @@ PBD::Signal1<void,MidiSource*> MidiSource::MidiSourceCreated;
 MidiSource::MidiSource (Session& s, string name, Source::Flag flags)
 	: Source(s, DataType::MIDI, name, flags)
 	, _writing(false)
-	, _model_iter_valid(false)
+	, _model_cursor_clock(0)
 	, _length_beats(0.0)
-	, _last_read_end(0)
 	, _capture_length(0)
 	, _capture_loop_length(0)
 {
@@ -71,9 +70,8 @@ MidiSource::MidiSource (Session& s, string name, Source::Flag flags)
 MidiSource::MidiSource (Session& s, const XMLNode& node)
 	: Source(s, node)
 	, _writing(false)
-	, _model_iter_valid(false)
+	, _model_cursor_clock(0)
 	, _length_beats(0.0)
-	, _last_read_end(0)
 	, _capture_length(0)
 	, _capture_loop_length(0)
 {
@@ -180,8 +178,15 @@ MidiSource::update_length (framecnt_t)
 void
 MidiSource::invalidate (const Lock& lock, std::set<Evoral::Sequence<Evoral::Beats>::WeakNotePtr>* notes)
 {
-	_model_iter_valid = false;
-	_model_iter.invalidate(notes);
+	for (size_t n = 0; n < max_model_cursors; ++n) {
+		_model_cursors[n].valid = false;
+		_model_cursors[n].iter.invalidate(notes);
+	}
+
+	/* notes may have been moved or resized in place */
+	if (_model) {
+		_model->invalidate_note_index();
+	}
 }
 
 framecnt_t
@@ -201,62 +206,44 @@ MidiSource::midi_read (const Lock&                        lm,
 	                             source_start, start, cnt, tracker, name()));
 
 	if (_model) {
-		// Find appropriate model iterator
-		Evoral::Sequence<Evoral::Beats>::const_iterator& i = _model_iter;
-		const bool linear_read = _last_read_end != 0 && start == _last_read_end;
-		if (!linear_read || !_model_iter_valid) {
-#if 0
-			// Cached iterator is invalid, search for the first event past start
-			i = _model->begin(converter.from(start), false, filtered,
-			                  linear_read ? &_model->active_notes() : NULL);
-			_model_iter_valid = true;
-			if (!linear_read) {
-				_model->active_notes().clear();
+		// Find the cursor which this read carries on from, if any
+		ModelCursor* c   = 0;
+		ModelCursor* lru = &_model_cursors[0];
+		for (size_t n = 0; n < max_model_cursors; ++n) {
+			ModelCursor& m = _model_cursors[n];
+			if (m.valid && m.source_start == source_start && m.read_end == start) {
+				c = &m;
+				break;
+			}
+			if (lru->valid && (!m.valid || m.last_used < lru->last_used)) {
+				lru = &m;
 			}
-#else
-			/* hot-fix http://tracker.ardour.org/view.php?id=6541
-			 * "parallel playback of linked midi regions -> no note-offs"
-			 *
-			 * A midi source can be used by multiple tracks simultaneously,
-			 * in which case midi_read() may be called from different tracks for
-			 * overlapping time-ranges.
-			 *
-			 * However there is only a single iterator for a given midi-source.
-			 * This results in every midi_read() performing a seek.
-			 *
-			 * If seeking is performed with
-			 *    _model->begin(converter.from(start),...)
-			 * the model is used for seeking. That method seeks to the first
-			 * *note-on* event after 'start'.
-			 *
-			 * _model->begin(converter.from(  ) ,..) eventually calls
-			 * Sequence<Time>::const_iterator() in libs/evoral/src/Sequence.cpp
-			 * which looks up the note-event via seq.note_lower_bound(t);
-			 * but the sequence 'seq' only contains note-on events(!).
-			 * note-off events are implicit in Sequence<Time>::operator++()
-			 * via _active_notes.pop(); and not part of seq.
-			 *
-			 * see also http://tracker.ardour.org/view.php?id=6287#c16671
-			 *
-			 * The linear search below assures that reading starts at the first
-			 * event for the given time, regardless of its event-type.
-			 *
-			 * The performance of this approach is O(N), while the previous
-			 * implementation is O(log(N)). This needs to be optimized:
-			 * The model-iterator or event-sequence needs to be re-designed in
-			 * some way (maybe keep an iterator per playlist).
+		}
+
+		if (!c) {
+			/* Seek to the first event of any type at or after start.  This
+			 * includes note-offs for notes which started earlier, so that
+			 * regions sharing this source all see them.
 			 */
-			for (i = _model->begin(); i != _model->end(); ++i) {
-				const framecnt_t time_frames = converter.to(i->time());
-				if (time_frames >= start) {
-					break;
-				}
+			c = lru;
+			c->iter         = _model->seek(converter.from(start), false, filtered);
+			c->valid        = true;
+			c->source_start = source_start;
+
+			DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("%1: seek to %2\n", _name, start));
+		}
+
+		Evoral::Sequence<Evoral::Beats>::const_iterator& i = c->iter;
+
+		// Rounding between beats and frames may leave us just short of start
+		for (; i != _model->end(); ++i) {
+			if (converter.to(i->time()) >= start) {
+				break;
 			}
-			_model_iter_valid = true;
-#endif
 		}
 
-		_last_read_end = start + cnt;
+		c->read_end  = start + cnt;
+		c->last_used = ++_model_cursor_clock;
 
 		// Copy events in [start, start + cnt) into dst
 		for (; i != _model->end(); ++i) {
@@ -301,7 +288,6 @@ MidiSource::midi_write (const Lock&                 lm,
 	const framecnt_t ret = write_unlocked (lm, source, source_start, cnt);
 
 	if (cnt == max_framecnt) {
-		_last_read_end = 0;
 		invalidate(lm);
 	} else {
 		_capture_length += cnt;
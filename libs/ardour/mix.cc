@@ -142,6 +142,95 @@ default_copy_vector (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t
 	memcpy(dst, src, nframes*sizeof(ARDOUR::Sample));
 }
 
+/* The meter kernels below must produce exactly the same results as the
+ * single-channel loops in Kmeterdsp, Iec1ppmdsp, Iec2ppmdsp and Vumeterdsp,
+ * which only evaluate complete groups of four samples.
+ */
+
+void
+default_kmeter_process (const ARDOUR::Sample * const * bufs, uint32_t n_channels, pframes_t nframes, float omega, float *z1, float *z2)
+{
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		const ARDOUR::Sample * p = bufs[c];
+		float s;
+		float a = z1[c];
+		float b = z2[c];
+
+		for (pframes_t n = nframes / 4; n > 0; --n) {
+			s = *p++;
+			s *= s;
+			a += omega * (s - a);
+			s = *p++;
+			s *= s;
+			a += omega * (s - a);
+			s = *p++;
+			s *= s;
+			a += omega * (s - a);
+			s = *p++;
+			s *= s;
+			a += omega * (s - a);
+			b += 4 * omega * (a - b);
+		}
+
+		z1[c] = a;
+		z2[c] = b;
+	}
+}
+
+void
+default_ppm_process (const ARDOUR::Sample * const * bufs, uint32_t n_channels, pframes_t nframes, float w1, float w2, float w3, float *z1, float *z2, float *m)
+{
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		const ARDOUR::Sample * p = bufs[c];
+		float t;
+		float a = z1[c];
+		float b = z2[c];
+		float mx = m[c];
+
+		for (pframes_t n = nframes / 4; n > 0; --n) {
+			a *= w3;
+			b *= w3;
+			for (int i = 0; i < 4; ++i) {
+				t = fabsf (*p++);
+				if (t > a) a += w1 * (t - a);
+				if (t > b) b += w2 * (t - b);
+			}
+			t = a + b;
+			if (t > mx) mx = t;
+		}
+
+		z1[c] = a;
+		z2[c] = b;
+		m[c] = mx;
+	}
+}
+
+void
+default_vumeter_process (const ARDOUR::Sample * const * bufs, uint32_t n_channels, pframes_t nframes, float w, float *z1, float *z2, float *m)
+{
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		const ARDOUR::Sample * p = bufs[c];
+		float t1, t2;
+		float a = z1[c];
+		float b = z2[c];
+		float mx = m[c];
+
+		for (pframes_t n = nframes / 4; n > 0; --n) {
+			t2 = b / 2;
+			for (int i = 0; i < 4; ++i) {
+				t1 = fabsf (*p++) - t2;
+				a += w * (t1 - a);
+			}
+			b += 4 * w * (a - b);
+			if (b > mx) mx = b;
+		}
+
+		z1[c] = a;
+		z2[c] = b;
+		m[c] = mx;
+	}
+}
+
 #if defined (__APPLE__) && defined (BUILD_VECLIB_OPTIMIZATIONS)
 #include <Accelerate/Accelerate.h>
 
@@ -751,6 +751,7 @@ Playlist::flush_notifications (bool from_undo)
 
 	 regions.insert (upper_bound (regions.begin(), regions.end(), region, cmp), region);
 	 all_regions.insert (region);
+	 invalidate_region_index ();
 
 	 possibly_splice_unlocked (position, region->length(), region);
 
@@ -811,6 +812,7 @@ Playlist::flush_notifications (bool from_undo)
 			 framecnt_t distance = (*i)->length();
 
 			 regions.erase (i);
+			 invalidate_region_index ();
 
 			 possibly_splice_unlocked (pos, -distance);
 
@@ -1566,6 +1568,8 @@ Playlist::core_ripple (framepos_t at, framecnt_t distance, RegionList *exclude)
 void
 Playlist::region_bounds_changed (const PropertyChange& what_changed, boost::shared_ptr<Region> region)
 {
+	 invalidate_region_index ();
+
 	 if (in_set_state || _splicing || _rippling || _nudging || _shuffling) {
 		 return;
 	 }
@@ -1630,6 +1634,13 @@ Playlist::region_bounds_changed (const PropertyChange& what_changed, boost::shar
 		 return;
 	 }
 
+	 if (what_changed.contains (Properties::position) ||
+	     what_changed.contains (Properties::length) ||
+	     what_changed.contains (Properties::layer)) {
+		 /* do this here, since region_changed() may ignore the change */
+		 invalidate_region_index ();
+	 }
+
 	 /* this makes a virtual call to the right kind of playlist ... */
 
 	 region_changed (what_changed, region);
@@ -1690,6 +1701,7 @@ Playlist::region_bounds_changed (const PropertyChange& what_changed, boost::shar
 	 RegionWriteLock rl (this);
 	 regions.clear ();
 	 all_regions.clear ();
+	 invalidate_region_index ();
  }
 
  void
@@ -1717,6 +1729,7 @@ Playlist::region_bounds_changed (const PropertyChange& what_changed, boost::shar
 		 }
 
 		 regions.clear ();
+		 invalidate_region_index ();
 
 		 for (set<boost::shared_ptr<Region> >::iterator s = pending_removes.begin(); s != pending_removes.end(); ++s) {
 			 remove_dependents (*s);
@@ -1740,6 +1753,225 @@ Playlist::region_bounds_changed (const PropertyChange& what_changed, boost::shar
   FINDING THINGS
   **********************************************************************/
 
+/** An index of a playlist's regions for finding those which overlap a range.
+ *
+ *  The regions are held twice: once sorted by position, and once sorted by
+ *  descending layer and then by position (the order in which they must be
+ *  read).  Each of these arrays (or for the second, each layer's part of it)
+ *  is treated as an implicit balanced binary tree, with the entry in the
+ *  middle of any part of the array holding the greatest last frame of that
+ *  part.  This finds the M regions touching a range in O(log N + M) time,
+ *  in either order, without any sorting.
+ *
+ *  An index is never modified once it has been built; the playlist drops it
+ *  when its regions change and builds a new one when it is next needed.
+ */
+class Playlist::RegionIndex
+{
+  public:
+	RegionIndex (RegionListProperty const &);
+
+	void touched (framepos_t start, framepos_t end, vector<boost::shared_ptr<Region> >&, bool read_order) const;
+	boost::shared_ptr<Region> next_start (framepos_t frame, int dir) const;
+
+  private:
+	struct Entry {
+		Entry (boost::shared_ptr<Region> r)
+			: first (r->first_frame ())
+			, last (r->last_frame ())
+			, max_last (last)
+			, layer (r->layer ())
+			, region (r) {}
+
+		framepos_t first;
+		framepos_t last;
+		framepos_t max_last; ///< greatest `last' of the subtree rooted at this entry
+		layer_t    layer;
+		boost::shared_ptr<Region> region;
+	};
+
+	typedef vector<Entry> Entries;
+
+	Entries        _by_position;
+	Entries        _by_layer;
+	vector<size_t> _layer_ends; ///< index in _by_layer of the end of each layer's entries
+
+	static bool position_less (Entry const & a, Entry const & b) {
+		return a.first < b.first;
+	}
+
+	/* descending layer and then ascending position; see AudioPlaylist::read() */
+	static bool read_less (Entry const & a, Entry const & b) {
+		if (a.layer != b.layer) {
+			return a.layer > b.layer;
+		}
+		return a.first < b.first;
+	}
+
+	static bool starts_before (Entry const & e, framepos_t f) {
+		return e.first < f;
+	}
+
+	static bool starts_after (framepos_t f, Entry const & e) {
+		return f < e.first;
+	}
+
+	static framepos_t build (Entries&, size_t lo, size_t hi);
+	static void search (Entries const &, size_t lo, size_t hi, framepos_t start, framepos_t end, vector<boost::shared_ptr<Region> >&);
+};
+
+Playlist::RegionIndex::RegionIndex (RegionListProperty const & regions)
+{
+	_by_position.reserve (regions.size ());
+
+	for (RegionList::const_iterator i = regions.begin(); i != regions.end(); ++i) {
+		_by_position.push_back (Entry (*i));
+	}
+
+	/* the region list is kept in position order, but it may lag behind
+	   regions which are being moved while the playlist is frozen; a stable
+	   sort keeps regions which start together in list order.
+	*/
+	stable_sort (_by_position.begin(), _by_position.end(), position_less);
+
+	_by_layer = _by_position;
+	stable_sort (_by_layer.begin(), _by_layer.end(), read_less);
+
+	build (_by_position, 0, _by_position.size ());
+
+	size_t lo = 0;
+	while (lo < _by_layer.size ()) {
+		size_t hi = lo + 1;
+		while (hi < _by_layer.size () && _by_layer[hi].layer == _by_layer[lo].layer) {
+			++hi;
+		}
+		build (_by_layer, lo, hi);
+		_layer_ends.push_back (hi);
+		lo = hi;
+	}
+}
+
+/** Set up max_last for the tree over entries [lo, hi).
+ *  @return greatest last frame of those entries.
+ */
+framepos_t
+Playlist::RegionIndex::build (Entries& e, size_t lo, size_t hi)
+{
+	if (lo >= hi) {
+		return INT64_MIN;
+	}
+
+	size_t const mid = lo + (hi - lo) / 2;
+
+	framepos_t m = e[mid].last;
+	m = max (m, build (e, lo, mid));
+	m = max (m, build (e, mid + 1, hi));
+	e[mid].max_last = m;
+
+	return m;
+}
+
+/** Append the regions among entries [lo, hi) which overlap start...end (inclusive)
+ *  to @param out, in the order of the entries.
+ */
+void
+Playlist::RegionIndex::search (Entries const & e, size_t lo, size_t hi, framepos_t start, framepos_t end, vector<boost::shared_ptr<Region> >& out)
+{
+	if (lo >= hi) {
+		return;
+	}
+
+	size_t const mid = lo + (hi - lo) / 2;
+	Entry const & n (e[mid]);
+
+	if (n.max_last < start) {
+		/* nothing in this subtree reaches the range */
+		return;
+	}
+
+	search (e, lo, mid, start, end, out);
+
+	if (n.first > end) {
+		/* this entry, and everything after it, starts after the range */
+		return;
+	}
+
+	if (n.last >= start && n.region->coverage (start, end) != Evoral::OverlapNone) {
+		out.push_back (n.region);
+	}
+
+	search (e, mid + 1, hi, start, end, out);
+}
+
+void
+Playlist::RegionIndex::touched (framepos_t start, framepos_t end, vector<boost::shared_ptr<Region> >& out, bool read_order) const
+{
+	if (!read_order) {
+		search (_by_position, 0, _by_position.size (), start, end, out);
+		return;
+	}
+
+	size_t lo = 0;
+	for (vector<size_t>::const_iterator i = _layer_ends.begin(); i != _layer_ends.end(); ++i) {
+		search (_by_layer, lo, *i, start, end, out);
+		lo = *i;
+	}
+}
+
+/** @return the first region (in position order) to start after @param frame if @param dir > 0,
+ *  otherwise the first region to start at the latest position before @param frame.
+ */
+boost::shared_ptr<Region>
+Playlist::RegionIndex::next_start (framepos_t frame, int dir) const
+{
+	Entries::const_iterator i;
+
+	if (dir > 0) {
+		i = upper_bound (_by_position.begin(), _by_position.end(), frame, starts_after);
+		if (i == _by_position.end ()) {
+			return boost::shared_ptr<Region> ();
+		}
+		return i->region;
+	}
+
+	i = lower_bound (_by_position.begin(), _by_position.end(), frame, starts_before);
+	if (i == _by_position.begin ()) {
+		return boost::shared_ptr<Region> ();
+	}
+
+	--i;
+	while (i != _by_position.begin() && (i - 1)->first == i->first) {
+		--i;
+	}
+
+	return i->region;
+}
+
+/** Drop our region index, so that it is rebuilt next time it is used;
+ *  this must be called whenever `regions' or the position, length or
+ *  layer of any of them changes.
+ */
+void
+Playlist::invalidate_region_index ()
+{
+	Glib::Threads::Mutex::Lock lm (_region_index_lock);
+	_region_index.reset ();
+}
+
+boost::shared_ptr<Playlist::RegionIndex const>
+Playlist::region_index ()
+{
+	/* Caller must hold lock */
+
+	Glib::Threads::Mutex::Lock lm (_region_index_lock);
+
+	if (!_region_index) {
+		_region_index.reset (new RegionIndex (regions));
+	}
+
+	return _region_index;
+}
+
 boost::shared_ptr<RegionList>
 Playlist::regions_at (framepos_t frame)
 {
@@ -1814,15 +2046,7 @@ Playlist::find_regions_at (framepos_t frame)
 {
 	/* Caller must hold lock */
 
-	boost::shared_ptr<RegionList> rlist (new RegionList);
-
-	for (RegionList::iterator i = regions.begin(); i != regions.end(); ++i) {
-		if ((*i)->covers (frame)) {
-			rlist->push_back (*i);
-		}
-	}
-
-	return rlist;
+	return regions_touched_locked (frame, frame);
 }
 
 boost::shared_ptr<RegionList>
@@ -1869,15 +2093,20 @@ Playlist::regions_touched (framepos_t start, framepos_t end)
 boost::shared_ptr<RegionList>
 Playlist::regions_touched_locked (framepos_t start, framepos_t end)
 {
-	boost::shared_ptr<RegionList> rlist (new RegionList);
-
-	for (RegionList::iterator i = regions.begin(); i != regions.end(); ++i) {
-		if ((*i)->coverage (start, end) != Evoral::OverlapNone) {
-			rlist->push_back (*i);
-		}
-	}
+	vector<boost::shared_ptr<Region> > touched;
+	regions_touched_locked (start, end, touched, false);
+	return boost::shared_ptr<RegionList> (new RegionList (touched.begin(), touched.end()));
+}
 
-	return rlist;
+/** Append the regions which have some part within start...end to a vector.
+ *  Caller must hold lock.
+ *  @param read_order true to give the regions in descending layer and then
+ *  ascending position order, false for ascending position order.
+ */
+void
+Playlist::regions_touched_locked (framepos_t start, framepos_t end, vector<boost::shared_ptr<Region> >& out, bool read_order)
+{
+	region_index()->touched (start, end, out, read_order);
 }
 
 framepos_t
@@ -1944,6 +2173,13 @@ boost::shared_ptr<Region>
 Playlist::find_next_region (framepos_t frame, RegionPoint point, int dir)
 {
 	RegionReadLock rlock (this);
+
+	if (point == Start) {
+		return region_index()->next_start (frame, dir);
+	}
+
+	/* region ends and sync points are not indexed */
+
 	boost::shared_ptr<Region> ret;
 	framepos_t closest = max_framepos;
 
@@ -2523,6 +2759,9 @@ Playlist::relayer ()
 		(*i)->set_layer (j);
 	}
 
+	/* Region::set_layer() does not signal a change, so the index will not have heard */
+	invalidate_region_index ();
+
 	/* It's a little tricky to know when we could avoid calling this; e.g. if we are
 	   relayering because we just removed the only region on the top layer, nothing will
 	   appear to have changed, but the StreamView must still sort itself out.  We could
@@ -2775,6 +3014,7 @@ Playlist::shuffle (boost::shared_ptr<Region> region, int dir)
 						regions.erase (i); // removes the region from the list */
 						next++;
 						regions.insert (next, region); // adds it back after next
+						invalidate_region_index ();
 
 						moved = true;
 					}
@@ -2815,6 +3055,7 @@ Playlist::shuffle (boost::shared_ptr<Region> region, int dir)
 
 						regions.erase (i); // remove region
 						regions.insert (prev, region); // insert region before prev
+						invalidate_region_index ();
 
 						moved = true;
 					}
@@ -32,6 +32,7 @@
 #include "ardour/buffer_set.h"
 #include "ardour/debug.h"
 #include "ardour/event_type_map.h"
+#include "ardour/graph.h"
 #include "ardour/ladspa_plugin.h"
 #include "ardour/plugin.h"
 #include "ardour/plugin_insert.h"
@@ -52,6 +53,7 @@
 #include "ardour/audio_unit.h"
 #endif
 
+#include "ardour/rc_configuration.h"
 #include "ardour/session.h"
 #include "ardour/types.h"
 
@@ -107,6 +109,7 @@ PluginInsert::set_count (uint32_t num)
 		for (uint32_t n= 0; n < diff; ++n) {
 			_plugins.pop_back();
 		}
+		reset_instance_nodes ();
 	}
 
 	return true;
@@ -114,6 +117,9 @@ PluginInsert::set_count (uint32_t num)
 
 PluginInsert::~PluginInsert ()
 {
+	for (vector<GraphSubNode*>::iterator i = _instance_nodes.begin(); i != _instance_nodes.end(); ++i) {
+		delete *i;
+	}
 }
 
 void
@@ -438,11 +444,35 @@ PluginInsert::connect_and_run (BufferSet& bufs, pframes_t nframes, framecnt_t of
 
 	}
 
-	for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
-		(*i)->connect_and_run(bufs, in_map, out_map, nframes, offset);
-		for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
-			in_map.offset_to(*t, natural_input_streams().get(*t));
-			out_map.offset_to(*t, natural_output_streams().get(*t));
+	if (can_run_instances_in_parallel (bufs)) {
+
+		/* each instance works on its own set of channels, so they
+		   can all run at the same time.
+		*/
+
+		for (vector<GraphSubNode*>::iterator i = _instance_nodes.begin(); i != _instance_nodes.end(); ++i) {
+			InstanceNode* in = static_cast<InstanceNode*> (*i);
+			in->bufs = &bufs;
+			in->in_map = in_map;
+			in->out_map = out_map;
+			in->nframes = nframes;
+			in->offset = offset;
+			for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
+				in_map.offset_to(*t, natural_input_streams().get(*t));
+				out_map.offset_to(*t, natural_output_streams().get(*t));
+			}
+		}
+
+		_session.process_graph()->run_sub_nodes (&_instance_nodes[0], _instance_nodes.size());
+
+	} else {
+
+		for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
+			(*i)->connect_and_run(bufs, in_map, out_map, nframes, offset);
+			for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
+				in_map.offset_to(*t, natural_input_streams().get(*t));
+				out_map.offset_to(*t, natural_output_streams().get(*t));
+			}
 		}
 	}
 
@@ -1523,6 +1553,47 @@ PluginInsert::add_plugin (boost::shared_ptr<Plugin> plugin)
 	}
 
 	_plugins.push_back (plugin);
+	reset_instance_nodes ();
+}
+
+void
+PluginInsert::reset_instance_nodes ()
+{
+	for (vector<GraphSubNode*>::iterator i = _instance_nodes.begin(); i != _instance_nodes.end(); ++i) {
+		delete *i;
+	}
+
+	_instance_nodes.clear ();
+
+	for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
+		_instance_nodes.push_back (new InstanceNode (*i));
+	}
+}
+
+/** @return true if our plugin instances may be run on different DSP threads
+ *  during this cycle.
+ */
+bool
+PluginInsert::can_run_instances_in_parallel (BufferSet const & bufs) const
+{
+	if (_plugins.size() < 2 || !Config->get_parallel_plugin_instances ()) {
+		return false;
+	}
+
+	if (!_session.process_graph ()) {
+		return false;
+	}
+
+	/* Plugin::connect_and_run() tracks (and may add to) the first MIDI
+	   buffer, which all instances would share.
+	*/
+	return bufs.count().n_midi() == 0 && _match.method == Replicate;
+}
+
+void
+PluginInsert::InstanceNode::process ()
+{
+	plugin->connect_and_run (*bufs, in_map, out_map, nframes, offset);
 }
 
 void
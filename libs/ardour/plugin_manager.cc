@@ -62,6 +62,8 @@
 
 #include "pbd/whitespace.h"
 #include "pbd/file_utils.h"
+#include "pbd/convert.h"
+#include "pbd/xml++.h"
 
 #include "ardour/debug.h"
 #include "ardour/filesystem_paths.h"
@@ -101,6 +103,8 @@ using namespace ARDOUR;
 using namespace PBD;
 using namespace std;
 
+#define LADSPA_CACHE "ladspa_cache.xml"
+
 PluginManager* PluginManager::_instance = 0;
 std::string PluginManager::scanner_bin_path = "";
 
@@ -429,6 +433,14 @@ PluginManager::clear_vst_blacklist ()
 			::g_unlink (fn.c_str());
 		}
 	}
+	{
+		string dn = Glib::build_filename (ARDOUR::user_cache_directory(), "vst");
+		vector<string> fsb_files;
+		find_files_matching_regex (fsb_files, dn, "\\" VST_EXT_BLACKLIST "$", /* user cache is flat, no recursion */ false);
+		for (vector<string>::iterator i = fsb_files.begin(); i != fsb_files.end (); ++i) {
+			::g_unlink(i->c_str());
+		}
+	}
 #endif
 
 }
@@ -479,12 +491,139 @@ PluginManager::ladspa_refresh ()
 	find_files_matching_pattern (ladspa_modules, ladspa_search_path (), "*.dylib");
 	find_files_matching_pattern (ladspa_modules, ladspa_search_path (), "*.dll");
 
+	/* modules that have not changed since the last scan are not loaded
+	 * again; what they contain is taken from the cache.
+	 */
+
+	string const cache_path = Glib::build_filename (ARDOUR::user_cache_directory(), LADSPA_CACHE);
+	XMLTree cache;
+	map<string, XMLNode*> cached_modules;
+
+	if (Glib::file_test (cache_path, Glib::FILE_TEST_EXISTS) && cache.read (cache_path) && cache.root()) {
+		XMLNodeList const & children (cache.root()->children (X_("Module")));
+		for (XMLNodeConstIterator i = children.begin(); i != children.end(); ++i) {
+			XMLProperty const * prop = (*i)->property (X_("path"));
+			if (prop) {
+				cached_modules[prop->value()] = *i;
+			}
+		}
+	}
+
+	XMLNode* new_cache = new XMLNode (X_("LADSPACache"));
+
 	for (vector<std::string>::iterator i = ladspa_modules.begin(); i != ladspa_modules.end(); ++i) {
-		ARDOUR::PluginScanMessage(_("LADSPA"), *i, false);
-		ladspa_discover (*i);
+
+		GStatBuf statbuf;
+		if (g_stat (i->c_str(), &statbuf) != 0) {
+			continue;
+		}
+
+		string const mtime = PBD::to_string (statbuf.st_mtime, std::dec);
+		PluginInfoList found;
+
+		map<string, XMLNode*>::const_iterator c = cached_modules.find (*i);
+		XMLProperty const * prop;
+
+		if (c != cached_modules.end() && (prop = c->second->property (X_("mtime"))) != 0 && prop->value() == mtime) {
+			DEBUG_TRACE (DEBUG::PluginManager, string_compose ("LADSPA: using cache for %1\n", *i));
+			XMLNodeList const & plugins (c->second->children (X_("Plugin")));
+			for (XMLNodeConstIterator p = plugins.begin(); p != plugins.end(); ++p) {
+				PluginInfoPtr info = ladspa_info_from_state (**p, *i);
+				if (info) {
+					found.push_back (info);
+				}
+			}
+		} else {
+			ARDOUR::PluginScanMessage(_("LADSPA"), *i, false);
+			if (ladspa_discover (*i, found)) {
+				continue;
+			}
+		}
+
+		XMLNode* module = new XMLNode (X_("Module"));
+		module->add_property (X_("path"), *i);
+		module->add_property (X_("mtime"), mtime);
+
+		for (PluginInfoList::const_iterator p = found.begin(); p != found.end(); ++p) {
+			module->add_child_nocopy (ladspa_info_state (**p));
+			add_ladspa_plugin_info (*p);
+		}
+
+		new_cache->add_child_nocopy (*module);
+	}
+
+	XMLTree tree;
+	tree.set_root (new_cache);
+	if (!tree.write (cache_path)) {
+		warning << string_compose (_("Could not write LADSPA plugin cache to %1"), cache_path) << endmsg;
 	}
 }
 
+XMLNode&
+PluginManager::ladspa_info_state (PluginInfo const & info) const
+{
+	XMLNode* node = new XMLNode (X_("Plugin"));
+	node->add_property (X_("index"), PBD::to_string (info.index, std::dec));
+	node->add_property (X_("unique-id"), info.unique_id);
+	node->add_property (X_("name"), info.name);
+	node->add_property (X_("creator"), info.creator);
+	node->add_property (X_("inputs"), PBD::to_string (info.n_inputs.n_audio(), std::dec));
+	node->add_property (X_("outputs"), PBD::to_string (info.n_outputs.n_audio(), std::dec));
+	return *node;
+}
+
+PluginInfoPtr
+PluginManager::ladspa_info_from_state (XMLNode const & node, string const & path)
+{
+	XMLProperty const * index = node.property (X_("index"));
+	XMLProperty const * unique_id = node.property (X_("unique-id"));
+	XMLProperty const * name = node.property (X_("name"));
+	XMLProperty const * creator = node.property (X_("creator"));
+	XMLProperty const * inputs = node.property (X_("inputs"));
+	XMLProperty const * outputs = node.property (X_("outputs"));
+
+	if (!index || !unique_id || !name || !creator || !inputs || !outputs) {
+		return PluginInfoPtr ();
+	}
+
+	PluginInfoPtr info (new LadspaPluginInfo);
+	info->name = name->value();
+	/* the category comes from RDF data, which may have changed */
+	info->category = get_ladspa_category (atoi (unique_id->value().c_str()));
+	info->creator = creator->value();
+	info->path = path;
+	info->index = atoi (index->value().c_str());
+	info->n_inputs = ChanCount (DataType::AUDIO, atoi (inputs->value().c_str()));
+	info->n_outputs = ChanCount (DataType::AUDIO, atoi (outputs->value().c_str()));
+	info->type = ARDOUR::LADSPA;
+	info->unique_id = unique_id->value();
+
+	return info;
+}
+
+void
+PluginManager::add_ladspa_plugin_info (PluginInfoPtr info)
+{
+	if (!ladspa_plugin_whitelist.empty()) {
+		uint32_t const id = strtoul (info->unique_id.c_str(), 0, 10);
+		if (find (ladspa_plugin_whitelist.begin(), ladspa_plugin_whitelist.end(), id) == ladspa_plugin_whitelist.end()) {
+			return;
+		}
+	}
+
+	//Ensure that the plugin is not already in the plugin list.
+
+	for (PluginInfoList::const_iterator i = _ladspa_plugin_info->begin(); i != _ladspa_plugin_info->end(); ++i) {
+		if (0 == info->unique_id.compare((*i)->unique_id)) {
+			return;
+		}
+	}
+
+	_ladspa_plugin_info->push_back (info);
+
+	DEBUG_TRACE (DEBUG::PluginManager, string_compose ("Found LADSPA plugin, name: %1, Inputs: %2, Outputs: %3\n", info->name, info->n_inputs, info->n_outputs));
+}
+
 #ifdef HAVE_LRDF
 static bool rdf_filter (const string &str, void* /*arg*/)
 {
@@ -559,7 +698,7 @@ PluginManager::add_lrdf_data (const string &path)
 }
 
 int
-PluginManager::ladspa_discover (string path)
+PluginManager::ladspa_discover (string path, PluginInfoList& found)
 {
 	DEBUG_TRACE (DEBUG::PluginManager, string_compose ("Checking for LADSPA plugin at %1\n", path));
 
@@ -590,12 +729,6 @@ PluginManager::ladspa_discover (string path)
 			break;
 		}
 
-		if (!ladspa_plugin_whitelist.empty()) {
-			if (find (ladspa_plugin_whitelist.begin(), ladspa_plugin_whitelist.end(), descriptor->UniqueID) == ladspa_plugin_whitelist.end()) {
-				continue;
-			}
-		}
-
 		PluginInfoPtr info(new LadspaPluginInfo);
 		info->name = descriptor->Name;
 		info->category = get_ladspa_category(descriptor->UniqueID);
@@ -621,25 +754,7 @@ PluginManager::ladspa_discover (string path)
 			}
 		}
 
-		if(_ladspa_plugin_info->empty()){
-			_ladspa_plugin_info->push_back (info);
-		}
-
-		//Ensure that the plugin is not already in the plugin list.
-
-		bool found = false;
-
-		for (PluginInfoList::const_iterator i = _ladspa_plugin_info->begin(); i != _ladspa_plugin_info->end(); ++i) {
-			if(0 == info->unique_id.compare((*i)->unique_id)){
-			      found = true;
-			}
-		}
-
-		if(!found){
-		    _ladspa_plugin_info->push_back (info);
-		}
-
-		DEBUG_TRACE (DEBUG::PluginManager, string_compose ("Found LADSPA plugin, name: %1, Inputs: %2, Outputs: %3\n", info->name, info->n_inputs, info->n_outputs));
+		found.push_back (info);
 	}
 
 // GDB WILL NOT LIKE YOU IF YOU DO THIS
@@ -780,7 +895,19 @@ PluginManager::windows_vst_discover_from_path (string path, bool cache_only)
 
 	find_files_matching_filter (plugin_objects, Config->get_plugin_path_vst(), windows_vst_filter, 0, false, true, true);
 
+	set<string> scanned;
+
+	if (!cache_only && !cancelled()) {
+		/* scan several plugins at once; the loop below then finds them in the cache */
+		vstfx_scan_with_app (plugin_objects, Config->get_plugin_scan_jobs(), scanned);
+	}
+
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x) {
+		if (scanned.find (*x) != scanned.end()) {
+			/* already scanned (or failed to) above, only read the result */
+			windows_vst_discover (*x, true);
+			continue;
+		}
 		ARDOUR::PluginScanMessage(_("VST"), *x, !cache_only && !cancelled());
 		windows_vst_discover (*x, cache_only || cancelled());
 	}
@@ -980,7 +1107,19 @@ PluginManager::lxvst_discover_from_path (string path, bool cache_only)
 
 	find_files_matching_filter (plugin_objects, Config->get_plugin_path_lxvst(), lxvst_filter, 0, false, true, true);
 
+	set<string> scanned;
+
+	if (!cache_only && !cancelled()) {
+		/* scan several plugins at once; the loop below then finds them in the cache */
+		vstfx_scan_with_app (plugin_objects, Config->get_plugin_scan_jobs(), scanned);
+	}
+
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x) {
+		if (scanned.find (*x) != scanned.end()) {
+			/* already scanned (or failed to) above, only read the result */
+			lxvst_discover (*x, true);
+			continue;
+		}
 		ARDOUR::PluginScanMessage(_("LXVST"), *x, !cache_only && !cancelled());
 		lxvst_discover (*x, cache_only || cancelled());
 	}
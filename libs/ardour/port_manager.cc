@@ -17,6 +17,8 @@
 
 */
 
+#include <algorithm>
+
 #include "pbd/convert.h"
 #include "pbd/error.h"
 
@@ -39,6 +41,7 @@ using std::vector;
 PortManager::PortManager ()
 	: ports (new Ports)
 	, _port_remove_in_progress (false)
+	, cycle_port_lists (new CyclePorts (ports.reader ()))
 {
 }
 
@@ -60,9 +63,16 @@ PortManager::remove_all_ports ()
 		ps->clear ();
 	}
 
+	{
+		RCUWriter<CyclePorts> writer (cycle_port_lists);
+		boost::shared_ptr<CyclePorts> cp = writer.get_copy ();
+		*cp = CyclePorts (ports.reader ());
+	}
+
 	/* clear dead wood list in RCU */
 
 	ports.flush ();
+	cycle_port_lists.flush ();
 
 	_port_remove_in_progress = false;
 }
@@ -231,15 +241,24 @@ PortManager::get_port_by_name (const string& portname)
 void
 PortManager::port_renamed (const std::string& old_relative_name, const std::string& new_relative_name)
 {
-	RCUWriter<Ports> writer (ports);
-	boost::shared_ptr<Ports> p = writer.get_copy();
-	Ports::iterator x = p->find (old_relative_name);
+	boost::shared_ptr<Port> port;
+
+	{
+		RCUWriter<Ports> writer (ports);
+		boost::shared_ptr<Ports> p = writer.get_copy();
+		Ports::iterator x = p->find (old_relative_name);
 
-	if (x != p->end()) {
-		boost::shared_ptr<Port> port = x->second;
+		if (x == p->end()) {
+			return;
+		}
+
+		port = x->second;
 		p->erase (x);
 		p->insert (make_pair (new_relative_name, port));
 	}
+
+	/* the per-cycle lists hold on to the port map, pick up the new one */
+	update_cycle_ports (port.get(), false);
 }
 
 int
@@ -314,12 +333,15 @@ PortManager::register_port (DataType dtype, const string& portname, bool input,
 			throw PortRegistrationFailure("unable to create port (unknown type)");
 		}
 
-		RCUWriter<Ports> writer (ports);
-		boost::shared_ptr<Ports> ps = writer.get_copy ();
-		ps->insert (make_pair (make_port_name_relative (portname), newport));
+		{
+			RCUWriter<Ports> writer (ports);
+			boost::shared_ptr<Ports> ps = writer.get_copy ();
+			ps->insert (make_pair (make_port_name_relative (portname), newport));
 
-		/* writer goes out of scope, forces update */
+			/* writer goes out of scope, forces update */
+		}
 
+		update_cycle_ports (newport.get(), false);
 	}
 
 	catch (PortRegistrationFailure& err) {
@@ -364,7 +386,10 @@ PortManager::unregister_port (boost::shared_ptr<Port> port)
 		/* writer goes out of scope, forces update */
 	}
 
+	update_cycle_ports (port.get(), true);
+
 	ports.flush ();
+	cycle_port_lists.flush ();
 
 	return 0;
 }
@@ -605,29 +630,101 @@ PortManager::cycle_start (pframes_t nframes)
 	Port::set_global_port_buffer_offset (0);
         Port::set_cycle_framecnt (nframes);
 
-	_cycle_ports = ports.reader ();
+	_cycle_lists = cycle_port_lists.reader ();
+	_cycle_ports = _cycle_lists->ports;
+
+	/* audio inputs only need their buffer offset resetting; everything
+	 * else gets its full cycle_start().
+	 */
+
+	for (vector<Port*>::const_iterator p = _cycle_lists->idle.begin(); p != _cycle_lists->idle.end(); ++p) {
+		(*p)->Port::cycle_start (nframes);
+	}
+
+	for (vector<AudioPort*>::const_iterator p = _cycle_lists->audio_outputs.begin(); p != _cycle_lists->audio_outputs.end(); ++p) {
+		(*p)->AudioPort::cycle_start (nframes);
+	}
 
-	for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
-		p->second->cycle_start (nframes);
+	for (vector<MidiPort*>::const_iterator p = _cycle_lists->midi_inputs.begin(); p != _cycle_lists->midi_inputs.end(); ++p) {
+		(*p)->cycle_start (nframes);
+	}
+
+	for (vector<MidiPort*>::const_iterator p = _cycle_lists->midi_outputs.begin(); p != _cycle_lists->midi_outputs.end(); ++p) {
+		(*p)->cycle_start (nframes);
 	}
 }
 
 void
 PortManager::cycle_end (pframes_t nframes)
 {
-	for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
-		p->second->cycle_end (nframes);
+	for (vector<AudioPort*>::const_iterator p = _cycle_lists->audio_outputs.begin(); p != _cycle_lists->audio_outputs.end(); ++p) {
+		(*p)->AudioPort::cycle_end (nframes);
+	}
+
+	for (vector<MidiPort*>::const_iterator p = _cycle_lists->midi_inputs.begin(); p != _cycle_lists->midi_inputs.end(); ++p) {
+		(*p)->cycle_end (nframes);
+	}
+
+	for (vector<MidiPort*>::const_iterator p = _cycle_lists->midi_outputs.begin(); p != _cycle_lists->midi_outputs.end(); ++p) {
+		(*p)->cycle_end (nframes);
 	}
 
-	for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
-		p->second->flush_buffers (nframes);
+	/* only MIDI ports have anything to flush */
+
+	for (vector<MidiPort*>::const_iterator p = _cycle_lists->midi_outputs.begin(); p != _cycle_lists->midi_outputs.end(); ++p) {
+		(*p)->flush_buffers (nframes);
 	}
 
 	_cycle_ports.reset ();
+	_cycle_lists.reset ();
 
 	/* we are done */
 }
 
+void
+PortManager::CyclePorts::add (Port* p)
+{
+	if (p->type() == DataType::AUDIO) {
+		if (p->sends_output()) {
+			audio_outputs.push_back (dynamic_cast<AudioPort*> (p));
+		} else {
+			idle.push_back (p);
+		}
+	} else if (p->type() == DataType::MIDI) {
+		if (p->sends_output()) {
+			midi_outputs.push_back (dynamic_cast<MidiPort*> (p));
+		} else {
+			midi_inputs.push_back (dynamic_cast<MidiPort*> (p));
+		}
+	}
+}
+
+void
+PortManager::CyclePorts::remove (Port* p)
+{
+	audio_outputs.erase (std::remove (audio_outputs.begin(), audio_outputs.end(), p), audio_outputs.end());
+	midi_inputs.erase (std::remove (midi_inputs.begin(), midi_inputs.end(), p), midi_inputs.end());
+	midi_outputs.erase (std::remove (midi_outputs.begin(), midi_outputs.end(), p), midi_outputs.end());
+	idle.erase (std::remove (idle.begin(), idle.end(), p), idle.end());
+}
+
+/** Bring the per-cycle port lists up to date with the port map, after
+ *  @param port has been registered, renamed or (if @param removed) unregistered.
+ */
+void
+PortManager::update_cycle_ports (Port* port, bool removed)
+{
+	RCUWriter<CyclePorts> writer (cycle_port_lists);
+	boost::shared_ptr<CyclePorts> cp = writer.get_copy ();
+
+	cp->ports = ports.reader ();
+	cp->remove (port);
+
+	if (!removed) {
+		cp->add (port);
+	}
+}
+
 void
 PortManager::silence (pframes_t nframes)
 {
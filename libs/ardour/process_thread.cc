@@ -200,3 +200,12 @@ ProcessThread::pan_automation_buffer()
         assert (p);
         return p;
 }
+
+uint32_t
+ProcessThread::thread_index ()
+{
+        ThreadBuffers* tb = _private_thread_buffers.get();
+        assert (tb);
+
+        return tb->index;
+}
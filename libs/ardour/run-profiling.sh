@@ -2,16 +2,20 @@
 #
 # Run libardour profiling tests.
 #
+# The profiling programs use the dummy backend, so no audio hardware
+# or running JACK server is needed.
+#
+# e.g. run-profiling.sh process_benchmark --tracks 64 --cycles 20000 --output results.json
+#
 
 if [ "$1" == "" ]; then
    echo "Syntax: run-profiling.sh [flag] <test> [<args>]"
    exit 1;
 fi
 
-. test-env.sh
-
-export LD_PRELOAD=/home/carl/src/libfakejack/libjack.so
-# session='32tracks'
+TOP=`dirname "$0"`/../..
+. $TOP/build/gtk2_ardour/ardev_common_waf.sh
+ARDOUR_LIBS_DIR=$TOP/build/libs/ardour
 
 p=$1
 if [ "$p" == "--debug" -o "$p" == "--valgrind" -o "$p" == "--callgrind" ]; then
@@ -22,11 +26,11 @@ fi
 shift 1
 
 if [ "$f" == "--debug" ]; then
-        gdb --args ./libs/ardour/$p $*
+        gdb --args $ARDOUR_LIBS_DIR/$p "$@"
 elif [ "$f" == "--valgrind" ]; then
-        valgrind ./libs/ardour/$p $*
+        valgrind $ARDOUR_LIBS_DIR/$p "$@"
 elif [ "$f" == "--callgrind" ]; then
-        valgrind --tool=callgrind ./libs/ardour/$p $*
+        valgrind --tool=callgrind $ARDOUR_LIBS_DIR/$p "$@"
 else
-        ./libs/ardour/$p $*
+        $ARDOUR_LIBS_DIR/$p "$@"
 fi
@@ -260,6 +260,7 @@ Session::Session (AudioEngine &eng,
 	, midi_control_ui (0)
 	, _tempo_map (0)
 	, _all_route_group (new RouteGroup (*this, "all"))
+	, _process_pass (0)
 	, routes (new RouteList)
 	, _adding_routes_in_progress (false)
 	, _reconnecting_routes_in_progress (false)
@@ -4296,7 +4297,7 @@ Session::add_source (boost::shared_ptr<Source> source)
 
 		if ((afs = boost::dynamic_pointer_cast<AudioFileSource>(source)) != 0) {
 			if (Config->get_auto_analyse_audio()) {
-				Analyser::queue_source_for_analysis (source, false);
+				Analyser::queue_source_for_analysis (source, false, Analyser::Background);
 			}
 		}
 
@@ -4326,6 +4327,9 @@ Session::remove_source (boost::weak_ptr<Source> src)
 		}
 	}
 
+	/* no point in analysing it any more */
+	Analyser::cancel (source);
+
 	if (!(_state_of_the_state & StateOfTheState (InCleanup|Loading))) {
 
 		/* save state so we don't end up with a session file
@@ -42,8 +42,6 @@ Pool Click::pool ("click", sizeof (Click), 1024);
 void
 Session::click (framepos_t start, framecnt_t nframes)
 {
-	TempoMap::BBTPointList::const_iterator points_begin;
-	TempoMap::BBTPointList::const_iterator points_end;
 	Sample *buf;
 	framecnt_t click_distance;
 
@@ -72,31 +70,28 @@ Session::click (framepos_t start, framecnt_t nframes)
 	BufferSet& bufs = get_scratch_buffers(ChanCount(DataType::AUDIO, 1));
 	buf = bufs.get_audio(0).data();
 
-	_tempo_map->get_grid (points_begin, points_end, start, end);
+	/* the tempo map can be read here without taking a lock */
 
-	if (distance (points_begin, points_end) == 0) {
-		goto run_clicks;
-	}
+	Timecode::BBT_Time bbt;
 
-	for (TempoMap::BBTPointList::const_iterator i = points_begin; i != points_end; ++i) {
-		switch ((*i).beat) {
+	for (framepos_t pos = _tempo_map->beat_at_or_after_rt (start, bbt); pos < end; pos = _tempo_map->beat_at_or_after_rt (pos + 1, bbt)) {
+		switch (bbt.beats) {
 		case 1:
 			if (click_emphasis_data && Config->get_use_click_emphasis () == true) {
-				clicks.push_back (new Click ((*i).frame, click_emphasis_length, click_emphasis_data));
+				clicks.push_back (new Click (pos, click_emphasis_length, click_emphasis_data));
 			} else if (click_data && Config->get_use_click_emphasis () == false) {
-				clicks.push_back (new Click ((*i).frame, click_length, click_data));
+				clicks.push_back (new Click (pos, click_length, click_data));
 			}
 			break;
 
 		default:
-			if (click_emphasis_data == 0 || (Config->get_use_click_emphasis () == false) || (click_emphasis_data && (*i).beat != 1)) {
-				clicks.push_back (new Click ((*i).frame, click_length, click_data));
+			if (click_emphasis_data == 0 || (Config->get_use_click_emphasis () == false) || (click_emphasis_data && bbt.beats != 1)) {
+				clicks.push_back (new Click (pos, click_length, click_data));
 			}
 			break;
 		}
 	}
 
-  run_clicks:
 	memset (buf, 0, sizeof (Sample) * nframes);
 
 	for (list<Click*>::iterator i = clicks.begin(); i != clicks.end(); ) {
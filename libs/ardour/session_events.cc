@@ -233,38 +233,79 @@ SessionEventManager::merge_event (SessionEvent* ev)
 		}
 	}
 
-	events.insert (events.begin(), ev);
-	events.sort (SessionEvent::compare);
+	insert_sorted_event (ev);
 	next_event = events.begin();
 	set_next_event ();
 }
 
+SessionEventManager::Events::iterator
+SessionEventManager::insert_event (Events& list, Events::iterator pos, SessionEvent* ev)
+{
+	if (spare_nodes.empty()) {
+		DEBUG_TRACE (DEBUG::SessionEvents, "out of spare event list nodes, allocating one\n");
+		return list.insert (pos, ev);
+	}
+
+	Events::iterator n = spare_nodes.begin();
+	list.splice (pos, spare_nodes, n);
+	*n = ev;
+	return n;
+}
+
+SessionEventManager::Events::iterator
+SessionEventManager::erase_event (Events& list, Events::iterator i)
+{
+	Events::iterator next = i;
+	++next;
+	spare_nodes.splice (spare_nodes.begin(), list, i);
+	return next;
+}
+
+void
+SessionEventManager::insert_sorted_event (SessionEvent* ev)
+{
+	/* ahead of any other events at the same frame */
+
+	Events::iterator i = events.begin();
+
+	while (i != events.end() && (*i)->before (*ev)) {
+		++i;
+	}
+
+	insert_event (events, i, ev);
+}
+
 /** @return true when @a ev is deleted. */
 bool
 SessionEventManager::_replace_event (SessionEvent* ev)
 {
 	bool ret = false;
+	bool found = false;
 	Events::iterator i;
 
 	/* private, used only for events that can only exist once in the queue */
 
 	for (i = events.begin(); i != events.end(); ++i) {
 		if ((*i)->type == ev->type) {
-			(*i)->action_frame = ev->action_frame;
-			(*i)->target_frame = ev->target_frame;
-			if ((*i) == ev) {
+			found = true;
+			SessionEvent* existing = *i;
+			existing->action_frame = ev->action_frame;
+			existing->target_frame = ev->target_frame;
+			if (existing == ev) {
 				ret = true;
 			}
 			delete ev;
+			/* move it to its new place in the list */
+			erase_event (events, i);
+			insert_sorted_event (existing);
 			break;
 		}
 	}
 
-	if (i == events.end()) {
-		events.insert (events.begin(), ev);
+	if (!found) {
+		insert_sorted_event (ev);
 	}
 
-	events.sort (SessionEvent::compare);
 	next_event = events.end();
 	set_next_event ();
 
@@ -288,7 +329,7 @@ SessionEventManager::_remove_event (SessionEvent* ev)
 			if (i == next_event) {
 				++next_event;
 			}
-			i = events.erase (i);
+			i = erase_event (events, i);
 			break;
 		}
 	}
@@ -315,7 +356,7 @@ SessionEventManager::_clear_event_type (SessionEvent::Type type)
 			if (i == next_event) {
 				++next_event;
 			}
-			events.erase (i);
+			erase_event (events, i);
 		}
 
 		i = tmp;
@@ -328,7 +369,7 @@ SessionEventManager::_clear_event_type (SessionEvent::Type type)
 
 		if ((*i)->type == type) {
 			delete *i;
-			immediate_events.erase (i);
+			erase_event (immediate_events, i);
 		}
 
 		i = tmp;
@@ -142,6 +142,8 @@ Session::no_roll (pframes_t nframes)
 
 	ltc_tx_send_time_code_for_cycle (_transport_frame, end_frame, _target_transport_speed, _transport_speed, nframes);
 
+	g_atomic_int_inc (&_process_pass);
+
 	if (_process_graph) {
 		DEBUG_TRACE(DEBUG::ProcessThreads,"calling graph/no-roll\n");
 		_process_graph->routes_no_roll( nframes, _transport_frame, end_frame, non_realtime_work_pending(), declick);
@@ -180,6 +182,8 @@ Session::process_routes (pframes_t nframes, bool& need_butler)
 	const framepos_t start_frame = _transport_frame;
 	const framepos_t end_frame = _transport_frame + floor (nframes * _transport_speed);
 
+	g_atomic_int_inc (&_process_pass);
+
 	if (_process_graph) {
 		DEBUG_TRACE(DEBUG::ProcessThreads,"calling graph/process-routes\n");
 		if (_process_graph->process_routes (nframes, start_frame, end_frame, declick, need_butler) < 0) {
@@ -225,6 +229,8 @@ Session::silent_process_routes (pframes_t nframes, bool& need_butler)
 	const framepos_t start_frame = _transport_frame;
 	const framepos_t end_frame = _transport_frame + lrintf(nframes * _transport_speed);
 
+	g_atomic_int_inc (&_process_pass);
+
 	if (_process_graph) {
 		_process_graph->silent_process_routes (nframes, start_frame, end_frame, need_butler);
 	} else {
@@ -299,7 +305,7 @@ Session::process_with_events (pframes_t nframes)
 
 	/* handle any pending events */
 
-	while (pending_events.read (&ev, 1) == 1) {
+	while (pending_events.pop (ev)) {
 		merge_event (ev);
 	}
 
@@ -310,7 +316,7 @@ Session::process_with_events (pframes_t nframes)
 
 	while (!non_realtime_work_pending() && !immediate_events.empty()) {
 		SessionEvent *ev = immediate_events.front ();
-		immediate_events.pop_front ();
+		erase_event (immediate_events, immediate_events.begin());
 		process_event (ev);
 	}
 
@@ -908,7 +914,7 @@ Session::process_audition (pframes_t nframes)
 
 	/* handle pending events */
 
-	while (pending_events.read (&ev, 1) == 1) {
+	while (pending_events.pop (ev)) {
 		merge_event (ev);
 	}
 
@@ -919,7 +925,7 @@ Session::process_audition (pframes_t nframes)
 
 	while (!non_realtime_work_pending() && !immediate_events.empty()) {
 		SessionEvent *ev = immediate_events.front ();
-		immediate_events.pop_front ();
+		erase_event (immediate_events, immediate_events.begin());
 		process_event (ev);
 	}
 
@@ -983,7 +989,9 @@ Session::queue_event (SessionEvent* ev)
 	} else if (_state_of_the_state & Loading) {
 		merge_event (ev);
 	} else {
-		pending_events.write (&ev, 1);
+		if (!pending_events.push (ev)) {
+			DEBUG_TRACE (DEBUG::SessionEvents, string_compose ("event queue full, dropped %1\n", enum_2_string (ev->type)));
+		}
 	}
 }
 
@@ -1027,7 +1035,7 @@ Session::process_event (SessionEvent* ev)
 		/* except locates, which we have the capability to handle */
 
 		if (ev->type != SessionEvent::Locate) {
-			immediate_events.insert (immediate_events.end(), ev);
+			insert_event (immediate_events, immediate_events.end(), ev);
 			_remove_event (ev);
 			return;
 		}
@@ -722,6 +722,9 @@ Session::rename_state (string old_name, string new_name)
 		error << string_compose(_("could not rename snapshot %1 to %2 (%3)"),
 				old_name, new_name, g_strerror(errno)) << endmsg;
 	}
+
+	/* the state cache will be recreated for the new name when it is loaded */
+	::g_remove ((old_xml_path + statecache_suffix).c_str());
 }
 
 /** Remove a state file.
@@ -750,6 +753,8 @@ Session::remove_state (string snapshot_name)
 		error << string_compose(_("Could not remove session file at path \"%1\" (%2)"),
 				xml_path, g_strerror (errno)) << endmsg;
 	}
+
+	::g_remove ((xml_path + statecache_suffix).c_str());
 }
 
 /** @param snapshot_name Name to save under, without .ardour / .pending prefix */
@@ -862,6 +867,11 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 
 	if (!pending) {
 
+		if (Config->get_cache_session_state()) {
+			/* not fatal if this fails, the session file is saved */
+			tree.write_cache (xml_path, xml_path + statecache_suffix);
+		}
+
 		save_history (snapshot_name);
 
 		if (mark_as_clean) {
@@ -931,7 +941,11 @@ Session::load_state (string snapshot_name)
 
 	_writable = exists_and_writable (xmlpath) && exists_and_writable(Glib::path_get_dirname(xmlpath));
 
-	if (!state_tree->read (xmlpath)) {
+	bool const read_ok = Config->get_cache_session_state() && _writable ?
+		state_tree->read_with_cache (xmlpath, xmlpath + statecache_suffix) :
+		state_tree->read (xmlpath);
+
+	if (!read_ok) {
 		error << string_compose(_("Could not understand session file %1"), xmlpath) << endmsg;
 		delete state_tree;
 		state_tree = 0;
@@ -29,12 +29,19 @@
 
 #include <sys/stat.h>
 
+#include <list>
+#include <map>
+#include <vector>
+
 #include <glib.h>
 #include "pbd/gstdio_compat.h"
 
 #include <glibmm/convert.h>
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
+#include <glibmm/threads.h>
+
+#include <boost/weak_ptr.hpp>
 
 #include "ardour/sndfilesource.h"
 #include "ardour/sndfile_helpers.h"
@@ -57,6 +64,169 @@ const Source::Flag SndFileSource::default_writable_flags = Source::Flag (
 		Source::RemovableIfEmpty |
 		Source::CanRename );
 
+/** The most recent reads from one multichannel file, kept in their
+ *  interleaved form.  Each channel of such a file has its own SndFileSource,
+ *  and the butler asks each of them in turn for the same range of the file.
+ *  Only the first of them needs to seek and read; the others can then pick
+ *  their channel out of what it read.  The sources of a file share its
+ *  cache, so reads from different files do not contend for a lock.
+ */
+class ARDOUR::InterleavedReadCache
+{
+  public:
+	InterleavedReadCache (string const & path) : _path (path) {}
+	~InterleavedReadCache ();
+
+	static boost::shared_ptr<InterleavedReadCache> get (string const & path);
+	static void forget (string const & path);
+
+	bool read (uint32_t channel, Sample* dst, framepos_t start, framecnt_t cnt, framecnt_t& nread);
+	void store (uint32_t channels, Sample const * data, framepos_t start, framecnt_t cnt, framecnt_t nread);
+
+  private:
+	struct Block {
+		uint32_t channels;
+		framepos_t start;
+		framecnt_t frames; ///< frames read
+		bool at_end;       ///< true if the read was cut short by the end of the file
+		vector<Sample> data; ///< never shrinks, so that it can be re-used
+	};
+
+	/** most recently used first */
+	typedef list<Block> Blocks;
+
+	/* enough for a few regions of the file being played at once */
+	static const size_t max_blocks = 4;
+
+	string const _path;
+	Glib::Threads::Mutex _lock;
+	Blocks _blocks;
+
+	typedef map<string, boost::weak_ptr<InterleavedReadCache> > Caches;
+
+	static Glib::Threads::Mutex _caches_lock;
+	static Caches _caches;
+};
+
+Glib::Threads::Mutex InterleavedReadCache::_caches_lock;
+InterleavedReadCache::Caches InterleavedReadCache::_caches;
+
+InterleavedReadCache::~InterleavedReadCache ()
+{
+	Glib::Threads::Mutex::Lock lm (_caches_lock);
+
+	Caches::iterator i = _caches.find (_path);
+
+	/* the file may have been opened again while we were going away */
+	if (i != _caches.end() && i->second.expired()) {
+		_caches.erase (i);
+	}
+}
+
+/** @return the cache for the file at @param path, shared by all of the
+ *  sources that have it open.
+ */
+boost::shared_ptr<InterleavedReadCache>
+InterleavedReadCache::get (string const & path)
+{
+	Glib::Threads::Mutex::Lock lm (_caches_lock);
+
+	boost::shared_ptr<InterleavedReadCache> cache = _caches[path].lock ();
+
+	if (!cache) {
+		cache.reset (new InterleavedReadCache (path));
+		_caches[path] = cache;
+	}
+
+	return cache;
+}
+
+/** Drop anything cached for the file at @param path */
+void
+InterleavedReadCache::forget (string const & path)
+{
+	boost::shared_ptr<InterleavedReadCache> cache;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_caches_lock);
+		Caches::iterator i = _caches.find (path);
+		if (i != _caches.end()) {
+			cache = i->second.lock ();
+		}
+	}
+
+	if (cache) {
+		Glib::Threads::Mutex::Lock lm (cache->_lock);
+		cache->_blocks.clear ();
+	}
+}
+
+/** Copy one channel of a range of the file from the cache, if it is there.
+ *  @param nread Filled in with the number of frames copied.
+ *  @return true if the range was found.
+ */
+bool
+InterleavedReadCache::read (uint32_t channel, Sample* dst, framepos_t start, framecnt_t cnt, framecnt_t& nread)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	for (Blocks::iterator b = _blocks.begin(); b != _blocks.end(); ++b) {
+
+		if (start < b->start || (start + cnt > b->start + b->frames && !b->at_end) || channel >= b->channels) {
+			continue;
+		}
+
+		nread = max ((framecnt_t) 0, min (cnt, b->start + b->frames - start));
+
+		if (nread > 0) {
+			Sample const * ptr = &b->data[0] + (start - b->start) * b->channels + channel;
+
+			for (framecnt_t n = 0; n < nread; ++n) {
+				dst[n] = *ptr;
+				ptr += b->channels;
+			}
+		}
+
+		_blocks.splice (_blocks.begin(), _blocks, b);
+		return true;
+	}
+
+	return false;
+}
+
+/** Remember the result of an interleaved read of @param cnt frames
+ *  from @param start, which gave @param nread frames.
+ */
+void
+InterleavedReadCache::store (uint32_t channels, Sample const * data, framepos_t start, framecnt_t cnt, framecnt_t nread)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	Blocks::iterator b;
+
+	if (_blocks.size() < max_blocks) {
+		b = _blocks.insert (_blocks.end(), Block ());
+	} else {
+		/* re-use the least recently used block, and its buffer */
+		b = _blocks.end();
+		--b;
+	}
+
+	size_t const samples = nread * channels;
+
+	if (b->data.size() < samples) {
+		b->data.resize (samples);
+	}
+
+	b->channels = channels;
+	b->start = start;
+	b->frames = nread;
+	b->at_end = nread < cnt;
+	copy (data, data + samples, b->data.begin());
+
+	_blocks.splice (_blocks.begin(), _blocks, b);
+}
+
 SndFileSource::SndFileSource (Session& s, const XMLNode& node)
 	: Source(s, node)
 	, AudioFileSource (s, node)
@@ -255,6 +425,7 @@ SndFileSource::close ()
 	if (_sndfile) {
 		sf_close (_sndfile);
 		_sndfile = 0;
+		_read_cache.reset ();
 		file_closed ();
 	}
 }
@@ -285,6 +456,11 @@ SndFileSource::open ()
 		return -1;
 	}
 
+	if (writable()) {
+		/* we may be about to change what is in the file */
+		InterleavedReadCache::forget (_path);
+	}
+
 	_sndfile = sf_open_fd (fd, writable() ? SFM_RDWR : SFM_READ, &_info, true);
 
 	if (_sndfile == 0) {
@@ -359,6 +535,10 @@ SndFileSource::open ()
 		_flags = Flag (_flags | Broadcast);
 	}
 
+	if (!writable() && _info.channels > 1) {
+		_read_cache = InterleavedReadCache::get (_path);
+	}
+
 	if (writable()) {
 		sf_command (_sndfile, SFC_SET_UPDATE_HEADER_AUTO, 0, SF_FALSE);
 
@@ -445,6 +625,13 @@ SndFileSource::read_unlocked (Sample *dst, framepos_t start, framecnt_t cnt) con
 		memset (dst+file_cnt, 0, sizeof (Sample) * delta);
 	}
 
+	/* another channel of this file may already have read this range */
+	bool const cache = file_cnt && _read_cache;
+
+	if (cache && _read_cache->read (_channel, dst, start, cnt, nread)) {
+		return nread;
+	}
+
 	if (file_cnt) {
 
 		if (sf_seek (_sndfile, (sf_count_t) start, SEEK_SET|SFM_READ) != (sf_count_t) start) {
@@ -473,6 +660,10 @@ SndFileSource::read_unlocked (Sample *dst, framepos_t start, framecnt_t cnt) con
 	ptr = interleave_buf + _channel;
 	nread /= _info.channels;
 
+	if (cache) {
+		_read_cache->store (_info.channels, interleave_buf, start, cnt, nread);
+	}
+
 	/* stride through the interleaved data */
 
 	for (framecnt_t n = 0; n < nread; ++n) {
@@ -85,6 +85,11 @@ peak_thread_work ()
 		}
 
 		as->setup_peakfile ();
+
+		if (as->peak_levels_stale ()) {
+			as->build_peak_levels ();
+		}
+
 		SourceFactory::peak_building_lock.lock ();
 		--active_threads;
 		SourceFactory::peak_building_lock.unlock ();
@@ -127,6 +132,15 @@ SourceFactory::setup_peakfile (boost::shared_ptr<Source> s, bool async)
 				error << string_compose("SourceFactory: could not set up peakfile for %1", as->name()) << endmsg;
 				return -1;
 			}
+
+			if (as->peak_levels_stale ()) {
+				/* the peak thread will set the peakfile up again,
+				   which finds it valid, and then build the levels
+				*/
+				Glib::Threads::Mutex::Lock lm (peak_building_lock);
+				files_with_peaks.push_back (boost::weak_ptr<AudioSource> (as));
+				PeaksToBuild.broadcast ();
+			}
 		}
 	}
 
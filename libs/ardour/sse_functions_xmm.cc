@@ -20,6 +20,7 @@
 
 #include <xmmintrin.h>
 #include "ardour/types.h"
+#include "ardour/mix.h"
 
 void
 x86_sse_find_peaks(const ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float *min, float *max)
@@ -117,3 +118,162 @@ x86_sse_find_peaks(const ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float *
 
 
 
+
+/* Meter ballistics, evaluated for four channels at once: each SSE lane
+ * carries the filter state of one channel, and every 4x4 block of input
+ * is transposed so that one register holds the same sample of four
+ * channels. Per lane the arithmetic is identical to the scalar code in
+ * mix.cc, so results match it bit for bit. Left-over channels are
+ * handed to the scalar version.
+ */
+
+static inline __m128
+sse_abs (__m128 x)
+{
+	return _mm_andnot_ps (_mm_set1_ps (-0.0f), x);
+}
+
+/* if (t > z) z += w * (t - z); */
+static inline __m128
+sse_ppm_attack (__m128 z, __m128 t, __m128 w)
+{
+	const __m128 mask = _mm_cmpgt_ps (t, z);
+	const __m128 up   = _mm_add_ps (z, _mm_mul_ps (w, _mm_sub_ps (t, z)));
+	return _mm_or_ps (_mm_and_ps (mask, up), _mm_andnot_ps (mask, z));
+}
+
+void
+x86_sse_kmeter_process (const float * const * bufs, uint32_t n_channels, uint32_t nframes, float omega, float *z1, float *z2)
+{
+	const __m128 w  = _mm_set1_ps (omega);
+	const __m128 w4 = _mm_set1_ps (4 * omega);
+	uint32_t c = 0;
+
+	for (; c + 4 <= n_channels; c += 4) {
+		const float* p0 = bufs[c];
+		const float* p1 = bufs[c + 1];
+		const float* p2 = bufs[c + 2];
+		const float* p3 = bufs[c + 3];
+		__m128 a = _mm_loadu_ps (z1 + c);
+		__m128 b = _mm_loadu_ps (z2 + c);
+
+		for (uint32_t i = 0; i + 4 <= nframes; i += 4) {
+			__m128 s0 = _mm_loadu_ps (p0 + i);
+			__m128 s1 = _mm_loadu_ps (p1 + i);
+			__m128 s2 = _mm_loadu_ps (p2 + i);
+			__m128 s3 = _mm_loadu_ps (p3 + i);
+			_MM_TRANSPOSE4_PS (s0, s1, s2, s3);
+
+			s0 = _mm_mul_ps (s0, s0);
+			a = _mm_add_ps (a, _mm_mul_ps (w, _mm_sub_ps (s0, a)));
+			s1 = _mm_mul_ps (s1, s1);
+			a = _mm_add_ps (a, _mm_mul_ps (w, _mm_sub_ps (s1, a)));
+			s2 = _mm_mul_ps (s2, s2);
+			a = _mm_add_ps (a, _mm_mul_ps (w, _mm_sub_ps (s2, a)));
+			s3 = _mm_mul_ps (s3, s3);
+			a = _mm_add_ps (a, _mm_mul_ps (w, _mm_sub_ps (s3, a)));
+			b = _mm_add_ps (b, _mm_mul_ps (w4, _mm_sub_ps (a, b)));
+		}
+
+		_mm_storeu_ps (z1 + c, a);
+		_mm_storeu_ps (z2 + c, b);
+	}
+
+	default_kmeter_process (bufs + c, n_channels - c, nframes, omega, z1 + c, z2 + c);
+}
+
+void
+x86_sse_ppm_process (const float * const * bufs, uint32_t n_channels, uint32_t nframes, float w1, float w2, float w3, float *z1, float *z2, float *m)
+{
+	const __m128 v1 = _mm_set1_ps (w1);
+	const __m128 v2 = _mm_set1_ps (w2);
+	const __m128 v3 = _mm_set1_ps (w3);
+	uint32_t c = 0;
+
+	for (; c + 4 <= n_channels; c += 4) {
+		const float* p0 = bufs[c];
+		const float* p1 = bufs[c + 1];
+		const float* p2 = bufs[c + 2];
+		const float* p3 = bufs[c + 3];
+		__m128 a  = _mm_loadu_ps (z1 + c);
+		__m128 b  = _mm_loadu_ps (z2 + c);
+		__m128 mx = _mm_loadu_ps (m + c);
+
+		for (uint32_t i = 0; i + 4 <= nframes; i += 4) {
+			__m128 s0 = _mm_loadu_ps (p0 + i);
+			__m128 s1 = _mm_loadu_ps (p1 + i);
+			__m128 s2 = _mm_loadu_ps (p2 + i);
+			__m128 s3 = _mm_loadu_ps (p3 + i);
+			_MM_TRANSPOSE4_PS (s0, s1, s2, s3);
+
+			a = _mm_mul_ps (a, v3);
+			b = _mm_mul_ps (b, v3);
+
+			s0 = sse_abs (s0);
+			a = sse_ppm_attack (a, s0, v1);
+			b = sse_ppm_attack (b, s0, v2);
+			s1 = sse_abs (s1);
+			a = sse_ppm_attack (a, s1, v1);
+			b = sse_ppm_attack (b, s1, v2);
+			s2 = sse_abs (s2);
+			a = sse_ppm_attack (a, s2, v1);
+			b = sse_ppm_attack (b, s2, v2);
+			s3 = sse_abs (s3);
+			a = sse_ppm_attack (a, s3, v1);
+			b = sse_ppm_attack (b, s3, v2);
+
+			/* maxps returns its second operand unless the first is
+			 * greater, which is exactly "if (t > m) m = t;"
+			 */
+			mx = _mm_max_ps (_mm_add_ps (a, b), mx);
+		}
+
+		_mm_storeu_ps (z1 + c, a);
+		_mm_storeu_ps (z2 + c, b);
+		_mm_storeu_ps (m + c, mx);
+	}
+
+	default_ppm_process (bufs + c, n_channels - c, nframes, w1, w2, w3, z1 + c, z2 + c, m + c);
+}
+
+void
+x86_sse_vumeter_process (const float * const * bufs, uint32_t n_channels, uint32_t nframes, float w, float *z1, float *z2, float *m)
+{
+	const __m128 v   = _mm_set1_ps (w);
+	const __m128 v4  = _mm_set1_ps (4 * w);
+	const __m128 two = _mm_set1_ps (2.0f);
+	uint32_t c = 0;
+
+	for (; c + 4 <= n_channels; c += 4) {
+		const float* p0 = bufs[c];
+		const float* p1 = bufs[c + 1];
+		const float* p2 = bufs[c + 2];
+		const float* p3 = bufs[c + 3];
+		__m128 a  = _mm_loadu_ps (z1 + c);
+		__m128 b  = _mm_loadu_ps (z2 + c);
+		__m128 mx = _mm_loadu_ps (m + c);
+
+		for (uint32_t i = 0; i + 4 <= nframes; i += 4) {
+			__m128 s0 = _mm_loadu_ps (p0 + i);
+			__m128 s1 = _mm_loadu_ps (p1 + i);
+			__m128 s2 = _mm_loadu_ps (p2 + i);
+			__m128 s3 = _mm_loadu_ps (p3 + i);
+			_MM_TRANSPOSE4_PS (s0, s1, s2, s3);
+
+			const __m128 t2 = _mm_div_ps (b, two);
+
+			a = _mm_add_ps (a, _mm_mul_ps (v, _mm_sub_ps (_mm_sub_ps (sse_abs (s0), t2), a)));
+			a = _mm_add_ps (a, _mm_mul_ps (v, _mm_sub_ps (_mm_sub_ps (sse_abs (s1), t2), a)));
+			a = _mm_add_ps (a, _mm_mul_ps (v, _mm_sub_ps (_mm_sub_ps (sse_abs (s2), t2), a)));
+			a = _mm_add_ps (a, _mm_mul_ps (v, _mm_sub_ps (_mm_sub_ps (sse_abs (s3), t2), a)));
+			b = _mm_add_ps (b, _mm_mul_ps (v4, _mm_sub_ps (a, b)));
+			mx = _mm_max_ps (b, mx);
+		}
+
+		_mm_storeu_ps (z1 + c, a);
+		_mm_storeu_ps (z2 + c, b);
+		_mm_storeu_ps (m + c, mx);
+	}
+
+	default_vumeter_process (bufs + c, n_channels - c, nframes, w, z1 + c, z2 + c, m + c);
+}
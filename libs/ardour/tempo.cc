@@ -276,6 +276,7 @@ struct MetricSectionSorter {
 };
 
 TempoMap::TempoMap (framecnt_t fr)
+	: _sections (new Sections)
 {
 	_frame_rate = fr;
 	BBT_Time start;
@@ -294,6 +295,8 @@ TempoMap::TempoMap (framecnt_t fr)
 
 	metrics.push_back (t);
 	metrics.push_back (m);
+
+	recompute_map (false);
 }
 
 TempoMap::~TempoMap ()
@@ -769,7 +772,7 @@ TempoMap::first_tempo ()
 void
 TempoMap::require_map_to (framepos_t pos)
 {
-	Glib::Threads::RWLock::WriterLock lm (lock);
+	/* CALLER MUST HOLD WRITE LOCK */
 
 	if (_map.empty() || _map.back().frame < pos) {
 		extend_map (pos);
@@ -777,53 +780,15 @@ TempoMap::require_map_to (framepos_t pos)
 }
 
 void
-TempoMap::require_map_to (const BBT_Time& bbt)
-{
-	Glib::Threads::RWLock::WriterLock lm (lock);
-
-	/* since we have no idea where BBT is if its off the map, see the last
-	 * point in the map is past BBT, and if not add an arbitrary amount of
-	 * time until it is.
-	 */
-
-	int additional_minutes = 1;
-
-	while (1) {
-		if (!_map.empty() && _map.back().bar >= (bbt.bars + 1)) {
-			break;
-		}
-		/* add some more distance, using bigger steps each time */
-		extend_map (_map.back().frame + (_frame_rate * 60 * additional_minutes));
-		additional_minutes *= 2;
-	}
-}
-
-void
-TempoMap::recompute_map (bool reassign_tempo_bbt, framepos_t end)
+TempoMap::recompute_map (bool reassign_tempo_bbt)
 {
 	/* CALLER MUST HOLD WRITE LOCK */
 
 	MeterSection* meter = 0;
 	TempoSection* tempo = 0;
-	double current_frame;
-	BBT_Time current;
 	Metrics::iterator next_metric;
 
-	if (end < 0) {
-
-		/* we will actually stop once we hit
-		   the last metric.
-		*/
-		end = max_framepos;
-
-	} else {
-		if (!_map.empty ()) {
-			/* never allow the map to be shortened */
-			end = max (end, _map.back().frame);
-		}
-	}
-
-	DEBUG_TRACE (DEBUG::TempoMath, string_compose ("recomputing tempo map, zero to %1\n", end));
+	DEBUG_TRACE (DEBUG::TempoMath, "recomputing tempo map\n");
 
 	for (Metrics::iterator i = metrics.begin(); i != metrics.end(); ++i) {
 		MeterSection* ms;
@@ -848,15 +813,9 @@ TempoMap::recompute_map (bool reassign_tempo_bbt, framepos_t end)
 	assert(tempo);
 
 	/* assumes that the first meter & tempo are at frame zero */
-	current_frame = 0;
 	meter->set_frame (0);
 	tempo->set_frame (0);
 
-	/* assumes that the first meter & tempo are at 1|1|0 */
-	current.bars = 1;
-	current.beats = 1;
-	current.ticks = 0;
-
 	if (reassign_tempo_bbt) {
 
 		MeterSection* rmeter = meter;
@@ -891,221 +850,293 @@ TempoMap::recompute_map (bool reassign_tempo_bbt, framepos_t end)
 	++next_metric; // skip meter (or tempo)
 	++next_metric; // skip tempo (or meter)
 
+	/* the beats themselves are only materialized on demand */
+
 	_map.clear ();
 
-	DEBUG_TRACE (DEBUG::TempoMath, string_compose ("Add first bar at 1|1 @ %2\n", current.bars, current_frame));
-	_map.push_back (BBTPoint (*meter, *tempo,(framepos_t) llrint(current_frame), 1, 1));
+	RCUWriter<Sections> writer (_sections);
+	boost::shared_ptr<Sections> sections = writer.get_copy ();
 
-	if (end == 0) {
-		/* silly call from Session::process() during startup
-		 */
-		return;
-	}
+	sections->clear ();
+	compute_sections (*sections, tempo, meter, next_metric);
+}
 
-	_extend_map (tempo, meter, next_metric, current, current_frame, end);
+static uint32_t
+grid_beats_per_bar (const Meter& meter)
+{
+	/* a bar ends once the beat number exceeds the divisions per bar */
+	const double d = floor (meter.divisions_per_bar ());
+	return d < 1.0 ? 1 : (uint32_t) d;
 }
 
 void
-TempoMap::extend_map (framepos_t end)
+TempoMap::compute_sections (Sections& sections, TempoSection* tempo, MeterSection* meter, Metrics::iterator next_metric)
 {
 	/* CALLER MUST HOLD WRITE LOCK */
 
-	if (_map.empty()) {
-		recompute_map (false, end);
-		return;
-	}
+	TempoSection* ts;
+	MeterSection* ms;
+	Section s;
 
-	BBTPointList::const_iterator i = _map.end();
-	Metrics::iterator next_metric;
+	/* assumes that the first meter & tempo are at 1|1|0, frame zero */
 
-	--i;
+	s.frame_exact = 0;
+	s.frame = 0;
+	s.beat_frames = meter->frames_per_grid (*tempo, _frame_rate);
+	s.tick_frames = tempo->frames_per_beat (_frame_rate);
+	s.index = 0;
+	s.bar = 1;
+	s.beat = 1;
+	s.beats_per_bar = grid_beats_per_bar (*meter);
+	s.meter = meter;
+	s.tempo = tempo;
 
-	BBT_Time last_metric_start;
+	sections.push_back (s);
 
-	if ((*i).tempo->frame() > (*i).meter->frame()) {
-		last_metric_start = (*i).tempo->start();
-	} else {
-		last_metric_start = (*i).meter->start();
-	}
+	while (next_metric != metrics.end()) {
 
-	/* find the metric immediately after the tempo + meter sections for the
-	 * last point in the map
-	 */
+		/* find the first beat after the start of the current section
+		 * that is not before the next metric; beats are evenly spaced
+		 * until then, so there is no need to visit them one by one.
+		 */
 
-	for (next_metric = metrics.begin(); next_metric != metrics.end(); ++next_metric) {
-		if ((*next_metric)->start() > last_metric_start) {
-			break;
+		const BBT_Time start ((*next_metric)->start());
+		BBT_Time current;
+
+		if (start.beats < 1) {
+			current = BBT_Time (start.bars, 1, 0);
+		} else if (start.beats <= s.beats_per_bar && start.ticks == 0) {
+			current = BBT_Time (start.bars, start.beats, 0);
+		} else if (start.beats < s.beats_per_bar) {
+			current = BBT_Time (start.bars, start.beats + 1, 0);
+		} else {
+			current = BBT_Time (start.bars + 1, 1, 0);
 		}
-	}
 
-	/* we cast away const here because this is the one place where we need
-	 * to actually modify the frame time of each metric section.
-	 */
+		int64_t k = ((int64_t) current.bars - s.bar) * s.beats_per_bar + ((int64_t) current.beats - s.beat);
 
-	_extend_map (const_cast<TempoSection*> ((*i).tempo),
-		     const_cast<MeterSection*> ((*i).meter),
-		     next_metric, BBT_Time ((*i).bar, (*i).beat, 0), (*i).frame, end);
-}
+		if (k < 1) {
+			k = 1;
+			current = s.bbt_at (k);
+		}
 
-void
-TempoMap::_extend_map (TempoSection* tempo, MeterSection* meter,
-		       Metrics::iterator next_metric,
-		       BBT_Time current, framepos_t current_frame, framepos_t end)
-{
-	/* CALLER MUST HOLD WRITE LOCK */
+		double beat_frames = s.beat_frames;
+		double current_frame_exact = s.frame_exact + k * beat_frames;
 
-	TempoSection* ts;
-	MeterSection* ms;
-	double beat_frames;
-	double current_frame_exact;
-	framepos_t bar_start_frame;
+		DEBUG_TRACE (DEBUG::TempoMath, string_compose ("next metric @ %1 takes effect at %2\n", start, current));
 
-	DEBUG_TRACE (DEBUG::TempoMath, string_compose ("Extend map to %1 from %2 = %3\n", end, current, current_frame));
+		while (true) {
 
-	if (current.beats == 1) {
-		bar_start_frame = current_frame;
-	} else {
-		bar_start_frame = 0;
-	}
+			if (((ts = dynamic_cast<TempoSection*> (*next_metric)) != 0)) {
 
-	beat_frames = meter->frames_per_grid (*tempo,_frame_rate);
-	current_frame_exact = current_frame;
+				tempo = ts;
 
-	while (current_frame < end) {
+				/* new tempo section: if its on a beat,
+				 * it simply starts a new section.
+				 *
+				 * if its not on the beat, we have to
+				 * compute the duration of the beat it
+				 * is within, which will be different
+				 * from the preceding following ones
+				 * since it takes part of its duration
+				 * from the preceding tempo and part
+				 * from this new tempo.
+				 */
 
-		current.beats++;
-		current_frame_exact += beat_frames;
-		current_frame = llrint(current_frame_exact);
+				if (tempo->start().ticks != 0) {
 
-		if (current.beats > meter->divisions_per_bar()) {
-			current.bars++;
-			current.beats = 1;
-		}
+					double next_beat_frames = tempo->frames_per_beat (_frame_rate);
 
-		if (next_metric != metrics.end()) {
+					/* back up to previous beat, and
+					 * the start of the bar it is in
+					 */
+					const double prev_frame_exact = s.frame_exact + (k - 1) * s.beat_frames;
+					const framepos_t prev_frame = llrint (prev_frame_exact);
+					const BBT_Time prev (s.bbt_at (k - 1));
+					Sections::const_iterator bs = section_at_index (sections, s.index + k - prev.beats);
+					const framepos_t bar_start_frame = bs->frame_at (s.index + k - prev.beats - bs->index);
+
+					DEBUG_TRACE (DEBUG::TempoMath, string_compose ("bumped into non-beat-aligned tempo metric at %1 = %2, adjust next beat using %3\n",
+					                                               tempo->start(), prev_frame, tempo->bar_offset()));
+
+					/* set tempo section location
+					 * based on offset from last
+					 * bar start
+					 */
+					tempo->set_frame (bar_start_frame +
+					                  llrint ((ts->bar_offset() * meter->divisions_per_bar() * beat_frames)));
+
+					/* advance to the location of
+					 * the new (adjusted) beat. do
+					 * this by figuring out the
+					 * offset within the beat that
+					 * would have been there
+					 * without the tempo
+					 * change. then stretch the
+					 * beat accordingly.
+					 */
 
-			/* no operator >= so invert operator < */
+					double offset_within_old_beat = (tempo->frame() - prev_frame) / beat_frames;
 
-			DEBUG_TRACE (DEBUG::TempoMath, string_compose ("now at %1 next metric @ %2\n", current, (*next_metric)->start()));
+					current_frame_exact = prev_frame_exact + (offset_within_old_beat * beat_frames) + ((1.0 - offset_within_old_beat) * next_beat_frames);
 
-			if (!(current < (*next_metric)->start())) {
+					DEBUG_TRACE (DEBUG::TempoMath, string_compose ("Adjusted last beat to %1\n", llrint (current_frame_exact)));
 
-		set_metrics:
-				if (((ts = dynamic_cast<TempoSection*> (*next_metric)) != 0)) {
+				} else {
 
-					tempo = ts;
+					DEBUG_TRACE (DEBUG::TempoMath, string_compose ("bumped into beat-aligned tempo metric at %1 = %2\n",
+					                                               tempo->start(), llrint (current_frame_exact)));
+					tempo->set_frame (llrint (current_frame_exact));
+				}
 
-					/* new tempo section: if its on a beat,
-					 * we don't have to do anything other
-					 * than recompute various distances,
-					 * done further below as we transition
-					 * the next metric section.
-					 *
-					 * if its not on the beat, we have to
-					 * compute the duration of the beat it
-					 * is within, which will be different
-					 * from the preceding following ones
-					 * since it takes part of its duration
-					 * from the preceding tempo and part
-					 * from this new tempo.
-					 */
+			} else if ((ms = dynamic_cast<MeterSection*>(*next_metric)) != 0) {
 
-					if (tempo->start().ticks != 0) {
+				meter = ms;
 
-						double next_beat_frames = tempo->frames_per_beat (_frame_rate);
+				/* new meter section: always defines the
+				 * start of a bar.
+				 */
 
-						DEBUG_TRACE (DEBUG::TempoMath, string_compose ("bumped into non-beat-aligned tempo metric at %1 = %2, adjust next beat using %3\n",
-						                                               tempo->start(), current_frame, tempo->bar_offset()));
+				DEBUG_TRACE (DEBUG::TempoMath, string_compose ("bumped into meter section at %1 vs %2 (%3)\n",
+				                                               meter->start(), current, llrint (current_frame_exact)));
 
-						/* back up to previous beat */
-						current_frame_exact -= beat_frames;
-						current_frame = llrint(current_frame_exact);
+				assert (current.beats == 1);
 
-						/* set tempo section location
-						 * based on offset from last
-						 * bar start
-						 */
-						tempo->set_frame (bar_start_frame +
-						                  llrint ((ts->bar_offset() * meter->divisions_per_bar() * beat_frames)));
+				meter->set_frame (llrint (current_frame_exact));
+			}
 
-						/* advance to the location of
-						 * the new (adjusted) beat. do
-						 * this by figuring out the
-						 * offset within the beat that
-						 * would have been there
-						 * without the tempo
-						 * change. then stretch the
-						 * beat accordingly.
-						 */
+			beat_frames = meter->frames_per_grid (*tempo, _frame_rate);
 
-						double offset_within_old_beat = (tempo->frame() - current_frame) / beat_frames;
+			DEBUG_TRACE (DEBUG::TempoMath, string_compose ("New metric with beat frames = %1 dpb %2 meter %3 tempo %4\n",
+			                                               beat_frames, meter->divisions_per_bar(), *((Meter*)meter), *((Tempo*)tempo)));
 
-						current_frame_exact += (offset_within_old_beat * beat_frames) + ((1.0 - offset_within_old_beat) * next_beat_frames);
-						current_frame = llrint(current_frame_exact);
+			++next_metric;
 
-						/* next metric doesn't have to
-						 * match this precisely to
-						 * merit a reloop ...
-						 */
-						DEBUG_TRACE (DEBUG::TempoMath, string_compose ("Adjusted last beat to %1\n", current_frame));
+			if (next_metric == metrics.end() || !((*next_metric)->start() == current)) {
+				break;
+			}
 
-					} else {
+			/* same position so set this one up before advancing */
+		}
 
-						DEBUG_TRACE (DEBUG::TempoMath, string_compose ("bumped into beat-aligned tempo metric at %1 = %2\n",
-						                                               tempo->start(), current_frame));
-						tempo->set_frame (current_frame);
-					}
+		s.frame_exact = current_frame_exact;
+		s.frame = llrint (current_frame_exact);
+		s.beat_frames = beat_frames;
+		s.tick_frames = tempo->frames_per_beat (_frame_rate);
+		s.index += k;
+		s.bar = current.bars;
+		s.beat = current.beats;
+		s.beats_per_bar = grid_beats_per_bar (*meter);
+		s.meter = meter;
+		s.tempo = tempo;
 
-				} else if ((ms = dynamic_cast<MeterSection*>(*next_metric)) != 0) {
+		sections.push_back (s);
+	}
 
-					meter = ms;
+	DEBUG_TRACE (DEBUG::TempoMath, string_compose ("tempo map has %1 sections\n", sections.size()));
+}
 
-					/* new meter section: always defines the
-					 * start of a bar.
-					 */
+void
+TempoMap::extend_map (framepos_t end)
+{
+	/* CALLER MUST HOLD WRITE LOCK */
 
-					DEBUG_TRACE (DEBUG::TempoMath, string_compose ("bumped into meter section at %1 vs %2 (%3)\n",
-					                                               meter->start(), current, current_frame));
+	/* materialize beats until we reach a bar at or after end, so that
+	 * searches for the next bar always find one.
+	 */
 
-					assert (current.beats == 1);
+	boost::shared_ptr<Sections> sections = _sections.reader ();
+	int64_t index = _map.size ();
+	Sections::const_iterator s = section_at_index (*sections, index);
 
-					meter->set_frame (current_frame);
-				}
+	DEBUG_TRACE (DEBUG::TempoMath, string_compose ("Extend map to %1 from beat %2\n", end, index));
 
-				beat_frames = meter->frames_per_grid (*tempo, _frame_rate);
+	while (_map.empty() || _map.back().frame < end || !_map.back().is_bar()) {
 
-				DEBUG_TRACE (DEBUG::TempoMath, string_compose ("New metric with beat frames = %1 dpb %2 meter %3 tempo %4\n",
-				                                               beat_frames, meter->divisions_per_bar(), *((Meter*)meter), *((Tempo*)tempo)));
+		Sections::const_iterator n = s;
+		++n;
 
-				++next_metric;
+		if (n != sections->end() && index >= n->index) {
+			s = n;
+			continue;
+		}
 
-				if (next_metric != metrics.end() && ((*next_metric)->start() == current)) {
-					/* same position so go back and set this one up before advancing
-					 */
-					goto set_metrics;
-				}
+		const BBT_Time bbt (s->bbt_at (index - s->index));
+		_map.push_back (BBTPoint (*s->meter, *s->tempo, s->frame_at (index - s->index), bbt.bars, bbt.beats));
+		++index;
+	}
+}
 
-			}
-		}
+TempoMap::Sections::const_iterator
+TempoMap::section_at (const Sections& sections, framepos_t pos)
+{
+	/* the last section starting at or before pos; the first one is at zero */
 
-		if (current.beats == 1) {
-			DEBUG_TRACE (DEBUG::TempoMath, string_compose ("Add Bar at %1|1 @ %2\n", current.bars, current_frame));
-			_map.push_back (BBTPoint (*meter, *tempo, current_frame, current.bars, 1));
-			bar_start_frame = current_frame;
-		} else {
-			DEBUG_TRACE (DEBUG::TempoMath, string_compose ("Add Beat at %1|%2 @ %3\n", current.bars, current.beats, current_frame));
-			_map.push_back (BBTPoint (*meter, *tempo, current_frame, current.bars, current.beats));
-		}
+	Sections::const_iterator i = upper_bound (sections.begin(), sections.end(), pos, Section::frame_less);
+	assert (i != sections.begin());
+	return --i;
+}
 
-		if (next_metric == metrics.end()) {
-			/* no more metrics - we've timestamped them all, stop here */
-			if (end == max_framepos) {
-				DEBUG_TRACE (DEBUG::TempoMath, string_compose ("stop extending map now that we've reach the end @ %1|%2 = %3\n",
-				                                               current.bars, current.beats, current_frame));
-				break;
-			}
-		}
+TempoMap::Sections::const_iterator
+TempoMap::section_at (const Sections& sections, const BBT_Time& bbt)
+{
+	Sections::const_iterator i = upper_bound (sections.begin(), sections.end(), bbt, Section::bbt_less);
+	assert (i != sections.begin());
+	return --i;
+}
+
+TempoMap::Sections::const_iterator
+TempoMap::section_at_index (const Sections& sections, int64_t index)
+{
+	Sections::const_iterator i = upper_bound (sections.begin(), sections.end(), index, Section::index_less);
+	assert (i != sections.begin());
+	return --i;
+}
+
+int64_t
+TempoMap::beat_before_or_at (const Sections& sections, framepos_t pos, Sections::const_iterator& s)
+{
+	/* returns the beat within the section s, counting from zero */
+
+	if (pos < 0) {
+		s = sections.begin();
+		return 0;
 	}
+
+	s = section_at (sections, pos);
+
+	Sections::const_iterator n = s;
+	++n;
+
+	const int64_t last = (n == sections.end() ? INT64_MAX : n->index - s->index - 1);
+	int64_t k = (int64_t) floor ((pos - s->frame_exact) / s->beat_frames);
+
+	k = max ((int64_t) 0, min (k, last));
+
+	/* beat positions are rounded, so we may be one out */
+
+	while (k > 0 && s->frame_at (k) > pos) {
+		--k;
+	}
+	while (k < last && s->frame_at (k + 1) <= pos) {
+		++k;
+	}
+
+	return k;
+}
+
+int64_t
+TempoMap::beat_before_or_at (const Sections& sections, const BBT_Time& bbt, Sections::const_iterator& s)
+{
+	/* returns the beat within the section s, counting from zero. a
+	 * beat number past the end of its bar means the last beat of it.
+	 */
+
+	s = section_at (sections, bbt);
+
+	const int64_t beat = min (bbt.beats, s->beats_per_bar);
+
+	return ((int64_t) bbt.bars - s->bar) * s->beats_per_bar + (beat - s->beat);
 }
 
 TempoMetric
@@ -1167,10 +1198,6 @@ TempoMap::metric_at (BBT_Time bbt) const
 void
 TempoMap::bbt_time (framepos_t frame, BBT_Time& bbt)
 {
-	require_map_to (frame);
-
-	Glib::Threads::RWLock::ReaderLock lm (lock);
-
 	if (frame < 0) {
 		bbt.bars = 1;
 		bbt.beats = 1;
@@ -1179,23 +1206,38 @@ TempoMap::bbt_time (framepos_t frame, BBT_Time& bbt)
 		return;
 	}
 
-	return bbt_time (frame, bbt, bbt_before_or_at (frame));
+	bbt_time (*_sections.reader (), frame, bbt);
 }
 
 void
 TempoMap::bbt_time_rt (framepos_t frame, BBT_Time& bbt)
 {
-	Glib::Threads::RWLock::ReaderLock lm (lock, Glib::Threads::TRY_LOCK);
+	bbt_time (*_sections.reader (), frame, bbt);
+}
 
-	if (!lm.locked()) {
-		throw std::logic_error ("TempoMap::bbt_time_rt() could not lock tempo map");
+void
+TempoMap::bbt_time (const Sections& sections, framepos_t frame, BBT_Time& bbt) const
+{
+	if (frame < 0) {
+		bbt.bars = 1;
+		bbt.beats = 1;
+		bbt.ticks = 0;
+		return;
 	}
 
-	if (_map.empty() || _map.back().frame < frame) {
-		throw std::logic_error (string_compose ("map not long enough to reach %1", frame));
-	}
+	Sections::const_iterator s;
+	const int64_t k = beat_before_or_at (sections, frame, s);
+	const framepos_t beat_frame = s->frame_at (k);
+	const BBT_Time beat (s->bbt_at (k));
+
+	bbt.bars = beat.bars;
+	bbt.beats = beat.beats;
 
-	return bbt_time (frame, bbt, bbt_before_or_at (frame));
+	if (beat_frame == frame) {
+		bbt.ticks = 0;
+	} else {
+		bbt.ticks = llrint (((frame - beat_frame) / s->tick_frames) * BBT_Time::ticks_per_beat);
+	}
 }
 
 void
@@ -1214,6 +1256,24 @@ TempoMap::bbt_time (framepos_t frame, BBT_Time& bbt, const BBTPointList::const_i
 	}
 }
 
+framepos_t
+TempoMap::beat_at_or_after_rt (framepos_t pos, BBT_Time& bbt) const
+{
+	boost::shared_ptr<Sections> sections = _sections.reader ();
+	Sections::const_iterator s;
+	int64_t k = beat_before_or_at (*sections, pos, s);
+
+	if (s->frame_at (k) < pos) {
+		const int64_t index = s->index + k + 1;
+		s = section_at_index (*sections, index);
+		k = index - s->index;
+	}
+
+	bbt = s->bbt_at (k);
+
+	return s->frame_at (k);
+}
+
 framepos_t
 TempoMap::frame_time (const BBT_Time& bbt)
 {
@@ -1226,68 +1286,67 @@ TempoMap::frame_time (const BBT_Time& bbt)
 		throw std::logic_error ("beats are counted from one");
 	}
 
-	require_map_to (bbt);
+	boost::shared_ptr<Sections> sections = _sections.reader ();
+	Sections::const_iterator s;
+	const int64_t k = beat_before_or_at (*sections, bbt, s);
 
-	Glib::Threads::RWLock::ReaderLock lm (lock);
-
-	BBTPointList::const_iterator s = bbt_before_or_at (BBT_Time (1, 1, 0));
-	BBTPointList::const_iterator e = bbt_before_or_at (BBT_Time (bbt.bars, bbt.beats, 0));
+	/* the first beat, 1|1, is always at frame zero */
 
 	if (bbt.ticks != 0) {
-		return ((*e).frame - (*s).frame) +
-			llrint ((*e).tempo->frames_per_beat (_frame_rate) * (bbt.ticks/BBT_Time::ticks_per_beat));
+		return s->frame_at (k) + llrint (s->tick_frames * (bbt.ticks/BBT_Time::ticks_per_beat));
 	} else {
-		return ((*e).frame - (*s).frame);
+		return s->frame_at (k);
 	}
 }
 
 framecnt_t
 TempoMap::bbt_duration_at (framepos_t pos, const BBT_Time& bbt, int dir)
 {
+	boost::shared_ptr<Sections> sections = _sections.reader ();
 	BBT_Time when;
-	bbt_time (pos, when);
 
-	Glib::Threads::RWLock::ReaderLock lm (lock);
-	return bbt_duration_at_unlocked (when, bbt, dir);
+	if (pos < 0) {
+		warning << string_compose (_("tempo map asked for BBT time at frame %1\n"), pos) << endmsg;
+	}
+
+	bbt_time (*sections, pos, when);
+
+	return bbt_duration_at_unlocked (*sections, when, bbt, dir);
 }
 
 framecnt_t
-TempoMap::bbt_duration_at_unlocked (const BBT_Time& when, const BBT_Time& bbt, int /*dir*/)
+TempoMap::bbt_duration_at_unlocked (const Sections& sections, const BBT_Time& when, const BBT_Time& bbt, int /*dir*/) const
 {
 	if (bbt.bars == 0 && bbt.beats == 0 && bbt.ticks == 0) {
 		return 0;
 	}
 
 	/* round back to the previous precise beat */
-	BBTPointList::const_iterator wi = bbt_before_or_at (BBT_Time (when.bars, when.beats, 0));
-	BBTPointList::const_iterator start (wi);
-
-	assert (wi != _map.end());
+	Sections::const_iterator s;
+	int64_t k = beat_before_or_at (sections, BBT_Time (when.bars, when.beats, 0), s);
+	const framepos_t start_frame = s->frame_at (k);
+	int64_t index = s->index + k;
 
-	uint32_t bars = 0;
-	uint32_t beats = 0;
+	/* skip to the start of the bbt.bars'th bar after it ... */
 
-	while (wi != _map.end() && bars < bbt.bars) {
-		++wi;
-		if ((*wi).is_bar()) {
-			++bars;
-		}
+	if (bbt.bars > 0) {
+		k = beat_before_or_at (sections, BBT_Time (s->bbt_at (k).bars + bbt.bars, 1, 0), s);
+		index = s->index + k;
 	}
-	assert (wi != _map.end());
 
-	while (wi != _map.end() && beats < bbt.beats) {
-		++wi;
-		++beats;
-	}
-	assert (wi != _map.end());
+	/* ... and then on by bbt.beats */
+
+	index += bbt.beats;
+	s = section_at_index (sections, index);
+	k = index - s->index;
 
 	/* add any additional frames related to ticks in the added value */
 
 	if (bbt.ticks != 0) {
-		return ((*wi).frame - (*start).frame) +
-			(*wi).tempo->frames_per_beat (_frame_rate) * (bbt.ticks/BBT_Time::ticks_per_beat);
+		return (s->frame_at (k) - start_frame) +
+			s->tick_frames * (bbt.ticks/BBT_Time::ticks_per_beat);
 	} else {
-		return ((*wi).frame - (*start).frame);
+		return (s->frame_at (k) - start_frame);
 	}
 }
 
@@ -1306,9 +1365,12 @@ TempoMap::round_to_beat (framepos_t fr, RoundMode dir)
 framepos_t
 TempoMap::round_to_beat_subdivision (framepos_t fr, int sub_num, RoundMode dir)
 {
+	/* extend the map and look it up under the same lock, so that a
+	 * recompute cannot empty it in between.
+	 */
+	Glib::Threads::RWLock::WriterLock lm (lock);
 	require_map_to (fr);
 
-	Glib::Threads::RWLock::ReaderLock lm (lock);
 	BBTPointList::const_iterator i = bbt_before_or_at (fr);
 	BBT_Time the_beat;
 	uint32_t ticks_one_subdivisions_worth;
@@ -1422,9 +1484,12 @@ TempoMap::round_to_beat_subdivision (framepos_t fr, int sub_num, RoundMode dir)
 framepos_t
 TempoMap::round_to_type (framepos_t frame, RoundMode dir, BBTPointType type)
 {
+	/* extend the map and look it up under the same lock, so that a
+	 * recompute cannot empty it in between.
+	 */
+	Glib::Threads::RWLock::WriterLock lm (lock);
 	require_map_to (frame);
 
-	Glib::Threads::RWLock::ReaderLock lm (lock);
 	BBTPointList::const_iterator fi;
 
 	if (dir > 0) {
@@ -1577,7 +1642,7 @@ TempoMap::get_grid (TempoMap::BBTPointList::const_iterator& begin,
 	{
 		Glib::Threads::RWLock::WriterLock lm (lock);
 		if (_map.empty() || (_map.back().frame < upper)) {
-			recompute_map (false, upper);
+			extend_map (upper);
 		}
 	}
 
@@ -1752,7 +1817,7 @@ TempoMap::set_state (const XMLNode& node, int /*version*/)
 			prev = i;
 		}
 
-		recompute_map (true, -1);
+		recompute_map (true);
 	}
 
 	PropertyChanged (PropertyChange ());
@@ -1839,6 +1904,7 @@ TempoMap::insert_time (framepos_t where, framecnt_t amount)
 
 		// cerr << "\n###################### TIMESTAMP via AUDIO ##############\n" << endl;
 
+		boost::shared_ptr<Sections> sections = _sections.reader ();
 		bool first = true;
 		MetricSection* prev = 0;
 
@@ -1855,8 +1921,7 @@ TempoMap::insert_time (framepos_t where, framecnt_t amount)
 				// which is correct for our purpose
 			}
 
-			BBTPointList::const_iterator bi = bbt_before_or_at ((*i)->frame());
-			bbt_time ((*i)->frame(), bbt, bi);
+			bbt_time (*sections, (*i)->frame(), bbt);
 
 			// cerr << "timestamp @ " << (*i)->frame() << " with " << bbt.bars << "|" << bbt.beats << "|" << bbt.ticks << " => ";
 
@@ -2434,27 +2499,6 @@ TempoMap::bbt_before_or_at (framepos_t pos)
 	return i;
 }
 
-struct bbtcmp {
-    bool operator() (const BBT_Time& a, const BBT_Time& b) {
-	    return a < b;
-    }
-};
-
-TempoMap::BBTPointList::const_iterator
-TempoMap::bbt_before_or_at (const BBT_Time& bbt)
-{
-	BBTPointList::const_iterator i;
-	bbtcmp cmp;
-
-	i = lower_bound (_map.begin(), _map.end(), bbt, cmp);
-	assert (i != _map.end());
-	if ((*i).bar > bbt.bars || (*i).beat > bbt.beats) {
-		assert (i != _map.begin());
-		--i;
-	}
-	return i;
-}
-
 TempoMap::BBTPointList::const_iterator
 TempoMap::bbt_after_or_at (framepos_t pos)
 {
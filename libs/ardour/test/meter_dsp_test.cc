@@ -0,0 +1,149 @@
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "ardour/iec1ppmdsp.h"
+#include "ardour/iec2ppmdsp.h"
+#include "ardour/kmeterdsp.h"
+#include "ardour/mix.h"
+#include "ardour/vumeterdsp.h"
+
+#include "meter_dsp_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MeterDSPTest);
+
+using namespace std;
+
+/* an odd channel count, so that the vector kernels also hand some
+ * channels to the scalar code, and an odd cycle length, so that the
+ * meters leave some samples unprocessed.
+ */
+static const int n_channels = 19;
+static const int n_frames   = 1023;
+static const int n_cycles   = 48;
+
+static bool
+identical (float a, float b)
+{
+	return memcmp (&a, &b, sizeof (float)) == 0;
+}
+
+void
+MeterDSPTest::setUp ()
+{
+	Kmeterdsp::init (48000);
+	Iec1ppmdsp::init (48000);
+	Iec2ppmdsp::init (48000);
+	Vumeterdsp::init (48000);
+
+	srand (42);
+
+	_data.assign (n_channels, vector<float> (n_frames * n_cycles));
+
+	for (int c = 0; c < n_channels; ++c) {
+		for (size_t i = 0; i < _data[c].size(); ++i) {
+			/* bursts of noise at various levels, including silence */
+			const float level = (c % 5) * 0.5f * ((i / 3000) % 2);
+			_data[c][i] = level * (2.f * rand () / (float) RAND_MAX - 1.f);
+		}
+	}
+}
+
+/** Run meters one channel at a time and all together through the
+ *  runtime-selected kernel, and check that they read the same.
+ */
+template<class M>
+static void
+compare_meters (vector<vector<float> > const & data)
+{
+	vector<M*> single;
+	vector<M*> multi;
+
+	for (int c = 0; c < n_channels; ++c) {
+		single.push_back (new M);
+		multi.push_back (new M);
+	}
+
+	vector<float const *> bufs (n_channels);
+
+	for (int cycle = 0; cycle < n_cycles; ++cycle) {
+		for (int c = 0; c < n_channels; ++c) {
+			bufs[c] = &data[c][cycle * n_frames];
+			single[c]->process (bufs[c], n_frames);
+		}
+
+		M::process (&multi[0], &bufs[0], n_channels, n_frames);
+
+		if (cycle % 3 == 2) {
+			for (int c = 0; c < n_channels; ++c) {
+				CPPUNIT_ASSERT (identical (single[c]->read (), multi[c]->read ()));
+			}
+		}
+	}
+
+	for (int c = 0; c < n_channels; ++c) {
+		delete single[c];
+		delete multi[c];
+	}
+}
+
+void
+MeterDSPTest::multichannelTest ()
+{
+	compare_meters<Kmeterdsp> (_data);
+	compare_meters<Iec1ppmdsp> (_data);
+	compare_meters<Iec2ppmdsp> (_data);
+	compare_meters<Vumeterdsp> (_data);
+}
+
+/** Check the SSE kernels against the scalar ones on raw filter state */
+void
+MeterDSPTest::kernelTest ()
+{
+#if defined (ARCH_X86) && defined (BUILD_SSE_OPTIMIZATIONS)
+	vector<float const *> bufs (n_channels);
+	vector<float> a1 (n_channels, 0.f), a2 (n_channels, 0.f), am (n_channels, 0.f);
+	vector<float> b1 (n_channels, 0.f), b2 (n_channels, 0.f), bm (n_channels, 0.f);
+
+	for (int cycle = 0; cycle < n_cycles; ++cycle) {
+		for (int c = 0; c < n_channels; ++c) {
+			bufs[c] = &_data[c][cycle * n_frames];
+		}
+		default_kmeter_process (&bufs[0], n_channels, n_frames, 9.72f / 48000, &a1[0], &a2[0]);
+		x86_sse_kmeter_process (&bufs[0], n_channels, n_frames, 9.72f / 48000, &b1[0], &b2[0]);
+	}
+
+	CPPUNIT_ASSERT (memcmp (&a1[0], &b1[0], n_channels * sizeof (float)) == 0);
+	CPPUNIT_ASSERT (memcmp (&a2[0], &b2[0], n_channels * sizeof (float)) == 0);
+
+	a1.assign (n_channels, 0.f); a2.assign (n_channels, 0.f);
+	b1.assign (n_channels, 0.f); b2.assign (n_channels, 0.f);
+
+	for (int cycle = 0; cycle < n_cycles; ++cycle) {
+		for (int c = 0; c < n_channels; ++c) {
+			bufs[c] = &_data[c][cycle * n_frames];
+		}
+		default_ppm_process (&bufs[0], n_channels, n_frames, 450.f / 48000, 1300.f / 48000, 1.f - 5.4f / 48000, &a1[0], &a2[0], &am[0]);
+		x86_sse_ppm_process (&bufs[0], n_channels, n_frames, 450.f / 48000, 1300.f / 48000, 1.f - 5.4f / 48000, &b1[0], &b2[0], &bm[0]);
+	}
+
+	CPPUNIT_ASSERT (memcmp (&a1[0], &b1[0], n_channels * sizeof (float)) == 0);
+	CPPUNIT_ASSERT (memcmp (&a2[0], &b2[0], n_channels * sizeof (float)) == 0);
+	CPPUNIT_ASSERT (memcmp (&am[0], &bm[0], n_channels * sizeof (float)) == 0);
+
+	a1.assign (n_channels, 0.f); a2.assign (n_channels, 0.f); am.assign (n_channels, 0.f);
+	b1.assign (n_channels, 0.f); b2.assign (n_channels, 0.f); bm.assign (n_channels, 0.f);
+
+	for (int cycle = 0; cycle < n_cycles; ++cycle) {
+		for (int c = 0; c < n_channels; ++c) {
+			bufs[c] = &_data[c][cycle * n_frames];
+		}
+		default_vumeter_process (&bufs[0], n_channels, n_frames, 11.1f / 48000, &a1[0], &a2[0], &am[0]);
+		x86_sse_vumeter_process (&bufs[0], n_channels, n_frames, 11.1f / 48000, &b1[0], &b2[0], &bm[0]);
+	}
+
+	CPPUNIT_ASSERT (memcmp (&a1[0], &b1[0], n_channels * sizeof (float)) == 0);
+	CPPUNIT_ASSERT (memcmp (&a2[0], &b2[0], n_channels * sizeof (float)) == 0);
+	CPPUNIT_ASSERT (memcmp (&am[0], &bm[0], n_channels * sizeof (float)) == 0);
+#endif
+}
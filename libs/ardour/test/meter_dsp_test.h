@@ -0,0 +1,21 @@
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class MeterDSPTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (MeterDSPTest);
+	CPPUNIT_TEST (multichannelTest);
+	CPPUNIT_TEST (kernelTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+
+	void multichannelTest ();
+	void kernelTest ();
+
+private:
+	std::vector<std::vector<float> > _data;
+};
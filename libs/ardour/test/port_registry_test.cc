@@ -0,0 +1,71 @@
+#include <cstdio>
+#include <vector>
+
+#include "ardour/audioengine.h"
+#include "ardour/port_engine.h"
+
+#include "port_registry_test.h"
+#include "test_util.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PortRegistryTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+void
+PortRegistryTest::setUp ()
+{
+	create_and_start_dummy_backend ();
+}
+
+void
+PortRegistryTest::tearDown ()
+{
+	stop_and_destroy_backend ();
+}
+
+/** Register and connect a large number of ports directly with the
+ *  backend, and check that they can all be found again.  The timing
+ *  of these steps is measured by the port_registry profiling program.
+ */
+void
+PortRegistryTest::registerAndConnectTest ()
+{
+	PortEngine& port_engine (AudioEngine::instance()->port_engine ());
+
+	int const n_ports = 1000;
+	vector<PortEngine::PortHandle> sources;
+	vector<string> sinks;
+
+	for (int i = 0; i < n_ports; ++i) {
+		char name[64];
+		snprintf (name, sizeof (name), "bench_out_%d", i);
+		PortEngine::PortHandle src = port_engine.register_port (name, DataType::AUDIO, IsOutput);
+		CPPUNIT_ASSERT (src);
+		sources.push_back (src);
+
+		snprintf (name, sizeof (name), "bench_in_%d", i);
+		PortEngine::PortHandle dst = port_engine.register_port (name, DataType::AUDIO, IsInput);
+		CPPUNIT_ASSERT (dst);
+		sinks.push_back (port_engine.get_port_name (dst));
+	}
+
+	for (int i = 0; i < n_ports; ++i) {
+		CPPUNIT_ASSERT_EQUAL (0, port_engine.connect (port_engine.get_port_name (sources[i]), sinks[i]));
+	}
+
+	for (int i = 0; i < n_ports; ++i) {
+		CPPUNIT_ASSERT (port_engine.connected_to (sources[i], sinks[i], false));
+		CPPUNIT_ASSERT (port_engine.get_port_by_name (sinks[i]));
+	}
+
+	vector<string> names;
+	CPPUNIT_ASSERT_EQUAL (n_ports, port_engine.get_ports ("bench_in_", DataType::AUDIO, IsInput, names));
+
+	for (int i = 0; i < n_ports; ++i) {
+		port_engine.unregister_port (sources[i]);
+		port_engine.unregister_port (port_engine.get_port_by_name (sinks[i]));
+	}
+
+	CPPUNIT_ASSERT (!port_engine.get_port_by_name (sinks[0]));
+}
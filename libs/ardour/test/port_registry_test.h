@@ -0,0 +1,15 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class PortRegistryTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (PortRegistryTest);
+	CPPUNIT_TEST (registerAndConnectTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void registerAndConnectTest ();
+};
@@ -0,0 +1,190 @@
+/* Throughput of the lock-free MPMCQueue with several producer threads,
+ * against a RingBuffer with a lock for the writers (which is what the
+ * pools used before), and of allocating from a MultiAllocSingleReleasePool
+ * from several threads.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <pthread.h>
+#include <sched.h>
+
+#include <glib.h>
+#include <glibmm/threads.h>
+
+#include "pbd/mpmc_queue.h"
+#include "pbd/pool.h"
+#include "pbd/ringbuffer.h"
+
+using namespace std;
+using namespace PBD;
+
+static const guint n_producers = 4;
+static guint items_per_producer = 1000000;
+
+/* items carry the producer in the top byte and a sequence number below */
+
+struct QueueStress {
+	MPMCQueue<guint>* queue;
+	RingBuffer<guint>* ring;
+	Glib::Threads::Mutex* ring_lock;
+	Pool* pool;
+	MPMCQueue<void*>* handoff;
+	guint producer;
+};
+
+static void*
+queue_producer (void* arg)
+{
+	QueueStress* s = static_cast<QueueStress*> (arg);
+	guint const tag = s->producer << 24;
+
+	for (guint i = 0; i < items_per_producer; ++i) {
+		while (!s->queue->push (tag | i)) {
+			sched_yield ();
+		}
+	}
+	return 0;
+}
+
+static void*
+ring_producer (void* arg)
+{
+	QueueStress* s = static_cast<QueueStress*> (arg);
+	guint const tag = s->producer << 24;
+
+	for (guint i = 0; i < items_per_producer; ++i) {
+		guint x = tag | i;
+		while (true) {
+			{
+				Glib::Threads::Mutex::Lock lm (*s->ring_lock);
+				if (s->ring->write (&x, 1) == 1) {
+					break;
+				}
+			}
+			sched_yield ();
+		}
+	}
+	return 0;
+}
+
+static void*
+pool_allocator (void* arg)
+{
+	QueueStress* s = static_cast<QueueStress*> (arg);
+
+	for (guint i = 0; i < items_per_producer; ++i) {
+		void* ptr = s->pool->alloc ();
+		while (!s->handoff->push (ptr)) {
+			sched_yield ();
+		}
+	}
+	return 0;
+}
+
+/** Run @a producer in n_producers threads and consume everything they
+ *  send with @a consume.
+ *  @return the time taken in microseconds.
+ */
+template<typename Consumer>
+static gint64
+run (void* (*producer) (void*), QueueStress const & setup, Consumer consume)
+{
+	QueueStress stress[n_producers];
+	pthread_t threads[n_producers];
+	guint const total = n_producers * items_per_producer;
+
+	gint64 const start = g_get_monotonic_time ();
+
+	for (guint p = 0; p < n_producers; ++p) {
+		stress[p] = setup;
+		stress[p].producer = p;
+		pthread_create (&threads[p], 0, producer, &stress[p]);
+	}
+
+	for (guint n = 0; n < total; ) {
+		if (consume ()) {
+			++n;
+		} else {
+			sched_yield ();
+		}
+	}
+
+	for (guint p = 0; p < n_producers; ++p) {
+		pthread_join (threads[p], 0);
+	}
+
+	return g_get_monotonic_time () - start;
+}
+
+struct QueueConsumer {
+	QueueConsumer (MPMCQueue<guint>& q) : queue (q) {}
+	bool operator() () { guint x; return queue.pop (x); }
+	MPMCQueue<guint>& queue;
+};
+
+struct RingConsumer {
+	RingConsumer (RingBuffer<guint>& r) : ring (r) {}
+	bool operator() () { guint x; return ring.read (&x, 1) == 1; }
+	RingBuffer<guint>& ring;
+};
+
+struct PoolConsumer {
+	PoolConsumer (Pool& p, MPMCQueue<void*>& h) : pool (p), handoff (h) {}
+	bool operator() () {
+		void* ptr;
+		if (!handoff.pop (ptr)) {
+			return false;
+		}
+		pool.release (ptr);
+		return true;
+	}
+	Pool& pool;
+	MPMCQueue<void*>& handoff;
+};
+
+int
+main (int argc, char* argv[])
+{
+	if (argc > 1) {
+		items_per_producer = atoi (argv[1]);
+	}
+
+	if (items_per_producer == 0 || items_per_producer >= (1 << 24)) {
+		cerr << argv[0] << ": [<items per producer thread>]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	guint const total = n_producers * items_per_producer;
+
+	MPMCQueue<guint> queue (1024);
+	RingBuffer<guint> ring (1024);
+	Glib::Threads::Mutex ring_lock;
+
+	QueueStress setup = QueueStress ();
+	setup.queue = &queue;
+	setup.ring = &ring;
+	setup.ring_lock = &ring_lock;
+
+	gint64 const queue_time = run (queue_producer, setup, QueueConsumer (queue));
+	gint64 const ring_time = run (ring_producer, setup, RingConsumer (ring));
+
+	/* the hand-off queue is small enough that the pool can never run dry */
+
+	guint const n_items = 200;
+	MultiAllocSingleReleasePool pool ("benchmark", sizeof (gint), n_items);
+	MPMCQueue<void*> handoff (n_items / 2);
+
+	setup.pool = &pool;
+	setup.handoff = &handoff;
+
+	gint64 const pool_time = run (pool_allocator, setup, PoolConsumer (pool, handoff));
+
+	cout << total << " items from " << n_producers << " threads: MPMCQueue "
+	     << queue_time / 1000 << " ms, locked RingBuffer " << ring_time / 1000 << " ms" << endl
+	     << total << " pool allocations from " << n_producers << " threads: "
+	     << pool_time / 1000 << " ms" << endl;
+
+	return 0;
+}
@@ -0,0 +1,83 @@
+/* Time registering, connecting, looking up and unregistering a large
+ * number of ports directly with the dummy backend.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <glib.h>
+
+#include "ardour/ardour.h"
+#include "ardour/audioengine.h"
+#include "ardour/port_engine.h"
+
+#include "test_util.h"
+
+using namespace std;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+int
+main (int argc, char* argv[])
+{
+	int const n_ports = argc > 1 ? atoi (argv[1]) : 10000;
+
+	if (n_ports <= 0) {
+		cerr << argv[0] << ": [<number of port pairs>]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	ARDOUR::init (false, true, localedir);
+
+	create_and_start_dummy_backend ();
+
+	PortEngine& port_engine (AudioEngine::instance()->port_engine ());
+
+	vector<PortEngine::PortHandle> sources;
+	vector<string> sinks;
+
+	gint64 const start = g_get_monotonic_time ();
+
+	for (int i = 0; i < n_ports; ++i) {
+		char name[64];
+		snprintf (name, sizeof (name), "bench_out_%d", i);
+		sources.push_back (port_engine.register_port (name, DataType::AUDIO, IsOutput));
+
+		snprintf (name, sizeof (name), "bench_in_%d", i);
+		sinks.push_back (port_engine.get_port_name (port_engine.register_port (name, DataType::AUDIO, IsInput)));
+	}
+
+	gint64 const registered = g_get_monotonic_time ();
+
+	for (int i = 0; i < n_ports; ++i) {
+		port_engine.connect (port_engine.get_port_name (sources[i]), sinks[i]);
+	}
+
+	gint64 const connected = g_get_monotonic_time ();
+
+	for (int i = 0; i < n_ports; ++i) {
+		port_engine.connected_to (sources[i], sinks[i], false);
+		port_engine.get_port_by_name (sinks[i]);
+	}
+
+	gint64 const looked_up = g_get_monotonic_time ();
+
+	for (int i = 0; i < n_ports; ++i) {
+		port_engine.unregister_port (sources[i]);
+		port_engine.unregister_port (port_engine.get_port_by_name (sinks[i]));
+	}
+
+	gint64 const unregistered = g_get_monotonic_time ();
+
+	cout << "Registered " << 2 * n_ports << " ports in " << (registered - start) / 1000.0 << " ms" << endl
+	     << "Connected " << n_ports << " port pairs in " << (connected - registered) / 1000.0 << " ms" << endl
+	     << "Checked " << n_ports << " connections in " << (looked_up - connected) / 1000.0 << " ms" << endl
+	     << "Unregistered " << 2 * n_ports << " ports in " << (unregistered - looked_up) / 1000.0 << " ms" << endl;
+
+	stop_and_destroy_backend ();
+
+	return 0;
+}
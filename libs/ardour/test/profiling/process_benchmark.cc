@@ -0,0 +1,546 @@
+/*
+    Copyright (C) 2016 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/* Headless benchmark of the realtime process cycle.
+ *
+ * A synthetic session with a given number of tracks, plugins and
+ * automation lanes is created on the dummy backend, and run for a fixed
+ * number of cycles. Cycles are driven through the engine's Freewheel
+ * signal (as export does), so they run back to back and are each timed
+ * individually. The results are written as JSON.
+ */
+
+#include <getopt.h>
+#include <stdlib.h>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <vector>
+#include <algorithm>
+
+#include <glib.h>
+#include <glibmm/miscutils.h>
+
+#include "pbd/failed_constructor.h"
+#include "pbd/semutils.h"
+
+#include "ardour/ardour.h"
+#include "ardour/audio_track.h"
+#include "ardour/audioengine.h"
+#include "ardour/audioregion.h"
+#include "ardour/automation_control.h"
+#include "ardour/automation_list.h"
+#include "ardour/butler.h"
+#include "ardour/dsp_load_calculator.h"
+#include "ardour/pannable.h"
+#include "ardour/playlist.h"
+#include "ardour/plugin_insert.h"
+#include "ardour/plugin_manager.h"
+#include "ardour/region_factory.h"
+#include "ardour/session.h"
+#include "ardour/session_directory.h"
+#include "ardour/sndfilesource.h"
+#include "ardour/source_factory.h"
+
+#include "test_util.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+static const char* localedir = LOCALEDIR;
+
+/* Allocation counting. operator new is replaced for the whole program,
+ * and counts allocations made by process threads while a cycle is being
+ * measured.
+ */
+
+static gint counting_allocations = 0;
+static gint allocations = 0;
+
+static inline void
+count_allocation ()
+{
+	if (g_atomic_int_get (&counting_allocations) && AudioEngine::instance()->in_process_thread ()) {
+		g_atomic_int_inc (&allocations);
+	}
+}
+
+#if __cplusplus >= 201103L
+void* operator new (size_t size)
+#else
+void* operator new (size_t size) throw (std::bad_alloc)
+#endif
+{
+	count_allocation ();
+	void* p = malloc (size ? size : 1);
+	if (!p) {
+		throw std::bad_alloc ();
+	}
+	return p;
+}
+
+#if __cplusplus >= 201103L
+void operator delete (void* p) noexcept
+#else
+void operator delete (void* p) throw ()
+#endif
+{
+	free (p);
+}
+
+/* Benchmark */
+
+struct Options {
+	Options ()
+		: tracks (16)
+		, plugins (0)
+		, automation_lanes (0)
+		, cycles (10000)
+		, warmup_cycles (100)
+		, buffer_size (0)
+	{}
+
+	uint32_t tracks;
+	uint32_t plugins;
+	uint32_t automation_lanes;
+	uint32_t cycles;
+	uint32_t warmup_cycles;
+	uint32_t buffer_size;
+	string   plugin;
+	string   output;
+};
+
+class Benchmark
+{
+  public:
+	Benchmark (Session& s, Options const & o)
+		: session (s)
+		, options (o)
+		, cycle (0)
+		, done ("benchmark done", 0)
+	{
+		/* no allocation while measuring */
+		elapsed.reserve (options.cycles);
+		cycle_allocations.reserve (options.cycles);
+		dsp_calc.set_max_time (session.engine().sample_rate(), session.engine().samples_per_cycle());
+	}
+
+	void run ();
+	void report (ostream&) const;
+
+  private:
+	Session&        session;
+	Options const & options;
+	uint32_t        cycle;
+	Semaphore       done;
+
+	DSPLoadCalculator dsp_calc;
+	vector<int64_t>   elapsed;
+	vector<int>       cycle_allocations;
+	Butler::RefillStats refill_stats;
+
+	PBD::ScopedConnection freewheel_connection;
+
+	int process (pframes_t nframes);
+	static double percentile (vector<int64_t> const & sorted, double p);
+};
+
+int
+Benchmark::process (pframes_t nframes)
+{
+	if (cycle >= options.warmup_cycles + options.cycles) {
+		return 0;
+	}
+
+	/* we run faster than realtime, so wait for disk i/o to catch up
+	 * before each cycle, as export does
+	 */
+	session.butler()->wait_until_finished ();
+
+	if (cycle == options.warmup_cycles) {
+		session.butler()->reset_refill_stats ();
+	}
+
+	bool const measure = cycle >= options.warmup_cycles;
+
+	if (measure) {
+		g_atomic_int_set (&allocations, 0);
+		g_atomic_int_set (&counting_allocations, 1);
+		dsp_calc.set_start_timestamp_us (g_get_monotonic_time ());
+	}
+
+	session.process (nframes);
+
+	if (measure) {
+		dsp_calc.set_stop_timestamp_us (g_get_monotonic_time ());
+		g_atomic_int_set (&counting_allocations, 0);
+		elapsed.push_back (dsp_calc.elapsed_time_us ());
+		cycle_allocations.push_back (g_atomic_int_get (&allocations));
+	}
+
+	if (++cycle == options.warmup_cycles + options.cycles) {
+		refill_stats = session.butler()->refill_stats ();
+		done.signal ();
+	}
+
+	return 0;
+}
+
+void
+Benchmark::run ()
+{
+	session.engine().Freewheel.connect_same_thread (freewheel_connection, boost::bind (&Benchmark::process, this, _1));
+
+	session.request_locate (0, true);
+	session.engine().freewheel (true);
+
+	done.wait ();
+
+	session.engine().freewheel (false);
+	freewheel_connection.disconnect ();
+	session.request_stop ();
+}
+
+double
+Benchmark::percentile (vector<int64_t> const & sorted, double p)
+{
+	if (sorted.empty ()) {
+		return 0;
+	}
+	size_t const n = std::min (sorted.size () - 1, (size_t) floor (p * (sorted.size () - 1) + 0.5));
+	return sorted[n];
+}
+
+void
+Benchmark::report (ostream& out) const
+{
+	vector<int64_t> sorted (elapsed);
+	std::sort (sorted.begin (), sorted.end ());
+
+	double const nominal_us = dsp_calc.get_max_time_us ();
+
+	int64_t total_us = 0;
+	uint32_t overruns = 0;
+	for (vector<int64_t>::const_iterator i = sorted.begin (); i != sorted.end (); ++i) {
+		total_us += *i;
+		if (*i > nominal_us) {
+			++overruns;
+		}
+	}
+
+	uint64_t total_allocations = 0;
+	uint32_t allocating_cycles = 0;
+	for (vector<int>::const_iterator i = cycle_allocations.begin (); i != cycle_allocations.end (); ++i) {
+		total_allocations += *i;
+		if (*i) {
+			++allocating_cycles;
+		}
+	}
+
+	double const mean_us = sorted.empty () ? 0 : (double) total_us / sorted.size ();
+	double const percentiles[] = { 0.5, 0.9, 0.99, 0.999 };
+	char const * names[] = { "p50", "p90", "p99", "p999" };
+
+	out << "{\n"
+	    << "  \"config\": {\n"
+	    << "    \"tracks\": " << options.tracks << ",\n"
+	    << "    \"plugins_per_track\": " << options.plugins << ",\n"
+	    << "    \"plugin\": \"" << options.plugin << "\",\n"
+	    << "    \"automation_lanes_per_track\": " << options.automation_lanes << ",\n"
+	    << "    \"cycles\": " << sorted.size () << ",\n"
+	    << "    \"sample_rate\": " << session.engine().sample_rate() << ",\n"
+	    << "    \"buffer_size\": " << session.engine().samples_per_cycle() << "\n"
+	    << "  },\n"
+	    << "  \"dsp_time_us\": {\n"
+	    << "    \"nominal\": " << nominal_us << ",\n"
+	    << "    \"mean\": " << mean_us << ",\n"
+	    << "    \"min\": " << (sorted.empty () ? 0 : sorted.front ()) << ",\n";
+	for (size_t i = 0; i < sizeof (percentiles) / sizeof (percentiles[0]); ++i) {
+		out << "    \"" << names[i] << "\": " << percentile (sorted, percentiles[i]) << ",\n";
+	}
+	out << "    \"max\": " << (sorted.empty () ? 0 : sorted.back ()) << "\n"
+	    << "  },\n"
+	    << "  \"dsp_load_percent\": {\n"
+	    << "    \"mean\": " << 100.0 * mean_us / nominal_us << ",\n";
+	for (size_t i = 0; i < sizeof (percentiles) / sizeof (percentiles[0]); ++i) {
+		out << "    \"" << names[i] << "\": " << 100.0 * percentile (sorted, percentiles[i]) / nominal_us << ",\n";
+	}
+	out << "    \"max\": " << (sorted.empty () ? 0 : 100.0 * sorted.back () / nominal_us) << ",\n"
+	    << "    \"overruns\": " << overruns << "\n"
+	    << "  },\n"
+	    << "  \"butler_refill\": {\n"
+	    << "    \"runs\": " << refill_stats.runs << ",\n"
+	    << "    \"total_us\": " << refill_stats.total_us << ",\n"
+	    << "    \"mean_us\": " << (refill_stats.runs ? (double) refill_stats.total_us / refill_stats.runs : 0) << ",\n"
+	    << "    \"max_us\": " << refill_stats.max_us << "\n"
+	    << "  },\n"
+	    << "  \"allocations\": {\n"
+	    << "    \"total\": " << total_allocations << ",\n"
+	    << "    \"cycles_with_allocations\": " << allocating_cycles << "\n"
+	    << "  }\n"
+	    << "}\n";
+}
+
+/* Session setup */
+
+static PluginInfoPtr
+find_plugin (string const & name)
+{
+	PluginManager& manager (PluginManager::instance ());
+	manager.refresh (true);
+
+	PluginInfoList* lists[] = { &manager.lv2_plugin_info (), &manager.ladspa_plugin_info () };
+
+	for (size_t n = 0; n < sizeof (lists) / sizeof (lists[0]); ++n) {
+		for (PluginInfoList::const_iterator i = lists[n]->begin (); i != lists[n]->end (); ++i) {
+			if ((*i)->name == name || (*i)->unique_id == name) {
+				return *i;
+			}
+		}
+	}
+
+	return PluginInfoPtr ();
+}
+
+/** Write a mono source with a test signal long enough for the whole run,
+ *  and give every track a region of it.
+ */
+static void
+add_regions (Session& session, list<boost::shared_ptr<AudioTrack> > const & tracks, framecnt_t length)
+{
+	string const path = Glib::build_filename (session.session_directory().sound_path(), "benchmark.wav");
+	boost::shared_ptr<Source> source = SourceFactory::createWritable (DataType::AUDIO, session, path, false, session.frame_rate ());
+	boost::shared_ptr<SndFileSource> s = boost::dynamic_pointer_cast<SndFileSource> (source);
+	assert (s);
+
+	framecnt_t const chunk = 8192;
+	vector<Sample> signal (chunk);
+	for (framecnt_t written = 0; written < length; written += chunk) {
+		for (framecnt_t i = 0; i < chunk; ++i) {
+			signal[i] = 0.5f * sinf (2.f * M_PI * 440.f * (written + i) / session.frame_rate ());
+		}
+		s->write (&signal[0], chunk);
+	}
+	s->flush ();
+	s->flush_header ();
+
+	PropertyList plist;
+	plist.add (Properties::start, 0);
+	plist.add (Properties::length, length);
+
+	for (list<boost::shared_ptr<AudioTrack> >::const_iterator t = tracks.begin (); t != tracks.end (); ++t) {
+		boost::shared_ptr<Region> region = RegionFactory::create (source, plist);
+		(*t)->playlist()->add_region (region, 0);
+	}
+}
+
+static void
+add_plugins (Session& session, boost::shared_ptr<Route> route, PluginInfoPtr info, uint32_t count)
+{
+	for (uint32_t i = 0; i < count; ++i) {
+		PluginPtr plugin = info->load (session);
+		if (!plugin) {
+			throw failed_constructor ();
+		}
+		boost::shared_ptr<Processor> insert (new PluginInsert (session, plugin));
+		if (route->add_processor (insert, PreFader)) {
+			throw failed_constructor ();
+		}
+	}
+}
+
+/** Give up to @a count controls of @a route automation which keeps moving
+ *  through the whole run.
+ */
+static uint32_t
+add_automation (boost::shared_ptr<Route> route, uint32_t count, framecnt_t length, framecnt_t rate)
+{
+	vector<boost::shared_ptr<AutomationControl> > controls;
+
+	controls.push_back (route->gain_control ());
+	controls.push_back (route->trim_control ());
+	if (route->pannable ()) {
+		controls.push_back (route->pannable()->pan_azimuth_control);
+		controls.push_back (route->pannable()->pan_width_control);
+	}
+
+	for (uint32_t n = 0; ; ++n) {
+		boost::shared_ptr<PluginInsert> insert = boost::dynamic_pointer_cast<PluginInsert> (route->nth_plugin (n));
+		if (!insert) {
+			break;
+		}
+		set<Evoral::Parameter> const & params (insert->what_can_be_automated ());
+		for (set<Evoral::Parameter>::const_iterator p = params.begin (); p != params.end (); ++p) {
+			controls.push_back (insert->automation_control (*p, true));
+		}
+	}
+
+	uint32_t added = 0;
+
+	for (vector<boost::shared_ptr<AutomationControl> >::const_iterator c = controls.begin (); c != controls.end () && added < count; ++c) {
+		if (!(*c) || !(*c)->alist ()) {
+			continue;
+		}
+		boost::shared_ptr<AutomationList> list = (*c)->alist ();
+		double const lower = (*c)->lower ();
+		double const range = (*c)->upper () - lower;
+
+		/* a ramp up or down every 100ms */
+		for (framecnt_t when = 0, i = 0; when < length; when += rate / 10, ++i) {
+			list->add (when, lower + range * ((i % 2) ? 0.75 : 0.25), false);
+		}
+		list->set_automation_state (Play);
+		++added;
+	}
+
+	return added;
+}
+
+static void
+usage (char const * name)
+{
+	cerr << "Usage: " << name << " [options]\n"
+	     << "  -t, --tracks <n>          number of mono audio tracks (default 16)\n"
+	     << "  -P, --plugin <name|uri>   plugin to add to each track\n"
+	     << "  -p, --plugins <n>         number of plugins per track (default 0)\n"
+	     << "  -a, --automation <n>      automation lanes per track (default 0)\n"
+	     << "  -c, --cycles <n>          number of measured cycles (default 10000)\n"
+	     << "  -w, --warmup <n>          cycles to run before measuring (default 100)\n"
+	     << "  -b, --buffer-size <n>     engine buffer size (default: backend default)\n"
+	     << "  -o, --output <file>       write results to <file> instead of stdout\n";
+}
+
+int
+main (int argc, char* argv[])
+{
+	Options options;
+
+	static struct option long_options[] = {
+		{ "tracks", required_argument, 0, 't' },
+		{ "plugin", required_argument, 0, 'P' },
+		{ "plugins", required_argument, 0, 'p' },
+		{ "automation", required_argument, 0, 'a' },
+		{ "cycles", required_argument, 0, 'c' },
+		{ "warmup", required_argument, 0, 'w' },
+		{ "buffer-size", required_argument, 0, 'b' },
+		{ "output", required_argument, 0, 'o' },
+		{ "help", no_argument, 0, 'h' },
+		{ 0, 0, 0, 0 }
+	};
+
+	int c;
+	while ((c = getopt_long (argc, argv, "t:P:p:a:c:w:b:o:h", long_options, 0)) != -1) {
+		switch (c) {
+		case 't': options.tracks = atoi (optarg); break;
+		case 'P': options.plugin = optarg; break;
+		case 'p': options.plugins = atoi (optarg); break;
+		case 'a': options.automation_lanes = atoi (optarg); break;
+		case 'c': options.cycles = atoi (optarg); break;
+		case 'w': options.warmup_cycles = atoi (optarg); break;
+		case 'b': options.buffer_size = atoi (optarg); break;
+		case 'o': options.output = optarg; break;
+		default:
+			usage (argv[0]);
+			exit (c == 'h' ? EXIT_SUCCESS : EXIT_FAILURE);
+		}
+	}
+
+	if (options.cycles == 0 || (options.plugins > 0 && options.plugin.empty ())) {
+		usage (argv[0]);
+		exit (EXIT_FAILURE);
+	}
+
+	ARDOUR::init (false, true, localedir);
+
+	create_and_start_dummy_backend ();
+
+	AudioEngine* engine = AudioEngine::instance ();
+	if (options.buffer_size && engine->set_buffer_size (options.buffer_size)) {
+		cerr << "Cannot set buffer size to " << options.buffer_size << "\n";
+		exit (EXIT_FAILURE);
+	}
+
+	PluginInfoPtr plugin_info;
+	if (options.plugins > 0) {
+		plugin_info = find_plugin (options.plugin);
+		if (!plugin_info) {
+			cerr << "Plugin '" << options.plugin << "' not found.\n";
+			exit (EXIT_FAILURE);
+		}
+	}
+
+	string const session_dir = Glib::build_filename (new_test_output_dir ("process_benchmark"), "benchmark");
+	Session* session = 0;
+
+	try {
+		session = load_session (session_dir, "benchmark");
+
+		list<boost::shared_ptr<AudioTrack> > tracks = session->new_audio_track (1, 2, Normal, 0, options.tracks);
+		if (tracks.size () != options.tracks) {
+			cerr << "Could only create " << tracks.size () << " tracks.\n";
+			exit (EXIT_FAILURE);
+		}
+
+		framecnt_t const length = (framecnt_t) (options.warmup_cycles + options.cycles + 1) * engine->samples_per_cycle ();
+		add_regions (*session, tracks, length);
+
+		for (list<boost::shared_ptr<AudioTrack> >::const_iterator t = tracks.begin (); t != tracks.end (); ++t) {
+			if (plugin_info) {
+				add_plugins (*session, *t, plugin_info, options.plugins);
+			}
+			uint32_t const lanes = add_automation (*t, options.automation_lanes, length, session->frame_rate ());
+			if (lanes < options.automation_lanes) {
+				cerr << "Only " << lanes << " automation lanes are available per track.\n";
+				exit (EXIT_FAILURE);
+			}
+		}
+	} catch (failed_constructor& e) {
+		cerr << "failed to set up the session.\n";
+		exit (EXIT_FAILURE);
+	} catch (AudioEngine::PortRegistrationFailure& e) {
+		cerr << "PortRegistrationFailure: " << e.what() << "\n";
+		exit (EXIT_FAILURE);
+	} catch (exception& e) {
+		cerr << "exception: " << e.what() << "\n";
+		exit (EXIT_FAILURE);
+	}
+
+	Benchmark benchmark (*session, options);
+	benchmark.run ();
+
+	if (options.output.empty ()) {
+		benchmark.report (cout);
+	} else {
+		ofstream out (options.output.c_str ());
+		benchmark.report (out);
+		if (!out) {
+			cerr << "Could not write results to " << options.output << "\n";
+			exit (EXIT_FAILURE);
+		}
+	}
+
+	engine->remove_session ();
+	delete session;
+	stop_and_destroy_backend ();
+
+	return 0;
+}
@@ -48,3 +48,204 @@ TempoTest::recomputeMapTest ()
 	--i;
 	CPPUNIT_ASSERT_EQUAL (framepos_t (288e3), (*i)->frame ());
 }
+
+/* 4/4 at 120bpm for three bars, then 3/4 at 240bpm from bar 4, as in
+ * recomputeMapTest.
+ */
+static void
+setup_map (TempoMap& map)
+{
+	map.add_meter (Meter (4, 4), BBT_Time (1, 1, 0));
+	map.add_tempo (Tempo (120), BBT_Time (1, 1, 0));
+	map.add_tempo (Tempo (240), BBT_Time (4, 1, 0));
+	map.add_meter (Meter (3, 4), BBT_Time (4, 1, 0));
+}
+
+void
+TempoTest::bbtTimeTest ()
+{
+	TempoMap map (48000);
+	setup_map (map);
+
+	CPPUNIT_ASSERT_EQUAL (framepos_t (0), map.frame_time (BBT_Time (1, 1, 0)));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (96000), map.frame_time (BBT_Time (2, 1, 0)));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (150000), map.frame_time (BBT_Time (2, 3, 480)));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (264000), map.frame_time (BBT_Time (3, 4, 0)));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (288000), map.frame_time (BBT_Time (4, 1, 0)));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (306000), map.frame_time (BBT_Time (4, 2, 960)));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (324000), map.frame_time (BBT_Time (5, 1, 0)));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (384000), map.frame_time (BBT_Time (6, 3, 0)));
+
+	/* a beat past the end of a bar means its last beat */
+	CPPUNIT_ASSERT_EQUAL (framepos_t (348000), map.frame_time (BBT_Time (5, 4, 0)));
+
+	BBT_Time bbt;
+
+	map.bbt_time (0, bbt);
+	CPPUNIT_ASSERT_EQUAL (BBT_Time (1, 1, 0), bbt);
+	map.bbt_time (12000, bbt);
+	CPPUNIT_ASSERT_EQUAL (BBT_Time (1, 1, 960), bbt);
+	map.bbt_time (287999, bbt);
+	CPPUNIT_ASSERT_EQUAL (uint32_t (3), bbt.bars);
+	CPPUNIT_ASSERT_EQUAL (uint32_t (4), bbt.beats);
+	map.bbt_time (288000, bbt);
+	CPPUNIT_ASSERT_EQUAL (BBT_Time (4, 1, 0), bbt);
+	map.bbt_time (306000, bbt);
+	CPPUNIT_ASSERT_EQUAL (BBT_Time (4, 2, 960), bbt);
+	map.bbt_time (348000, bbt);
+	CPPUNIT_ASSERT_EQUAL (BBT_Time (5, 3, 0), bbt);
+
+	map.bbt_time_rt (306000, bbt);
+	CPPUNIT_ASSERT_EQUAL (BBT_Time (4, 2, 960), bbt);
+
+	/* round trips across both sections */
+	for (framepos_t f = 0; f < 1000000; f += 1500) {
+		map.bbt_time (f, bbt);
+		CPPUNIT_ASSERT_EQUAL (f, map.frame_time (bbt));
+	}
+
+	for (uint32_t bars = 1; bars < 10; ++bars) {
+		for (uint32_t beats = 1; beats <= (bars < 4 ? 4 : 3); ++beats) {
+			const BBT_Time in (bars, beats, 0);
+			map.bbt_time (map.frame_time (in), bbt);
+			CPPUNIT_ASSERT_EQUAL (in, bbt);
+		}
+	}
+
+	/* beat positions follow a later tempo change */
+	map.add_tempo (Tempo (60), BBT_Time (2, 1, 0));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (96000), map.frame_time (BBT_Time (2, 1, 0)));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (144000), map.frame_time (BBT_Time (2, 2, 0)));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (288000), map.frame_time (BBT_Time (3, 1, 0)));
+	map.bbt_time (144000, bbt);
+	CPPUNIT_ASSERT_EQUAL (BBT_Time (2, 2, 0), bbt);
+}
+
+void
+TempoTest::bbtDurationTest ()
+{
+	TempoMap map (48000);
+	setup_map (map);
+
+	CPPUNIT_ASSERT_EQUAL (framecnt_t (0), map.bbt_duration_at (0, BBT_Time (0, 0, 0), 1));
+	CPPUNIT_ASSERT_EQUAL (framecnt_t (96000), map.bbt_duration_at (0, BBT_Time (1, 0, 0), 1));
+	CPPUNIT_ASSERT_EQUAL (framecnt_t (24000), map.bbt_duration_at (0, BBT_Time (0, 1, 0), 1));
+
+	/* bars are counted to the start of the next bar, across the meter change */
+	CPPUNIT_ASSERT_EQUAL (framecnt_t (192000), map.bbt_duration_at (96000, BBT_Time (2, 0, 0), 1));
+	CPPUNIT_ASSERT_EQUAL (framecnt_t (24000), map.bbt_duration_at (264000, BBT_Time (1, 0, 0), 1));
+
+	/* beats and ticks across the tempo change */
+	CPPUNIT_ASSERT_EQUAL (framecnt_t (36000), map.bbt_duration_at (264000, BBT_Time (0, 2, 0), 1));
+	CPPUNIT_ASSERT_EQUAL (framecnt_t (48000), map.bbt_duration_at (288000, BBT_Time (1, 1, 0), 1));
+	CPPUNIT_ASSERT_EQUAL (framecnt_t (6000), map.bbt_duration_at (288000, BBT_Time (0, 0, 960), 1));
+
+	/* the position is rounded back to its beat */
+	CPPUNIT_ASSERT_EQUAL (framecnt_t (36000), map.bbt_duration_at (270000, BBT_Time (0, 2, 0), 1));
+
+	/* durations agree with frame_time () */
+	for (uint32_t bars = 1; bars < 8; ++bars) {
+		const framepos_t start = map.frame_time (BBT_Time (bars, 1, 0));
+		CPPUNIT_ASSERT_EQUAL (map.frame_time (BBT_Time (bars + 2, 2, 0)) - start,
+		                      map.bbt_duration_at (start, BBT_Time (2, 1, 0), 1));
+	}
+}
+
+void
+TempoTest::gridTest ()
+{
+	TempoMap map (48000);
+	setup_map (map);
+
+	/* a tempo change within a bar, and a meter change at a later bar */
+	map.add_tempo (Tempo (60), BBT_Time (6, 2, 0));
+	map.add_meter (Meter (5, 8), BBT_Time (8, 1, 0));
+
+	TempoMap::BBTPointList::const_iterator begin;
+	TempoMap::BBTPointList::const_iterator end;
+
+	map.get_grid (begin, end, 0, 2000000);
+
+	CPPUNIT_ASSERT (begin != end);
+	CPPUNIT_ASSERT_EQUAL (framepos_t (0), (*begin).frame);
+	CPPUNIT_ASSERT_EQUAL (BBT_Time (1, 1, 0), (*begin).bbt());
+
+	/* the grid is the beat-by-beat walk: each beat follows the previous
+	 * one by the length of a beat of its own tempo and meter.
+	 */
+
+	BBT_Time expected (1, 1, 0);
+	framepos_t last_frame = -1;
+	bool seen_meter = false;
+
+	for (TempoMap::BBTPointList::const_iterator i = begin; i != end; ++i) {
+
+		CPPUNIT_ASSERT_EQUAL (expected, (*i).bbt());
+		CPPUNIT_ASSERT ((*i).frame > last_frame);
+
+		BBT_Time bbt;
+		map.bbt_time ((*i).frame, bbt);
+		CPPUNIT_ASSERT_EQUAL ((*i).bbt(), bbt);
+		CPPUNIT_ASSERT_EQUAL ((*i).frame, map.frame_time ((*i).bbt()));
+
+		TempoMap::BBTPointList::const_iterator n = i;
+		++n;
+
+		if (n != end && (*n).tempo == (*i).tempo && (*n).meter == (*i).meter) {
+			CPPUNIT_ASSERT_EQUAL ((framecnt_t) llrint ((*i).meter->frames_per_grid (*(*i).tempo, 48000)),
+			                      (*n).frame - (*i).frame);
+		}
+
+		if ((*i).meter->divisions_per_bar() == 5) {
+			seen_meter = true;
+		}
+
+		last_frame = (*i).frame;
+
+		if (expected.beats >= (*i).meter->divisions_per_bar()) {
+			expected.bars++;
+			expected.beats = 1;
+		} else {
+			expected.beats++;
+		}
+	}
+
+	CPPUNIT_ASSERT (seen_meter);
+
+	/* 6|2 is a beat at 240bpm after 6|1, and 6|3 one at 60bpm after 6|2 */
+	CPPUNIT_ASSERT_EQUAL (framepos_t (372000), map.frame_time (BBT_Time (6, 2, 0)));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (420000), map.frame_time (BBT_Time (6, 3, 0)));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (372000), map.tempo_section_at (400000).frame());
+	CPPUNIT_ASSERT_EQUAL (framepos_t (288000), map.tempo_section_at (371999).frame());
+
+	/* 5/8 at 60bpm: 24000 frames per eighth */
+	CPPUNIT_ASSERT_EQUAL (framepos_t (24000), map.frame_time (BBT_Time (8, 2, 0)) - map.frame_time (BBT_Time (8, 1, 0)));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (5 * 24000), map.frame_time (BBT_Time (9, 1, 0)) - map.frame_time (BBT_Time (8, 1, 0)));
+}
+
+void
+TempoTest::roundTest ()
+{
+	TempoMap map (48000);
+	setup_map (map);
+
+	CPPUNIT_ASSERT_EQUAL (framepos_t (96000), map.round_to_bar (100000, RoundNearest));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (192000), map.round_to_bar (100000, RoundUpAlways));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (96000), map.round_to_bar (100000, RoundDownAlways));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (288000), map.round_to_bar (280000, RoundNearest));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (324000), map.round_to_bar (300000, RoundUpAlways));
+
+	CPPUNIT_ASSERT_EQUAL (framepos_t (312000), map.round_to_beat (300001, RoundUpAlways));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (300000), map.round_to_beat (300001, RoundNearest));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (264000), map.round_to_beat (270000, RoundDownAlways));
+
+	CPPUNIT_ASSERT_EQUAL (framepos_t (306000), map.round_to_beat_subdivision (305000, 2, RoundNearest));
+
+	/* rounding far beyond what has been looked at so far */
+	CPPUNIT_ASSERT_EQUAL (map.frame_time (BBT_Time (1001, 1, 0)), map.round_to_bar (map.frame_time (BBT_Time (1001, 1, 0)) + 1000, RoundNearest));
+
+	/* and after the map has changed */
+	map.add_tempo (Tempo (60), BBT_Time (2, 1, 0));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (144000), map.round_to_beat (150000, RoundNearest));
+	CPPUNIT_ASSERT_EQUAL (framepos_t (288000), map.round_to_bar (250000, RoundNearest));
+}
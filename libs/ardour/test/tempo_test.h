@@ -6,6 +6,10 @@ class TempoTest : public CppUnit::TestFixture
 {
 	CPPUNIT_TEST_SUITE (TempoTest);
 	CPPUNIT_TEST (recomputeMapTest);
+	CPPUNIT_TEST (bbtTimeTest);
+	CPPUNIT_TEST (bbtDurationTest);
+	CPPUNIT_TEST (gridTest);
+	CPPUNIT_TEST (roundTest);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -13,5 +17,9 @@ public:
 	void tearDown () {}
 
 	void recomputeMapTest ();
+	void bbtTimeTest ();
+	void bbtDurationTest ();
+	void gridTest ();
+	void roundTest ();
 };
 
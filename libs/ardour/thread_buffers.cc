@@ -27,7 +27,7 @@
 using namespace ARDOUR;
 using namespace std;
 
-ThreadBuffers::ThreadBuffers ()
+ThreadBuffers::ThreadBuffers (uint32_t idx)
 	: silent_buffers (new BufferSet)
 	, scratch_buffers (new BufferSet)
 	, route_buffers (new BufferSet)
@@ -37,6 +37,7 @@ ThreadBuffers::ThreadBuffers ()
 	, send_gain_automation_buffer (0)
 	, pan_automation_buffer (0)
 	, npan_buffers (0)
+	, index (idx)
 {
 }
 
@@ -49,10 +49,10 @@ TransientDetector::operational_identifier()
 }
 
 int
-TransientDetector::run (const std::string& path, Readable* src, uint32_t channel, AnalysisFeatureList& results)
+TransientDetector::run (const std::string& path, Readable* src, uint32_t channel, AnalysisFeatureList& results, Progress* progress)
 {
 	current_results = &results;
-	int ret = analyse (path, src, channel);
+	int ret = analyse (path, src, channel, progress);
 
 	current_results = 0;
 
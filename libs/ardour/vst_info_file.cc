@@ -22,7 +22,9 @@
  *  e.g. its name, creator etc.
  */
 
+#include <algorithm>
 #include <cassert>
+#include <list>
 
 #include <sys/types.h>
 #include <fcntl.h>
@@ -92,121 +94,112 @@ get_vst_info_cache_dir () {
 }
 
 static string
-vstfx_infofile_path (const char* dllpath)
+vstfx_cache_file_path (const char* dllpath, const char* ext)
 {
 	char hash[41];
 	Sha1Digest s;
 	sha1_init (&s);
 	sha1_write (&s, (const uint8_t *) dllpath, strlen (dllpath));
 	sha1_result_hash (&s, hash);
-	return Glib::build_filename (get_vst_info_cache_dir (), std::string (hash) + std::string (VST_EXT_INFOFILE));
+	return Glib::build_filename (get_vst_info_cache_dir (), std::string (hash) + std::string (ext));
 }
 
+static string
+vstfx_infofile_path (const char* dllpath)
+{
+	return vstfx_cache_file_path (dllpath, VST_EXT_INFOFILE);
+}
 
-/* *** VST Blacklist *** */
-
-static void vstfx_read_blacklist (std::string &bl) {
-	FILE * blacklist_fd = NULL;
-	bl = "";
-
-	string fn = Glib::build_filename (ARDOUR::user_cache_directory (), VST_BLACKLIST);
 
-	if (!Glib::file_test (fn, Glib::FILE_TEST_EXISTS)) {
-		return;
-	}
+/* *** VST Blacklist *** */
 
-	if (! (blacklist_fd = g_fopen (fn.c_str (), "rb"))) {
-		return;
-	}
+/* Each blacklisted plugin has a file of its own next to its info file,
+ * rather than a line in a shared file: scanner apps run in parallel, and
+ * each one (un)blacklists the plugin that it scans.
+ */
 
-	while (!feof (blacklist_fd)) {
-		char buf[1024];
-		size_t s = fread (buf, sizeof(char), 1024, blacklist_fd);
-		if (ferror (blacklist_fd)) {
-			PBD::error << string_compose (_("error reading VST Blacklist file %1 (%2)"), fn, strerror (errno)) << endmsg;
-			bl = "";
-			break;
-		}
-		if (s == 0) {
-			break;
-		}
-		bl.append (buf, s);
-	}
-	::fclose (blacklist_fd);
+static string
+vstfx_blacklist_path (const char* dllpath)
+{
+	return vstfx_cache_file_path (dllpath, VST_EXT_BLACKLIST);
 }
 
 /** mark plugin as blacklisted */
 static void vstfx_blacklist (const char *id)
 {
-	string fn = Glib::build_filename (ARDOUR::user_cache_directory (), VST_BLACKLIST);
+	string fn = vstfx_blacklist_path (id);
 	FILE * blacklist_fd = NULL;
-	if (! (blacklist_fd = g_fopen (fn.c_str (), "a"))) {
-		PBD::error << string_compose (_("Cannot append to VST blacklist for '%1'"), id) << endmsg;
+	if (! (blacklist_fd = g_fopen (fn.c_str (), "w"))) {
+		PBD::error << string_compose (_("Cannot create VST blacklist file for '%1'"), id) << endmsg;
 		return;
 	}
-	assert (NULL == strchr (id, '\n'));
+	/* for reference only, the file's name identifies the plugin */
 	fprintf (blacklist_fd, "%s\n", id);
 	::fclose (blacklist_fd);
 }
 
 /** mark plugin as not blacklisted */
-static void vstfx_un_blacklist (const char *idcs)
+static void vstfx_un_blacklist (const char *id)
 {
-	string id (idcs);
-	string fn = Glib::build_filename (ARDOUR::user_cache_directory (), VST_BLACKLIST);
-	if (!Glib::file_test (fn, Glib::FILE_TEST_EXISTS)) {
-		PBD::warning << _("Expected VST Blacklist file does not exist.") << endmsg;
-		return;
+	string fn = vstfx_blacklist_path (id);
+	if (Glib::file_test (fn, Glib::FILE_TEST_EXISTS)) {
+		::g_unlink (fn.c_str ());
 	}
+}
 
-	std::string bl;
-	vstfx_read_blacklist (bl);
-
-	::g_unlink (fn.c_str ());
+/* return true if plugin is blacklisted */
+static bool vst_is_blacklisted (const char *id)
+{
+	// TODO ideally we'd also check if the VST has been updated since blacklisting
+	return Glib::file_test (vstfx_blacklist_path (id), Glib::FILE_TEST_EXISTS);
+}
 
-	assert (!Glib::file_test (fn, Glib::FILE_TEST_EXISTS));
-	assert (id.find ("\n") == string::npos);
+#ifndef VST_SCANNER_APP
+/** Move the entries of the shared blacklist file that earlier versions
+ *  used to per-plugin files. Only done by this process, before it starts
+ *  any scanner app.
+ */
+static void vstfx_convert_blacklist ()
+{
+	string fn = Glib::build_filename (ARDOUR::user_cache_directory (), VST_BLACKLIST);
 
-	id += "\n"; // add separator
-	const size_t rpl = bl.find (id);
-	if (rpl != string::npos) {
-		bl.replace (rpl, id.size (), "");
-	}
-	if (bl.empty ()) {
+	if (!Glib::file_test (fn, Glib::FILE_TEST_EXISTS)) {
 		return;
 	}
 
 	FILE * blacklist_fd = NULL;
-	if (! (blacklist_fd = g_fopen (fn.c_str (), "w"))) {
-		PBD::error << _("Cannot open VST blacklist.") << endmsg;;
+	if (! (blacklist_fd = g_fopen (fn.c_str (), "rb"))) {
 		return;
 	}
-	fprintf (blacklist_fd, "%s", bl.c_str ());
-	::fclose (blacklist_fd);
-}
-
-/* return true if plugin is blacklisted */
-static bool vst_is_blacklisted (const char *idcs)
-{
-	// TODO ideally we'd also check if the VST has been updated since blacklisting
-	string id (idcs);
-	string fn = Glib::build_filename (ARDOUR::user_cache_directory (), VST_BLACKLIST);
-	if (!Glib::file_test (fn, Glib::FILE_TEST_EXISTS)) {
-		return false;
-	}
 
 	std::string bl;
-	vstfx_read_blacklist (bl);
-
-	assert (id.find ("\n") == string::npos);
+	while (!feof (blacklist_fd)) {
+		char buf[1024];
+		size_t s = fread (buf, sizeof(char), 1024, blacklist_fd);
+		if (ferror (blacklist_fd)) {
+			PBD::error << string_compose (_("error reading VST Blacklist file %1 (%2)"), fn, strerror (errno)) << endmsg;
+			::fclose (blacklist_fd);
+			return;
+		}
+		if (s == 0) {
+			break;
+		}
+		bl.append (buf, s);
+	}
+	::fclose (blacklist_fd);
 
-	id += "\n"; // add separator
-	const size_t rpl = bl.find (id);
-	if (rpl != string::npos) {
-		return true;
+	string::size_type pos = 0;
+	string::size_type nl;
+	while ((nl = bl.find ('\n', pos)) != string::npos) {
+		if (nl > pos) {
+			vstfx_blacklist (bl.substr (pos, nl - pos).c_str ());
+		}
+		pos = nl + 1;
 	}
-	return false;
+
+	::g_unlink (fn.c_str ());
 }
+#endif
 
 
 
@@ -870,6 +863,15 @@ static void parse_scanner_output (std::string msg, size_t /*len*/)
 	}
 }
 
+/* output of scanners that run concurrently, see vstfx_scan_with_app() */
+static Glib::Threads::Mutex _scanner_output_lock;
+
+static void parse_parallel_scanner_output (std::string dllpath, std::string msg, size_t /*len*/)
+{
+	Glib::Threads::Mutex::Lock lm (_scanner_output_lock);
+	PBD::error << "VST '" << dllpath << "': " << msg;
+}
+
 static void
 set_error_log (const char* dllpath) {
 	assert (!_errorlog_fd);
@@ -898,6 +900,10 @@ vstfx_get_info (const char* dllpath, enum ARDOUR::PluginType type, enum VSTScanM
 	FILE* infofile;
 	vector<VSTInfo*> *infos = new vector<VSTInfo*>;
 
+#ifndef VST_SCANNER_APP
+	vstfx_convert_blacklist ();
+#endif
+
 	if (vst_is_blacklisted (dllpath)) {
 		return infos;
 	}
@@ -1010,6 +1016,130 @@ vstfx_get_info (const char* dllpath, enum ARDOUR::PluginType type, enum VSTScanM
 
 /* *** public API *** */
 
+#ifndef VST_SCANNER_APP
+
+namespace {
+
+/** One run of the external scanner app */
+struct ScanJob {
+	ScanJob (std::string const & p) : dllpath (p), exec (0), timeout (0) {}
+	~ScanJob () { delete exec; }
+
+	std::string dllpath;
+	ARDOUR::SystemExec* exec;
+	PBD::ScopedConnectionList cons;
+	int timeout;
+};
+
+}
+
+void
+vstfx_scan_with_app (std::vector<std::string> const & dllpaths, uint32_t n_jobs, std::set<std::string>& scanned)
+{
+	std::string scanner_bin_path = ARDOUR::PluginManager::scanner_bin_path;
+
+	if (scanner_bin_path.empty ()) {
+		return;
+	}
+
+	n_jobs = std::max (n_jobs, (uint32_t) 1);
+
+	vstfx_convert_blacklist ();
+
+	/* only scan what has changed since it was last scanned */
+	std::vector<std::string> todo;
+	for (std::vector<std::string>::const_iterator i = dllpaths.begin (); i != dllpaths.end (); ++i) {
+		if (vst_is_blacklisted (i->c_str ())) {
+			continue;
+		}
+		FILE* infofile = vstfx_infofile_for_read (i->c_str ());
+		if (infofile) {
+			fclose (infofile);
+			continue;
+		}
+		todo.push_back (*i);
+	}
+
+	std::vector<std::string>::const_iterator next = todo.begin ();
+	std::list<ScanJob*> running;
+	int const timeout = PLUGIN_SCAN_TIMEOUT;
+	bool const no_timeout = (timeout <= 0);
+	int tick = 0;
+
+	while (next != todo.end () || !running.empty ()) {
+
+		/* top up the running scans */
+
+		while (running.size () < n_jobs && next != todo.end () && !ARDOUR::PluginManager::instance ().cancelled ()) {
+
+			char **argp= (char**) calloc (3,sizeof (char*));
+			argp[0] = strdup (scanner_bin_path.c_str ());
+			argp[1] = strdup (next->c_str ());
+			argp[2] = 0;
+
+			ScanJob* job = new ScanJob (*next);
+			job->exec = new ARDOUR::SystemExec (scanner_bin_path, argp);
+			job->exec->ReadStdout.connect_same_thread (job->cons, boost::bind (&parse_parallel_scanner_output, job->dllpath, _1 ,_2));
+			job->timeout = timeout;
+
+			ARDOUR::PluginScanMessage (_("VST"), *next, true);
+			scanned.insert (*next);
+
+			if (job->exec->start (2 /* send stderr&stdout via signal */)) {
+				PBD::error << string_compose (_("Cannot launch VST scanner app '%1': %2"), scanner_bin_path, strerror (errno)) << endmsg;
+				delete job;
+			} else {
+				running.push_back (job);
+			}
+			++next;
+		}
+
+		if (running.empty ()) {
+			/* cancelled, or nothing could be started */
+			break;
+		}
+
+		Glib::usleep (100000);
+		ARDOUR::GUIIdle ();
+
+		bool const cancelled = ARDOUR::PluginManager::instance ().cancelled ();
+		bool const count_down = !no_timeout && !ARDOUR::PluginManager::instance ().no_timeout ();
+		int least_left = timeout;
+
+		for (std::list<ScanJob*>::iterator j = running.begin (); j != running.end (); ) {
+			ScanJob* job = *j;
+
+			if (count_down) {
+				--job->timeout;
+			}
+
+			if (cancelled) {
+				job->exec->terminate ();
+				// remove info file (might be incomplete)
+				vstfx_remove_infofile (job->dllpath.c_str ());
+				// remove temporary blacklist file (scan incomplete)
+				vstfx_un_blacklist (job->dllpath.c_str ());
+			} else if (job->exec->is_running () && (no_timeout || job->timeout > 0)) {
+				least_left = std::min (least_left, job->timeout);
+				++j;
+				continue;
+			} else {
+				/* done, or timed out, in which case it has blacklisted itself */
+				job->exec->terminate ();
+			}
+
+			delete job;
+			j = running.erase (j);
+		}
+
+		if (!no_timeout && !running.empty () && ++tick % 5 == 0) {
+			ARDOUR::PluginScanTimeout (least_left);
+		}
+	}
+}
+
+#endif
+
 void
 vstfx_free_info_list (vector<VSTInfo *> *infos)
 {
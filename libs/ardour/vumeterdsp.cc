@@ -19,6 +19,7 @@
 
 #include <math.h>
 #include "ardour/vumeterdsp.h"
+#include "ardour/runtime_functions.h"
 
 
 float Vumeterdsp::_w;
@@ -72,6 +73,41 @@ void Vumeterdsp::process (float const *p, int n)
 }
 
 
+void Vumeterdsp::process (Vumeterdsp * const *meters, float const * const *bufs, unsigned int n_meters, int n)
+{
+    const unsigned int chunk = 64;
+    float z1 [chunk];
+    float z2 [chunk];
+    float m [chunk];
+
+    for (unsigned int c = 0; c < n_meters; c += chunk)
+    {
+	const unsigned int nc = n_meters - c < chunk ? n_meters - c : chunk;
+
+	for (unsigned int i = 0; i < nc; ++i)
+	{
+	    Vumeterdsp *d = meters [c + i];
+	    z1 [i] = d->_z1 > 20 ? 20 : (d->_z1 < -20 ? -20 : d->_z1);
+	    z2 [i] = d->_z2 > 20 ? 20 : (d->_z2 < -20 ? -20 : d->_z2);
+	    m [i] = d->_res ? 0 : d->_m;
+	    d->_res = false;
+	}
+
+	ARDOUR::vumeter_process (bufs + c, nc, n < 0 ? 0 : n, _w, z1, z2, m);
+
+	for (unsigned int i = 0; i < nc; ++i)
+	{
+	    Vumeterdsp *d = meters [c + i];
+	    if (isnan(z1 [i])) z1 [i] = 0;
+	    if (isnan(z2 [i])) z2 [i] = 0;
+	    d->_z1 = z1 [i];
+	    d->_z2 = z2 [i] + 1e-10f;
+	    d->_m = m [i];
+	}
+    }
+}
+
+
 float Vumeterdsp::read (void)
 {
     _res = true;
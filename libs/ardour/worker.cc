@@ -20,28 +20,178 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <list>
+#include <vector>
+
+#include "ardour/rc_configuration.h"
 #include "ardour/worker.h"
 #include "pbd/error.h"
+#include "pbd/pthread_utils.h"
 
 #include <glibmm/timer.h>
 
 namespace ARDOUR {
 
+/**
+   The threads that do the work scheduled by all Workers.
+
+   Workers with pending requests are found by scanning the list of
+   Workers, which is short enough for that to cost nothing next to the
+   work itself. A thread claims a Worker by setting its _active flag, and
+   handles all of that Worker's requests before letting go of it.
+*/
+class Worker::Pool
+{
+public:
+	Pool(uint32_t n_threads);
+	~Pool();
+
+	void add(Worker*);
+	/** @return the number of Workers left */
+	size_t remove(Worker*);
+
+	/** Wake a thread to look for work */
+	void wake() { _sem.signal(); }
+
+private:
+	void     run();
+	Worker*  claim();
+
+	typedef std::list<Worker*> Workers;
+
+	Glib::Threads::Mutex                 _lock; ///< protects _workers
+	Workers                              _workers;
+	PBD::Semaphore                       _sem;
+	bool                                 _exit;
+	std::vector<Glib::Threads::Thread*>  _threads;
+};
+
+Glib::Threads::Mutex Worker::_pool_lock;
+Worker::Pool*        Worker::_pool = 0;
+
+Worker::Pool::Pool(uint32_t n_threads)
+	: _sem ("worker_semaphore", 0)
+	, _exit(false)
+{
+	for (uint32_t n = 0; n < std::max (n_threads, (uint32_t) 1); ++n) {
+		_threads.push_back (Glib::Threads::Thread::create(sigc::mem_fun(*this, &Worker::Pool::run)));
+	}
+}
+
+Worker::Pool::~Pool()
+{
+	_exit = true;
+	for (size_t n = 0; n < _threads.size(); ++n) {
+		_sem.signal();
+	}
+	for (std::vector<Glib::Threads::Thread*>::iterator t = _threads.begin(); t != _threads.end(); ++t) {
+		(*t)->join();
+	}
+}
+
+void
+Worker::Pool::add(Worker* w)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	_workers.push_back(w);
+}
+
+size_t
+Worker::Pool::remove(Worker* w)
+{
+	size_t left;
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		_workers.remove(w);
+		left = _workers.size();
+	}
+
+	/* No thread can claim the worker now; wait for any that has already
+	 * done so to finish with it.
+	 */
+	while (g_atomic_int_get(&w->_active)) {
+		Glib::usleep(1000);
+	}
+
+	return left;
+}
+
+Worker*
+Worker::Pool::claim()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	for (Workers::iterator i = _workers.begin(); i != _workers.end(); ++i) {
+		Worker* w = *i;
+		if (g_atomic_int_get(&w->_pending) &&
+		    g_atomic_int_compare_and_exchange(&w->_active, 0, 1)) {
+			/* move to the back, so that a busy worker cannot
+			 * keep the others waiting
+			 */
+			_workers.splice(_workers.end(), _workers, i);
+			return w;
+		}
+	}
+
+	return 0;
+}
+
+void
+Worker::Pool::run()
+{
+	pthread_set_name ("LV2 worker");
+
+	void*  buf      = NULL;
+	size_t buf_size = 0;
+	while (true) {
+		_sem.wait();
+		if (_exit) {
+			if (buf) free(buf);
+			return;
+		}
+
+		/* Keep going while anyone has work for us; a worker that was
+		 * busy in another thread when we were woken is picked up by
+		 * that thread or by us when we look again.
+		 */
+		Worker* w;
+		while ((w = claim()) != 0) {
+			w->run_requests(buf, buf_size);
+			g_atomic_int_set(&w->_active, 0);
+		}
+	}
+}
+
 Worker::Worker(Workee* workee, uint32_t ring_size)
 	: _workee(workee)
 	, _requests(new RingBuffer<uint8_t>(ring_size))
 	, _responses(new RingBuffer<uint8_t>(ring_size))
 	, _response((uint8_t*)malloc(ring_size))
-	, _sem ("worker_semaphore", 0)
-	, _exit(false)
-	, _thread (Glib::Threads::Thread::create(sigc::mem_fun(*this, &Worker::run)))
-{}
+{
+	g_atomic_int_set(&_pending, 0);
+	g_atomic_int_set(&_active, 0);
+
+	Glib::Threads::Mutex::Lock lm (_pool_lock);
+	if (!_pool) {
+		_pool = new Pool(Config->get_plugin_worker_threads());
+	}
+	_pool->add(this);
+}
 
 Worker::~Worker()
 {
-	_exit = true;
-	_sem.signal();
-	_thread->join();
+	{
+		Glib::Threads::Mutex::Lock lm (_pool_lock);
+		if (_pool->remove(this) == 0) {
+			delete _pool;
+			_pool = 0;
+		}
+	}
+
+	delete _requests;
+	delete _responses;
+	free(_response);
 }
 
 bool
@@ -56,14 +206,15 @@ Worker::schedule(uint32_t size, const void* data)
 	if (_requests->write((const uint8_t*)data, size) != size) {
 		return false;
 	}
-	_sem.signal();
+	g_atomic_int_set(&_pending, 1);
+	_pool->wake();
 	return true;
 }
 
 bool
 Worker::respond(uint32_t size, const void* data)
 {
-	if (_requests->write_space() < size + sizeof(size)) {
+	if (_responses->write_space() < size + sizeof(size)) {
 		return false;
 	}
 	if (_responses->write((const uint8_t*)&size, sizeof(size)) != sizeof(size)) {
@@ -117,33 +268,23 @@ Worker::emit_responses()
 }
 
 void
-Worker::run()
+Worker::run_requests(void*& buf, size_t& buf_size)
 {
-	void*  buf      = NULL;
-	size_t buf_size = 0;
-	while (true) {
-		_sem.wait();
-		if (_exit) {
-			if (buf) free(buf);
-			return;
-		}
+	/* clear the flag first: a request written after this will set it
+	 * again, and be picked up by us or another thread.
+	 */
+	g_atomic_int_set(&_pending, 0);
 
-		uint32_t size = _requests->read_space();
-		if (size < sizeof(size)) {
-			PBD::error << "Worker: no work-data on ring buffer" << endmsg;
-			continue;
-		}
-		while (!verify_message_completeness(_requests)) {
-			Glib::usleep(2000);
-			if (_exit) {
-				if (buf) free(buf);
-				return;
-			}
+	uint32_t size = 0;
+	while (_requests->read_space() >= sizeof(size)) {
+		if (!verify_message_completeness(_requests)) {
+			/* the writer has not finished; it will set _pending when it has */
+			return;
 		}
 		if (_requests->read((uint8_t*)&size, sizeof(size)) < sizeof(size)) {
 			PBD::error << "Worker: Error reading size from request ring"
 			           << endmsg;
-			continue;
+			return;
 		}
 
 		if (size > buf_size) {
@@ -160,7 +301,7 @@ Worker::run()
 		if (_requests->read((uint8_t*)buf, size) < size) {
 			PBD::error << "Worker: Error reading body from request ring"
 			           << endmsg;
-			continue;  // TODO: This is probably fatal
+			return;  // TODO: This is probably fatal
 		}
 
 		_workee->work(size, buf);
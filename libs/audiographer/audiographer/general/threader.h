@@ -111,7 +111,11 @@ class /*LIBAUDIOGRAPHER_API*/ Threader : public Source<T>, public Sink<T>
 		}
 
 		if (g_atomic_int_dec_and_test (&readers)) {
+			/* process() holds wait_mutex until it is waiting, so taking
+			 * it here makes sure the signal can not get lost. */
+			wait_mutex.lock();
 			wait_cond.signal();
+			wait_mutex.unlock();
 		}
 	}
 
@@ -427,16 +427,16 @@ DummyAudioBackend::_start (bool /*for_latency_measurement*/)
 		return BackendReinitializationError;
 	}
 
-	if (_ports.size()) {
+	if (_portmap.size()) {
 		PBD::warning << _("DummyAudioBackend: recovering from unclean shutdown, port registry is not empty.") << endmsg;
-		for (std::vector<DummyPort*>::const_iterator it = _ports.begin (); it != _ports.end (); ++it) {
-			PBD::info << _("DummyAudioBackend: port '") << (*it)->name () << "' exists." << endmsg;
+		for (PortMap::const_iterator it = _portmap.begin (); it != _portmap.end (); ++it) {
+			PBD::info << _("DummyAudioBackend: port '") << it->first << "' exists." << endmsg;
 		}
 		_system_inputs.clear();
 		_system_outputs.clear();
 		_system_midi_in.clear();
 		_system_midi_out.clear();
-		_ports.clear();
+		clear_registry ();
 	}
 
 	if (register_system_ports()) {
@@ -646,7 +646,11 @@ DummyAudioBackend::set_port_name (PortEngine::PortHandle port, const std::string
 		PBD::error << _("DummyBackend::set_port_name: Invalid Port(s)") << endmsg;
 		return -1;
 	}
-	return static_cast<DummyPort*>(port)->set_name (_instance_name + ":" + name);
+	DummyPort* p = static_cast<DummyPort*>(port);
+	_portmap.erase (p->name ());
+	int rv = p->set_name (_instance_name + ":" + name);
+	_portmap.insert (std::make_pair (p->name (), p));
+	return rv;
 }
 
 std::string
@@ -675,14 +679,18 @@ DummyAudioBackend::get_ports (
 	int rv = 0;
 	regex_t port_regex;
 	bool use_regexp = false;
+	if (type == DataType::NIL) {
+		return 0;
+	}
 	if (port_name_pattern.size () > 0) {
 		if (!regcomp (&port_regex, port_name_pattern.c_str (), REG_EXTENDED|REG_NOSUB)) {
 			use_regexp = true;
 		}
 	}
-	for (size_t i = 0; i < _ports.size (); ++i) {
-		DummyPort* port = _ports[i];
-		if ((port->type () == type) && flags == (port->flags () & flags)) {
+	const PortList& ports (_ports[type]);
+	for (PortList::const_iterator i = ports.begin (); i != ports.end (); ++i) {
+		DummyPort* port = *i;
+		if (flags == (port->flags () & flags)) {
 			if (!use_regexp || !regexec (&port_regex, port->name ().c_str (), 0, NULL, 0)) {
 				port_names.push_back (port->name ());
 				++rv;
@@ -743,7 +751,7 @@ DummyAudioBackend::add_port (
 			return 0;
 	}
 
-	_ports.push_back (port);
+	add_to_registry (port);
 
 	return port;
 }
@@ -757,16 +765,44 @@ DummyAudioBackend::unregister_port (PortEngine::PortHandle port_handle)
 		return;
 	}
 	DummyPort* port = static_cast<DummyPort*>(port_handle);
-	std::vector<DummyPort*>::iterator i = std::find (_ports.begin (), _ports.end (), static_cast<DummyPort*>(port_handle));
-	if (i == _ports.end ()) {
+	if (!valid_port (port_handle)) {
 		PBD::error << _("DummyBackend::unregister_port: Failed to find port") << endmsg;
 		return;
 	}
 	disconnect_all(port_handle);
-	_ports.erase (i);
+	remove_from_registry (port);
 	delete port;
 }
 
+void
+DummyAudioBackend::add_to_registry (DummyPort* port)
+{
+	PortList& ports (_ports[port->type ()]);
+	ports.push_back (port);
+	_portindex.insert (std::make_pair (port, --ports.end ()));
+	_portmap.insert (std::make_pair (port->name (), port));
+}
+
+void
+DummyAudioBackend::remove_from_registry (DummyPort* port)
+{
+	PortIndex::iterator i = _portindex.find (port);
+	assert (i != _portindex.end ());
+	_ports[port->type ()].erase (i->second);
+	_portindex.erase (i);
+	_portmap.erase (port->name ());
+}
+
+void
+DummyAudioBackend::clear_registry ()
+{
+	for (DataType::iterator t = DataType::begin (); t != DataType::end (); ++t) {
+		_ports[*t].clear ();
+	}
+	_portindex.clear ();
+	_portmap.clear ();
+}
+
 int
 DummyAudioBackend::register_system_ports()
 {
@@ -866,14 +902,19 @@ DummyAudioBackend::unregister_ports (bool system_only)
 	_system_midi_in.clear();
 	_system_midi_out.clear();
 
-	for (std::vector<DummyPort*>::iterator i = _ports.begin (); i != _ports.end ();) {
-		DummyPort* port = *i;
-		if (! system_only || (port->is_physical () && port->is_terminal ())) {
-			port->disconnect_all ();
-			delete port;
-			i = _ports.erase (i);
-		} else {
-			++i;
+	for (DataType::iterator t = DataType::begin (); t != DataType::end (); ++t) {
+		PortList& ports (_ports[*t]);
+		for (PortList::iterator i = ports.begin (); i != ports.end ();) {
+			DummyPort* port = *i;
+			if (! system_only || (port->is_physical () && port->is_terminal ())) {
+				port->disconnect_all ();
+				_portindex.erase (port);
+				_portmap.erase (port->name ());
+				delete port;
+				i = ports.erase (i);
+			} else {
+				++i;
+			}
 		}
 	}
 }
@@ -1137,67 +1178,63 @@ DummyAudioBackend::port_is_physical (PortEngine::PortHandle port) const
 	return static_cast<DummyPort*>(port)->is_physical ();
 }
 
+/* only system ports are physical, so the system port lists serve as the
+ * index of physical ports.
+ */
+
 void
 DummyAudioBackend::get_physical_outputs (DataType type, std::vector<std::string>& port_names)
 {
-	for (size_t i = 0; i < _ports.size (); ++i) {
-		DummyPort* port = _ports[i];
-		if ((port->type () == type) && port->is_input () && port->is_physical ()) {
-			port_names.push_back (port->name ());
-		}
+	switch (type) {
+		case DataType::AUDIO:
+			for (std::vector<DummyAudioPort*>::const_iterator i = _system_outputs.begin (); i != _system_outputs.end (); ++i) {
+				port_names.push_back ((*i)->name ());
+			}
+			break;
+		case DataType::MIDI:
+			for (std::vector<DummyMidiPort*>::const_iterator i = _system_midi_out.begin (); i != _system_midi_out.end (); ++i) {
+				port_names.push_back ((*i)->name ());
+			}
+			break;
+		default:
+			break;
 	}
 }
 
 void
 DummyAudioBackend::get_physical_inputs (DataType type, std::vector<std::string>& port_names)
 {
-	for (size_t i = 0; i < _ports.size (); ++i) {
-		DummyPort* port = _ports[i];
-		if ((port->type () == type) && port->is_output () && port->is_physical ()) {
-			port_names.push_back (port->name ());
-		}
+	switch (type) {
+		case DataType::AUDIO:
+			for (std::vector<DummyAudioPort*>::const_iterator i = _system_inputs.begin (); i != _system_inputs.end (); ++i) {
+				port_names.push_back ((*i)->name ());
+			}
+			break;
+		case DataType::MIDI:
+			for (std::vector<DummyMidiPort*>::const_iterator i = _system_midi_in.begin (); i != _system_midi_in.end (); ++i) {
+				port_names.push_back ((*i)->name ());
+			}
+			break;
+		default:
+			break;
 	}
 }
 
 ChanCount
 DummyAudioBackend::n_physical_outputs () const
 {
-	int n_midi = 0;
-	int n_audio = 0;
-	for (size_t i = 0; i < _ports.size (); ++i) {
-		DummyPort* port = _ports[i];
-		if (port->is_output () && port->is_physical ()) {
-			switch (port->type ()) {
-				case DataType::AUDIO: ++n_audio; break;
-				case DataType::MIDI: ++n_midi; break;
-				default: break;
-			}
-		}
-	}
 	ChanCount cc;
-	cc.set (DataType::AUDIO, n_audio);
-	cc.set (DataType::MIDI, n_midi);
+	cc.set (DataType::AUDIO, _system_inputs.size ());
+	cc.set (DataType::MIDI, _system_midi_in.size ());
 	return cc;
 }
 
 ChanCount
 DummyAudioBackend::n_physical_inputs () const
 {
-	int n_midi = 0;
-	int n_audio = 0;
-	for (size_t i = 0; i < _ports.size (); ++i) {
-		DummyPort* port = _ports[i];
-		if (port->is_input () && port->is_physical ()) {
-			switch (port->type ()) {
-				case DataType::AUDIO: ++n_audio; break;
-				case DataType::MIDI: ++n_midi; break;
-				default: break;
-			}
-		}
-	}
 	ChanCount cc;
-	cc.set (DataType::AUDIO, n_audio);
-	cc.set (DataType::MIDI, n_midi);
+	cc.set (DataType::AUDIO, _system_outputs.size ());
+	cc.set (DataType::MIDI, _system_midi_out.size ());
 	return cc;
 }
 
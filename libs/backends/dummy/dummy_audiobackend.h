@@ -22,6 +22,7 @@
 
 #include <string>
 #include <vector>
+#include <list>
 #include <map>
 #include <set>
 
@@ -29,6 +30,7 @@
 #include <pthread.h>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
 
 #include "ardour/types.h"
 #include "ardour/audio_backend.h"
@@ -441,7 +443,21 @@ class DummyAudioBackend : public AudioBackend {
 		std::vector<DummyAudioPort *> _system_outputs;
 		std::vector<DummyMidiPort *> _system_midi_in;
 		std::vector<DummyMidiPort *> _system_midi_out;
-		std::vector<DummyPort *> _ports;
+
+		/* port registry: all ports in order of registration, one list
+		 * per data type, indexed by name and by handle.
+		 */
+		typedef std::list<DummyPort *> PortList;
+		typedef boost::unordered_map<std::string, DummyPort *> PortMap;
+		typedef boost::unordered_map<const DummyPort *, PortList::iterator> PortIndex;
+
+		PortList  _ports[DataType::num_types];
+		PortMap   _portmap;
+		PortIndex _portindex;
+
+		void add_to_registry (DummyPort *);
+		void remove_from_registry (DummyPort *);
+		void clear_registry ();
 
 		struct PortConnectData {
 			std::string a;
@@ -469,16 +485,15 @@ class DummyAudioBackend : public AudioBackend {
 		}
 
 		bool valid_port (PortHandle port) const {
-			return std::find (_ports.begin (), _ports.end (), (DummyPort*)port) != _ports.end ();
+			return _portindex.find ((DummyPort*)port) != _portindex.end ();
 		}
 
 		DummyPort * find_port (const std::string& port_name) const {
-			for (std::vector<DummyPort*>::const_iterator it = _ports.begin (); it != _ports.end (); ++it) {
-				if ((*it)->name () == port_name) {
-					return *it;
-				}
+			PortMap::const_iterator it = _portmap.find (port_name);
+			if (it == _portmap.end ()) {
+				return NULL;
 			}
-			return NULL;
+			return it->second;
 		}
 
 }; // class DummyAudioBackend
@@ -21,13 +21,16 @@
 
 #include <cassert>
 #include <list>
+#include <vector>
 #include <stdint.h>
 
 #include <boost/pool/pool.hpp>
 #include <boost/pool/pool_alloc.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include <glibmm/threads.h>
 
+#include "pbd/rcu.h"
 #include "pbd/signals.h"
 
 #include "evoral/visibility.h"
@@ -223,6 +226,45 @@ public:
 		ControlList::const_iterator first;
 	};
 
+	/** Contiguous, sorted copy of the event times and values (as a
+	 *  struct of arrays), with the list iterator of each event. It is
+	 *  rebuilt by the thread that edits the list and published via RCU,
+	 *  and used for binary search lookups, which walking the list cannot
+	 *  do. The list itself remains the model that is edited, and its
+	 *  iterators stay stable.
+	 */
+	struct LIBEVORAL_API EventArrays {
+		EventArrays () : hint (0) {}
+
+		std::vector<double>         when;
+		std::vector<double>         value;
+		std::vector<const_iterator> iters;
+
+		/** @return the index of the first event at or after @a x */
+		size_t lower_bound (double x) const;
+
+	  private:
+		mutable gint hint; /* index of the last lookup, for sequential access */
+	};
+
+	/** Scoped access to the published event arrays, to be used while
+	 *  holding the list's (reader) lock. Never builds the arrays, so it is
+	 *  safe to use in RT context. valid() is false if the arrays are out
+	 *  of date (e.g. while the list is frozen), in which case the caller
+	 *  must walk the list instead.
+	 */
+	class LIBEVORAL_API ScopedArrays {
+	  public:
+		ScopedArrays (const ControlList&);
+
+		bool valid () const { return _arrays != 0; }
+		const EventArrays& operator* () const { return *_arrays; }
+		const EventArrays* operator-> () const { return _arrays.get(); }
+
+	  private:
+		boost::shared_ptr<EventArrays> _arrays;
+	};
+
 	const EventList& events() const { return _events; }
 	double default_value() const { return _default_value; }
 
@@ -285,6 +327,8 @@ protected:
 
 	void build_search_cache_if_necessary (double start) const;
 
+	void rebuild_arrays () const;
+
 	boost::shared_ptr<ControlList> cut_copy_clear (double, double, int op);
 	bool erase_range_internal (double start, double end, EventList &);
 
@@ -299,6 +343,9 @@ protected:
 	mutable LookupCache   _lookup_cache;
 	mutable SearchCache   _search_cache;
 
+	mutable SerializedRCUManager<EventArrays> _arrays;
+	mutable gint                              _arrays_dirty;
+
 	mutable Glib::Threads::RWLock _lock;
 
 	Parameter             _parameter;
@@ -25,6 +25,7 @@
 #include <list>
 #include <utility>
 #include <boost/shared_ptr.hpp>
+#include <glib.h>
 #include <glibmm/threads.h>
 
 #include "evoral/visibility.h"
@@ -90,7 +91,7 @@ public:
 	typedef boost::shared_ptr<WriteLockImpl>                     WriteLock;
 
 	virtual ReadLock  read_lock() const { return ReadLock(new Glib::Threads::RWLock::ReaderLock(_lock)); }
-	virtual WriteLock write_lock()      { return WriteLock(new WriteLockImpl(_lock, _control_lock)); }
+	virtual WriteLock write_lock()      { invalidate_note_index(); return WriteLock(new WriteLockImpl(_lock, _control_lock)); }
 
 	void clear();
 
@@ -153,6 +154,9 @@ public:
 	};
 
 	typedef std::multiset<NotePtr, EarlierNoteComparator> Notes;
+	/** Callers which change the notes through this reference must call
+	 *  invalidate_note_index() afterwards.
+	 */
 	inline       Notes& notes()       { return _notes; }
 	inline const Notes& notes() const { return _notes; }
 
@@ -227,7 +231,8 @@ public:
 		               Time                               t,
 		               bool                               force_discrete,
 		               const std::set<Evoral::Parameter>& filtered,
-		               const std::set<WeakNotePtr>*       active_notes=NULL);
+		               const std::set<WeakNotePtr>*       active_notes=NULL,
+		               bool                               sounding_notes=false);
 
 		inline bool valid() const { return !_is_end && _event; }
 
@@ -279,8 +284,27 @@ public:
 		return const_iterator (*this, t, force_discrete, f, active_notes);
 	}
 
+	/** @return an iterator at the first event of any type at or after @a t.
+	 *  Unlike begin(), this includes the note offs of notes which start
+	 *  before @a t and end at or after it, so reading from here gives the
+	 *  same events as reading from the start and skipping those before @a t.
+	 */
+	const_iterator seek (
+		Time                               t,
+		bool                               force_discrete = false,
+		const std::set<Evoral::Parameter>& f              = std::set<Evoral::Parameter>()) const {
+		return const_iterator (*this, t, force_discrete, f, NULL, true);
+	}
+
 	const const_iterator& end() const { return _end_iter; }
 
+	/** Mark the index used by seek() as out of date.  This is done
+	 *  by anything which changes the notes through the Sequence, but
+	 *  must also be called after changing the time or length of a note
+	 *  directly.
+	 */
+	void invalidate_note_index () { g_atomic_int_set (&_note_index_dirty, 1); }
+
 	// CONST iterator implementations (x3)
 	typename Notes::const_iterator note_lower_bound (Time t) const;
 	typename PatchChanges::const_iterator patch_change_lower_bound (Time t) const;
@@ -348,6 +372,15 @@ private:
 
 	const TypeMap& _type_map;
 
+	/* index of notes by the time range over which they sound, rebuilt on demand */
+	class NoteIndex;
+	friend class NoteIndex;
+	mutable boost::shared_ptr<const NoteIndex> _note_index;
+	mutable Glib::Threads::Mutex               _note_index_lock;
+	mutable gint                               _note_index_dirty;
+
+	void sounding_notes (Time t, ActiveNotes& active) const;
+
 	Notes        _notes;       // notes indexed by time
 	Pitches      _pitches[16]; // notes indexed by channel+pitch
 	SysExes      _sysexes;
@@ -51,7 +51,8 @@ inline bool event_time_less_than (ControlEvent* a, ControlEvent* b)
 }
 
 ControlList::ControlList (const Parameter& id, const ParameterDescriptor& desc)
-	: _parameter(id)
+	: _arrays(new EventArrays, true)
+	, _parameter(id)
 	, _desc(desc)
 	, _curve(0)
 {
@@ -66,6 +67,7 @@ ControlList::ControlList (const Parameter& id, const ParameterDescriptor& desc)
 	_lookup_cache.range.second = _events.end();
 	_search_cache.left = -1;
 	_search_cache.first = _events.end();
+	g_atomic_int_set (&_arrays_dirty, 1);
 	_sort_pending = false;
 	new_write_pass = true;
 	_in_write_pass = false;
@@ -75,7 +77,8 @@ ControlList::ControlList (const Parameter& id, const ParameterDescriptor& desc)
 }
 
 ControlList::ControlList (const ControlList& other)
-	: _parameter(other._parameter)
+	: _arrays(new EventArrays, true)
+	, _parameter(other._parameter)
 	, _desc(other._desc)
 	, _interpolation(other._interpolation)
 	, _curve(0)
@@ -88,6 +91,7 @@ ControlList::ControlList (const ControlList& other)
 	_lookup_cache.range.first = _events.end();
 	_lookup_cache.range.second = _events.end();
 	_search_cache.first = _events.end();
+	g_atomic_int_set (&_arrays_dirty, 1);
 	_sort_pending = false;
 	new_write_pass = true;
 	_in_write_pass = false;
@@ -98,10 +102,12 @@ ControlList::ControlList (const ControlList& other)
 	copy_events (other);
 
 	mark_dirty ();
+	rebuild_arrays ();
 }
 
 ControlList::ControlList (const ControlList& other, double start, double end)
-	: _parameter(other._parameter)
+	: _arrays(new EventArrays, true)
+	, _parameter(other._parameter)
 	, _desc(other._desc)
 	, _interpolation(other._interpolation)
 	, _curve(0)
@@ -114,6 +120,7 @@ ControlList::ControlList (const ControlList& other, double start, double end)
 	_lookup_cache.range.first = _events.end();
 	_lookup_cache.range.second = _events.end();
 	_search_cache.first = _events.end();
+	g_atomic_int_set (&_arrays_dirty, 1);
 	_sort_pending = false;
 
 	/* now grab the relevant points, and shift them back if necessary */
@@ -131,6 +138,7 @@ ControlList::ControlList (const ControlList& other, double start, double end)
 	most_recent_insert_iterator = _events.end();
 
 	mark_dirty ();
+	rebuild_arrays ();
 }
 
 ControlList::~ControlList()
@@ -207,6 +215,8 @@ ControlList::maybe_signal_changed ()
 
 	if (_frozen) {
 		_changed_when_thawed = true;
+	} else {
+		rebuild_arrays ();
 	}
 }
 
@@ -226,19 +236,27 @@ ControlList::clear ()
 void
 ControlList::x_scale (double factor)
 {
-	Glib::Threads::RWLock::WriterLock lm (_lock);
-	_x_scale (factor);
+	{
+		Glib::Threads::RWLock::WriterLock lm (_lock);
+		_x_scale (factor);
+	}
+
+	rebuild_arrays ();
 }
 
 bool
 ControlList::extend_to (double when)
 {
-	Glib::Threads::RWLock::WriterLock lm (_lock);
-	if (_events.empty() || _events.back()->when == when) {
-		return false;
+	{
+		Glib::Threads::RWLock::WriterLock lm (_lock);
+		if (_events.empty() || _events.back()->when == when) {
+			return false;
+		}
+		double factor = when / _events.back()->when;
+		_x_scale (factor);
 	}
-	double factor = when / _events.back()->when;
-	_x_scale (factor);
+
+	rebuild_arrays ();
 	return true;
 }
 
@@ -935,7 +953,10 @@ ControlList::thaw ()
 			unlocked_invalidate_insert_iterator ();
 			_sort_pending = false;
 		}
+
 	}
+
+	rebuild_arrays ();
 }
 
 void
@@ -947,6 +968,11 @@ ControlList::mark_dirty () const
 	_search_cache.left = -1;
 	_search_cache.first = _events.end();
 
+	/* readers walk the list until maybe_signal_changed() or thaw()
+	 * publish new arrays, once the edit is complete.
+	 */
+	g_atomic_int_set (&_arrays_dirty, 1);
+
 	if (_curve) {
 		_curve->mark_dirty();
 	}
@@ -1215,6 +1241,73 @@ ControlList::unlocked_eval (double x) const
 	return _default_value;
 }
 
+ControlList::ScopedArrays::ScopedArrays (const ControlList& list)
+{
+	if (!g_atomic_int_get (&list._arrays_dirty)) {
+		_arrays = list._arrays.reader ();
+	}
+}
+
+/** Copy the events into a new EventArrays and publish it, if the list has
+ *  changed since the last time. Allocates, so this is only called by the
+ *  thread that edits the list once an edit is complete (from
+ *  maybe_signal_changed() and thaw()), never by the evaluators. It must
+ *  not be called with the write lock held; evaluators can carry on while
+ *  the copy is made.
+ */
+void
+ControlList::rebuild_arrays () const
+{
+	Glib::Threads::RWLock::ReaderLock lm (_lock);
+
+	/* while frozen the list may be unsorted, so leave that to thaw() */
+	if (_frozen || !g_atomic_int_get (&_arrays_dirty)) {
+		return;
+	}
+
+	boost::shared_ptr<EventArrays> arrays (new EventArrays);
+
+	arrays->when.reserve (_events.size());
+	arrays->value.reserve (_events.size());
+	arrays->iters.reserve (_events.size());
+
+	for (const_iterator i = _events.begin(); i != _events.end(); ++i) {
+		arrays->when.push_back ((*i)->when);
+		arrays->value.push_back ((*i)->value);
+		arrays->iters.push_back (i);
+	}
+
+	_arrays.replace (arrays);
+
+	g_atomic_int_set (&_arrays_dirty, 0);
+}
+
+size_t
+ControlList::EventArrays::lower_bound (double x) const
+{
+	size_t const n = when.size();
+
+	/* the arrays are shared by all readers, so read the hint once */
+	size_t h = (size_t) g_atomic_int_get (&hint);
+
+	/* evaluation usually moves forward in small steps, so try the
+	 * last result and the one after it before doing a binary search.
+	 */
+	if (h < n && when[h] >= x && (h == 0 || when[h - 1] < x)) {
+		return h;
+	}
+
+	if (h + 1 < n && when[h + 1] >= x && when[h] < x) {
+		++h;
+	} else {
+		h = std::lower_bound (when.begin(), when.end(), x) - when.begin();
+	}
+
+	g_atomic_int_set (&hint, (gint) h);
+
+	return h;
+}
+
 double
 ControlList::multipoint_eval (double x) const
 {
@@ -1222,6 +1315,36 @@ ControlList::multipoint_eval (double x) const
 	double uval, lval;
 	double fraction;
 
+	ScopedArrays arrays (*this);
+
+	if (arrays.valid()) {
+
+		size_t const n = arrays->when.size();
+		size_t const i = arrays->lower_bound (x);
+
+		// shouldn't have made it to multipoint_eval
+		assert (i != n);
+
+		if (i == 0 || arrays->when[i] == x) {
+			/* x is a control point, or before the first one */
+			return arrays->value[i];
+		}
+
+		if (_interpolation == Discrete) {
+			return arrays->value[i - 1];
+		}
+
+		lpos = arrays->when[i - 1];
+		lval = arrays->value[i - 1];
+		upos = arrays->when[i];
+		uval = arrays->value[i];
+
+		fraction = (double) (x - lpos) / (double) (upos - lpos);
+		return lval + (fraction * (uval - lval));
+	}
+
+	/* the arrays are out of date, walk the list */
+
 	/* "Stepped" lookup (no interpolation) */
 	/* FIXME: no cache.  significant? */
 	if (_interpolation == Discrete) {
@@ -1300,9 +1423,16 @@ ControlList::build_search_cache_if_necessary (double start) const
 	} else if ((_search_cache.left < 0) || (_search_cache.left > start)) {
 		/* Marked dirty (left < 0), or we're too far forward, re-search. */
 
-		const ControlEvent start_point (start, 0);
+		ScopedArrays arrays (*this);
+
+		if (arrays.valid()) {
+			size_t const i = arrays->lower_bound (start);
+			_search_cache.first = (i == arrays->iters.size()) ? _events.end() : arrays->iters[i];
+		} else {
+			const ControlEvent start_point (start, 0);
+			_search_cache.first = lower_bound (_events.begin(), _events.end(), &start_point, time_comparator);
+		}
 
-		_search_cache.first = lower_bound (_events.begin(), _events.end(), &start_point, time_comparator);
 		_search_cache.left = start;
 	}
 
@@ -323,11 +323,102 @@ Curve::_get_vector (double x0, double x1, float *vec, int32_t veclen)
 		dx = (hx - lx) / (veclen - 1);
 	}
 
+	if (multipoint_get_vector (lx, dx, vec, veclen)) {
+		return;
+	}
+
 	for (i = 0; i < veclen; ++i, rx += dx) {
 		vec[i] = multipoint_eval (rx);
 	}
 }
 
+/** Fill @a vec with the curve at x = @a x0 + i * @a dx, one segment between
+ *  two control points at a time, so that the inner loops do no lookups and
+ *  can be vectorized by the compiler. Each x is computed directly rather
+ *  than accumulated (as the multipoint_eval() loop in _get_vector() does),
+ *  so the results can differ from that loop by rounding.
+ *
+ *  @return false if the list's event arrays are out of date,
+ *  in which case nothing was done.
+ */
+bool
+Curve::multipoint_get_vector (double x0, double dx, float *vec, int32_t veclen)
+{
+	ControlList::ScopedArrays arrays (_list);
+
+	if (!arrays.valid()) {
+		return false;
+	}
+
+	const ControlList::EventArrays& events (*arrays);
+	size_t const npoints = events.when.size();
+	int32_t i = 0;
+
+	while (i < veclen) {
+
+		double const x = x0 + i * dx;
+		size_t const n = events.lower_bound (x);
+
+		if (n == npoints) {
+			/* we're after the last point */
+			for (; i < veclen; ++i) {
+				vec[i] = events.value.back();
+			}
+			break;
+		}
+
+		if (n == 0 || events.when[n] == x) {
+			/* x is a control point, or before the first one */
+			vec[i++] = events.value[n];
+			continue;
+		}
+
+		/* find the end of the run of samples before control point n */
+
+		double const upos = events.when[n];
+		int32_t end = veclen;
+
+		if (dx > 0) {
+			double const len = ceil ((upos - x) / dx);
+			end = (len < (double) (veclen - i)) ? i + (int32_t) len : veclen;
+			while (end > i + 1 && x0 + (end - 1) * dx >= upos) {
+				--end;
+			}
+			while (end < veclen && x0 + end * dx < upos) {
+				++end;
+			}
+		}
+
+		double const lpos = events.when[n - 1];
+		double const lval = events.value[n - 1];
+		double const vdelta = events.value[n] - lval;
+		ControlEvent const * const after = *events.iters[n];
+
+		if (vdelta == 0.0) {
+			for (; i < end; ++i) {
+				vec[i] = lval;
+			}
+		} else if (_list.interpolation() == ControlList::Curved && after->coeff) {
+			double const c0 = after->coeff[0];
+			double const c1 = after->coeff[1];
+			double const c2 = after->coeff[2];
+			double const c3 = after->coeff[3];
+			for (; i < end; ++i) {
+				double const xi = x0 + i * dx;
+				double const xi2 = xi * xi;
+				vec[i] = c0 + (c1 * xi) + (c2 * xi2) + (c3 * xi2 * xi);
+			}
+		} else {
+			double const trange = upos - lpos;
+			for (; i < end; ++i) {
+				vec[i] = lval + (vdelta * (((x0 + i * dx) - lpos) / trange));
+			}
+		}
+	}
+
+	return true;
+}
+
 double
 Curve::unlocked_eval (double x)
 {
@@ -345,6 +436,46 @@ Curve::multipoint_eval (double x)
 {
 	pair<ControlList::EventList::const_iterator,ControlList::EventList::const_iterator> range;
 
+	ControlList::ScopedArrays arrays (_list);
+
+	if (arrays.valid()) {
+
+		size_t const n = arrays->when.size();
+		size_t const i = arrays->lower_bound (x);
+
+		if (i != n && arrays->when[i] == x) {
+			/* x is a control point in the data */
+			return arrays->value[i];
+		}
+
+		if (i == 0) {
+			/* we're before the first point */
+			return arrays->value.front();
+		}
+
+		if (i == n) {
+			/* we're after the last point */
+			return arrays->value.back();
+		}
+
+		double const vdelta = arrays->value[i] - arrays->value[i - 1];
+
+		if (vdelta == 0.0) {
+			return arrays->value[i - 1];
+		}
+
+		ControlEvent const * const after = *arrays->iters[i];
+
+		if (_list.interpolation() == ControlList::Curved && after->coeff) {
+			double x2 = x * x;
+			return after->coeff[0] + (after->coeff[1] * x) + (after->coeff[2] * x2) + (after->coeff[3] * x2 * x);
+		}
+
+		return arrays->value[i - 1] + (vdelta * ((x - arrays->when[i - 1]) / (arrays->when[i] - arrays->when[i - 1])));
+	}
+
+	/* the arrays are out of date, walk the list */
+
 	ControlList::LookupCache& lookup_cache = _list.lookup_cache();
 
 	if ((lookup_cache.left < 0) ||
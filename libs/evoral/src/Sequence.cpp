@@ -76,7 +76,8 @@ Sequence<Time>::const_iterator::const_iterator(const Sequence<Time>&
                                                Time                               t,
                                                bool                               force_discrete,
                                                const std::set<Evoral::Parameter>& filtered,
-                                               const std::set<WeakNotePtr>*       active_notes)
+                                               const std::set<WeakNotePtr>*       active_notes,
+                                               bool                               sounding_notes)
 	: _seq(&seq)
 	, _active_patch_change_message (0)
 	, _type(NIL)
@@ -106,26 +107,20 @@ Sequence<Time>::const_iterator::const_iterator(const Sequence<Time>&
 		}
 	}
 
+	// Add notes which began before t but have not yet ended, if asked to
+	if (sounding_notes) {
+		seq.sounding_notes(t, _active_notes);
+	}
+
 	// Find first note which begins at or after t
 	_note_iter = seq.note_lower_bound(t);
 
 	// Find first sysex event at or after t
-	for (typename Sequence<Time>::SysExes::const_iterator i = seq.sysexes().begin();
-	     i != seq.sysexes().end(); ++i) {
-		if ((*i)->time() >= t) {
-			_sysex_iter = i;
-			break;
-		}
-	}
+	_sysex_iter = seq.sysex_lower_bound(t);
 	assert(_sysex_iter == seq.sysexes().end() || (*_sysex_iter)->time() >= t);
 
 	// Find first patch event at or after t
-	for (typename Sequence<Time>::PatchChanges::const_iterator i = seq.patch_changes().begin(); i != seq.patch_changes().end(); ++i) {
-		if ((*i)->time() >= t) {
-			_patch_change_iter = i;
-			break;
-		}
-	}
+	_patch_change_iter = seq.patch_change_lower_bound(t);
 	assert (_patch_change_iter == seq.patch_changes().end() || (*_patch_change_iter)->time() >= t);
 
 	// Find first control event after t
@@ -462,6 +457,7 @@ Sequence<Time>::Sequence(const TypeMap& type_map)
 	, _overlap_pitch_resolution (FirstOnFirstOff)
 	, _writing(false)
 	, _type_map(type_map)
+	, _note_index_dirty(1)
 	, _end_iter(*this, std::numeric_limits<Time>::max(), false, std::set<Evoral::Parameter> ())
 	, _percussive(false)
 	, _lowest_note(127)
@@ -484,6 +480,7 @@ Sequence<Time>::Sequence(const Sequence<Time>& other)
 	, _overlap_pitch_resolution (other._overlap_pitch_resolution)
 	, _writing(false)
 	, _type_map(other._type_map)
+	, _note_index_dirty(1)
 	, _end_iter(*this, std::numeric_limits<Time>::max(), false, std::set<Evoral::Parameter> ())
 	, _percussive(other._percussive)
 	, _lowest_note(other._lowest_note)
@@ -702,6 +699,7 @@ Sequence<Time>::add_note_unlocked(const NotePtr note, void* arg)
 	_pitches[note->channel()].insert (note);
 
 	_edited = true;
+	invalidate_note_index ();
 
 	return true;
 }
@@ -713,6 +711,8 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 	bool erased = false;
 	bool id_matched = false;
 
+	invalidate_note_index ();
+
 	DEBUG_TRACE (DEBUG::Sequence, string_compose ("%1 remove note #%2 %3 @ %4\n", this, note->id(), (int)note->note(), note->time()));
 
 	/* first try searching for the note using the time index, which is
@@ -1021,6 +1021,7 @@ Sequence<Time>::append_note_off_unlocked (const MIDIEvent<Time>& ev)
 
 			nn->set_length (ev.time() - nn->time());
 			nn->set_off_velocity (ev.velocity());
+			invalidate_note_index ();
 
 			_write_notes[ev.channel()].erase(n);
 			DEBUG_TRACE (DEBUG::Sequence, string_compose ("resolved note @ %2 length: %1\n", nn->length(), nn->time()));
@@ -1169,6 +1170,113 @@ void
 Sequence<Time>::set_notes (const typename Sequence<Time>::Notes& n)
 {
 	_notes = n;
+	invalidate_note_index ();
+}
+
+/** An index of a sequence's notes by the time range over which each of them
+ *  sounds.  The notes are held in order of start time, and the array treated
+ *  as an implicit balanced binary tree with the entry in the middle of any
+ *  part of it holding the latest end time of that part.  This finds the M
+ *  notes which are sounding at a given time in O(log N + M) time.
+ */
+template<typename Time>
+class Sequence<Time>::NoteIndex
+{
+public:
+	NoteIndex (const Notes& notes)
+	{
+		_entries.reserve (notes.size());
+		for (typename Notes::const_iterator n = notes.begin(); n != notes.end(); ++n) {
+			_entries.push_back (Entry (*n));
+		}
+		build (0, _entries.size());
+	}
+
+	/** Add the notes which start before @a t and end at or after it to @a active */
+	void sounding (Time t, ActiveNotes& active) const {
+		search (0, _entries.size(), t, active);
+	}
+
+private:
+	struct Entry {
+		Entry (const NotePtr& n) : start (n->time()), end (n->end_time()), max_end (end), note (n) {}
+
+		Time    start;
+		Time    end;
+		Time    max_end; ///< latest end of the subtree rooted at this entry
+		NotePtr note;
+	};
+
+	std::vector<Entry> _entries;
+
+	Time build (size_t lo, size_t hi) {
+		if (lo >= hi) {
+			return Time();
+		}
+
+		const size_t mid = lo + (hi - lo) / 2;
+
+		Time m = _entries[mid].end;
+		const Time l = build (lo, mid);
+		const Time r = build (mid + 1, hi);
+		if (l > m) {
+			m = l;
+		}
+		if (r > m) {
+			m = r;
+		}
+		_entries[mid].max_end = m;
+
+		return m;
+	}
+
+	void search (size_t lo, size_t hi, Time t, ActiveNotes& active) const {
+		if (lo >= hi) {
+			return;
+		}
+
+		const size_t mid = lo + (hi - lo) / 2;
+		const Entry& e = _entries[mid];
+
+		if (e.max_end < t) {
+			// nothing in this subtree is still sounding at t
+			return;
+		}
+
+		search (lo, mid, t, active);
+
+		if (!(e.start < t)) {
+			// this note, and all those after it, begin at or after t
+			return;
+		}
+
+		if (e.note->time() < t && e.note->end_time() >= t) {
+			active.push (e.note);
+		}
+
+		search (mid + 1, hi, t, active);
+	}
+};
+
+/** Add the notes which start before @a t and end at or after it to @a active.
+ *  The caller must hold the read lock.
+ */
+template<typename Time>
+void
+Sequence<Time>::sounding_notes (Time t, ActiveNotes& active) const
+{
+	boost::shared_ptr<const NoteIndex> index;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_note_index_lock);
+		if (!_note_index || g_atomic_int_get (&_note_index_dirty)) {
+			g_atomic_int_set (&_note_index_dirty, 0);
+			_note_index.reset (new NoteIndex (_notes));
+		}
+		index = _note_index;
+	}
+
+	index->sounding (t, active);
 }
 
 // CONST iterator implementations (x3)
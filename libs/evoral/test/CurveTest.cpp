@@ -424,3 +424,150 @@ CurveTest::constrainedCubic ()
 		CPPUNIT_ASSERT_DOUBLES_EQUAL(v, g[x], 0.000008);
 	}
 }
+
+void
+CurveTest::ctrlListDenseEval ()
+{
+	boost::shared_ptr<Evoral::ControlList> cl = TestCtrlList();
+
+	/* y = x / 2 at even x, y = 0 at odd x */
+	for (int i = 0; i < 10000; ++i) {
+		cl->fast_simple_add (i, (i % 2) ? 0.0 : i / 2.0);
+	}
+
+	cl->set_interpolation (ControlList::Linear);
+
+	/* forwards, backwards and jumping around */
+	for (int i = 0; i < 9998; i += 2) {
+		CPPUNIT_ASSERT_EQUAL (i / 2.0, cl->unlocked_eval (i));
+		CPPUNIT_ASSERT_EQUAL (i / 4.0, cl->unlocked_eval (i + .5));
+	}
+	for (int i = 9998; i > 0; i -= 2) {
+		CPPUNIT_ASSERT_EQUAL (i / 2.0, cl->unlocked_eval (i));
+	}
+	for (int i = 0; i < 100; ++i) {
+		int x = (i * 7919) % 9998;
+		x -= x % 2;
+		CPPUNIT_ASSERT_EQUAL (x / 2.0, cl->unlocked_eval (x));
+	}
+
+	cl->set_interpolation (ControlList::Discrete);
+	CPPUNIT_ASSERT_EQUAL (1000.0, cl->unlocked_eval (2000.5));
+	CPPUNIT_ASSERT_EQUAL (0.0, cl->unlocked_eval (2001.5));
+
+	/* edits must be visible to the next lookup */
+	ControlList::iterator i = cl->begin ();
+	std::advance (i, 4000);
+	cl->modify (i, 4000, 1.0);
+	CPPUNIT_ASSERT_EQUAL (1.0, cl->unlocked_eval (4000));
+
+	cl->set_interpolation (ControlList::Linear);
+	CPPUNIT_ASSERT_EQUAL (0.5, cl->unlocked_eval (4000.5));
+
+	double x, y;
+	CPPUNIT_ASSERT (cl->rt_safe_earliest_event_discrete_unlocked (5000.5, x, y, false));
+	CPPUNIT_ASSERT_EQUAL (5001.0, x);
+	CPPUNIT_ASSERT_EQUAL (0.0, y);
+}
+
+/* The value of a curved list at x, found by walking the list. */
+static double
+curved_eval (const ControlList& cl, double x)
+{
+	const ControlList::EventList& events (cl.events ());
+	ControlList::EventList::const_iterator after = events.begin ();
+
+	while (after != events.end () && (*after)->when < x) {
+		++after;
+	}
+
+	if (after == events.end ()) {
+		return events.back ()->value;
+	}
+
+	if (after == events.begin () || (*after)->when == x) {
+		return (*after)->value;
+	}
+
+	ControlList::EventList::const_iterator before = after;
+	--before;
+
+	if ((*after)->value == (*before)->value) {
+		return (*before)->value;
+	}
+
+	CPPUNIT_ASSERT ((*after)->coeff);
+
+	const double* c = (*after)->coeff;
+	return c[0] + (c[1] * x) + (c[2] * x * x) + (c[3] * x * x * x);
+}
+
+void
+CurveTest::segmentedGetVector ()
+{
+	static const struct point {
+		double x, y;
+	} data[] = {
+		{   0.0, 0.0  },
+		{  10.0, 1.0  },
+		{  25.5, 0.2  },
+		{  40.0, 0.2  },
+		{  41.0, 1.5  },
+		{  70.0, 0.0  },
+		{ 100.0, 0.75 },
+	};
+
+	/* ranges within the list, with samples on, next to and between the
+	 * control points
+	 */
+	static const struct range {
+		double x0, x1;
+		int32_t veclen;
+	} ranges[] = {
+		{  0.0,   100.0,  101 },
+		{  0.0,   100.0, 1000 },
+		{  3.3,    97.1, 4096 },
+		{ 40.0,    41.0,   16 },
+		{  9.999,  10.001,  3 },
+		{ 12.0,    12.0,    1 },
+		{ 25.5,    70.0,    2 },
+	};
+
+	float vec[4096];
+	char msg[96];
+
+	boost::shared_ptr<Evoral::ControlList> cl = TestCtrlList();
+	cl->create_curve ();
+
+	for (size_t i = 0; i < sizeof (data) / sizeof (data[0]); ++i) {
+		cl->add (data[i].x, data[i].y);
+	}
+
+	/* the segment-wise path needs the event arrays */
+	CPPUNIT_ASSERT (ControlList::ScopedArrays (*cl).valid ());
+
+	const ControlList::InterpolationStyle styles[] = { ControlList::Linear, ControlList::Curved };
+
+	for (size_t s = 0; s < sizeof (styles) / sizeof (styles[0]); ++s) {
+
+		cl->set_interpolation (styles[s]);
+		cl->curve ().mark_dirty ();
+
+		for (size_t r = 0; r < sizeof (ranges) / sizeof (ranges[0]); ++r) {
+
+			const range& rg (ranges[r]);
+			const double dx = rg.veclen > 1 ? (rg.x1 - rg.x0) / (rg.veclen - 1) : 0;
+
+			cl->curve ().get_vector (rg.x0, rg.x1, vec, rg.veclen);
+
+			for (int32_t i = 0; i < rg.veclen; ++i) {
+				const double x = rg.x0 + i * dx;
+				const double expected = styles[s] == ControlList::Curved ? curved_eval (*cl, x) : cl->unlocked_eval (x);
+
+				snprintf (msg, sizeof (msg), "%s at i=%d x=%f (%.3f..%.3f/%d)",
+				          styles[s] == ControlList::Curved ? "curved" : "linear", i, x, rg.x0, rg.x1, rg.veclen);
+				CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE (msg, expected, vec[i], 1e-5);
+			}
+		}
+	}
+}
@@ -90,6 +90,53 @@ SequenceTest::iteratorSeekTest ()
 	CPPUNIT_ASSERT_EQUAL(num_notes, size_t(6));
 }
 
+void
+SequenceTest::seekSoundingNotesTest ()
+{
+	seq->clear();
+
+	for (Notes::const_iterator i = test_notes.begin(); i != test_notes.end(); ++i) {
+		seq->notes().insert(*i);
+	}
+
+	/* note 6 starts before 650 and is still sounding, so we should get
+	   its note off before anything else, then notes 7 to 11 in full.
+	*/
+	size_t num_ons  = 0;
+	size_t num_offs = 0;
+	Sequence<Time>::const_iterator i = seq->seek(Evoral::Beats(650));
+
+	CPPUNIT_ASSERT(i != seq->end());
+	CPPUNIT_ASSERT(((const MIDIEvent<Time>&)*i).is_note_off());
+	CPPUNIT_ASSERT_EQUAL(Time(700), i->time());
+	CPPUNIT_ASSERT_EQUAL(uint8_t(64 + 6), ((const MIDIEvent<Time>&)*i).note());
+
+	for (; i != seq->end(); ++i) {
+		const MIDIEvent<Time>& ev = (const MIDIEvent<Time>&)*i;
+		CPPUNIT_ASSERT(i->time() >= Time(650));
+		if (ev.is_note_on()) {
+			++num_ons;
+		} else if (ev.is_note_off()) {
+			++num_offs;
+		}
+	}
+
+	CPPUNIT_ASSERT_EQUAL(size_t(5), num_ons);
+	CPPUNIT_ASSERT_EQUAL(size_t(6), num_offs);
+
+	/* a note which ends exactly at the seek point still gets its note off */
+	i = seq->seek(Evoral::Beats(600));
+	CPPUNIT_ASSERT(((const MIDIEvent<Time>&)*i).is_note_off());
+	CPPUNIT_ASSERT_EQUAL(uint8_t(64 + 5), ((const MIDIEvent<Time>&)*i).note());
+
+	/* changes to the notes are seen by the next seek */
+	seq->notes().erase(test_notes[6]);
+	seq->invalidate_note_index();
+	i = seq->seek(Evoral::Beats(650));
+	CPPUNIT_ASSERT(((const MIDIEvent<Time>&)*i).is_note_on());
+	CPPUNIT_ASSERT_EQUAL(Time(700), i->time());
+}
+
 void
 SequenceTest::controlInterpolationTest ()
 {
@@ -111,6 +111,7 @@ class SequenceTest : public CppUnit::TestFixture
 	CPPUNIT_TEST (createTest);
 	CPPUNIT_TEST (preserveEventOrderingTest);
 	CPPUNIT_TEST (iteratorSeekTest);
+	CPPUNIT_TEST (seekSoundingNotesTest);
 	CPPUNIT_TEST (controlInterpolationTest);
 	CPPUNIT_TEST_SUITE_END ();
 
@@ -140,6 +141,7 @@ public:
 	void createTest ();
 	void preserveEventOrderingTest ();
 	void iteratorSeekTest ();
+	void seekSoundingNotesTest ();
 	void controlInterpolationTest ();
 
 private:
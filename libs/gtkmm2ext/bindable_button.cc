@@ -49,7 +49,7 @@ BindableToggleButton::watch ()
                 return;
         }
 
-        c->Changed.connect (watch_connection, invalidator(*this), boost::bind (&BindableToggleButton::controllable_changed, this), gui_context());
+        c->Changed.connect (watch_connection, coalescing_invalidator(*this), boost::bind (&BindableToggleButton::controllable_changed, this), gui_context());
 }
 
 void
@@ -423,14 +423,17 @@ UI::idle_add (int (*func)(void *), void *arg)
 /** Create a PBD::EventLoop::InvalidationRecord and attach a callback
  *  to a given sigc::trackable so that PBD::EventLoop::invalidate_request
  *  is called when that trackable is destroyed.
+ *  @param coalesce true if queued calls made through the record may be
+ *  replaced by a later one.
  */
 PBD::EventLoop::InvalidationRecord*
-__invalidator (sigc::trackable& trackable, const char* file, int line)
+__invalidator (sigc::trackable& trackable, const char* file, int line, bool coalesce)
 {
         PBD::EventLoop::InvalidationRecord* ir = new PBD::EventLoop::InvalidationRecord;
 
         ir->file = file;
         ir->line = line;
+        ir->coalesce = coalesce;
 
         trackable.add_destroy_notify_callback (ir, PBD::EventLoop::invalidate_request);
 
@@ -481,6 +484,25 @@ UI::do_request (UIRequest* req)
 	}
 }
 
+/** A display only needs to be redrawn, and a widget to reach its final
+ *  state, once for all of the requests that are waiting. The same goes
+ *  for the calls of a signal handler that was connected with a
+ *  coalescing_invalidator(): each connection has a record of its own.
+ */
+void*
+UI::coalesce_key (UIRequest const * req) const
+{
+	if (req->type == TouchDisplay) {
+		return req->display;
+	} else if (req->type == StateChange) {
+		return req->widget;
+	} else if (req->type == CallSlot && req->invalidation && req->invalidation->coalesce) {
+		return req->invalidation;
+	}
+
+	return 0;
+}
+
 /*======================================================================
   Error Display
   ======================================================================*/
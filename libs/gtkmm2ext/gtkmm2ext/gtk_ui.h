@@ -204,6 +204,7 @@ class LIBGTKMM2EXT_API UI : public AbstractUI<UIRequest>
 	bool color_picked;
 
 	void do_request (UIRequest*);
+	void* coalesce_key (UIRequest const *) const;
 
 };
 
@@ -36,7 +36,12 @@ namespace sigc {
 #define gui_context() Gtkmm2ext::UI::instance() /* a UICallback-derived object that specifies the event loop for GUI signal handling */
 #define ui_bind(f, ...) boost::protect (boost::bind (f, __VA_ARGS__))
 
-LIBGTKMM2EXT_API extern PBD::EventLoop::InvalidationRecord* __invalidator (sigc::trackable& trackable, const char*, int);
+LIBGTKMM2EXT_API extern PBD::EventLoop::InvalidationRecord* __invalidator (sigc::trackable& trackable, const char*, int, bool coalesce = false);
 #define invalidator(x) __invalidator ((x), __FILE__, __LINE__)
+/* for handlers that only bring the GUI up to date with the current state of
+   the model (e.g. redraw a control), so that of the calls that are waiting
+   in the GUI's queue, only the most recent one needs to be made.
+*/
+#define coalescing_invalidator(x) __invalidator ((x), __FILE__, __LINE__, true)
 
 #endif /* __ardour_gtk_gui_thread_h__ */
@@ -25,13 +25,11 @@
 #include <iostream>
 #include <string>
 
-#ifdef COMPILER_MSVC
-#include <malloc.h>
-#endif
-
 #include "pbd/cartesian.h"
 #include "pbd/compose.h"
 
+#include "evoral/Curve.hpp"
+
 #include "ardour/amp.h"
 #include "ardour/audio_buffer.h"
 #include "ardour/buffer_set.h"
@@ -122,35 +120,40 @@ void
 VBAPanner::update ()
 {
         /* recompute signal directions based on panner azimuth and, if relevant, width (diffusion) and elevation parameters */
-        double elevation = _pannable->pan_elevation_control->get_value() * 90.0;
+        const double azimuth = _pannable->pan_azimuth_control->get_value();
+        const double width = _pannable->pan_width_control->get_value();
+        const double elevation = _pannable->pan_elevation_control->get_value();
+
+        for (uint32_t n = 0; n < _signals.size(); ++n) {
+                Signal* signal = _signals[n];
+                signal->direction = direction_for_signal (n, azimuth, width, elevation);
+                compute_gains (signal->desired_gains, signal->desired_outputs, signal->direction.azi, signal->direction.ele);
+        }
 
+        SignalPositionChanged(); /* emit */
+}
+
+/** @return the direction of signal @param which for the given (normalized)
+ *  azimuth, width and elevation of the panner.
+ */
+AngularVector
+VBAPanner::direction_for_signal (uint32_t which, double azimuth, double width, double elevation) const
+{
         if (_signals.size() > 1) {
-                double w = - (_pannable->pan_width_control->get_value());
-                double signal_direction = 1.0 - (_pannable->pan_azimuth_control->get_value() + (w/2));
+                double w = - width;
                 double grd_step_per_signal = w / (_signals.size() - 1);
-                for (vector<Signal*>::iterator s = _signals.begin(); s != _signals.end(); ++s) {
-
-                        Signal* signal = *s;
+                double signal_direction = 1.0 - (azimuth + (w/2)) + which * grd_step_per_signal;
 
-                        int over = signal_direction;
-                        over -= (signal_direction >= 0) ? 0 : 1;
-                        signal_direction -= (double)over;
+                int over = signal_direction;
+                over -= (signal_direction >= 0) ? 0 : 1;
+                signal_direction -= (double)over;
 
-                        signal->direction = AngularVector (signal_direction * 360.0, elevation);
-                        compute_gains (signal->desired_gains, signal->desired_outputs, signal->direction.azi, signal->direction.ele);
-                        signal_direction += grd_step_per_signal;
-                }
-        } else if (_signals.size() == 1) {
-                double center = (1.0 - _pannable->pan_azimuth_control->get_value()) * 360.0;
-
-                /* width has no role to play if there is only 1 signal: VBAP does not do "diffusion" of a single channel */
-
-                Signal* s = _signals.front();
-                s->direction = AngularVector (center, elevation);
-                compute_gains (s->desired_gains, s->desired_outputs, s->direction.azi, s->direction.ele);
+                return AngularVector (signal_direction * 360.0, elevation * 90.0);
         }
 
-        SignalPositionChanged(); /* emit */
+        /* width has no role to play if there is only 1 signal: VBAP does not do "diffusion" of a single channel */
+
+        return AngularVector ((1.0 - azimuth) * 360.0, elevation * 90.0);
 }
 
 void
@@ -159,52 +162,36 @@ VBAPanner::compute_gains (double gains[3], int speaker_ids[3], int azi, int ele)
 	/* calculates gain factors using loudspeaker setup and given direction */
 	double cartdir[3];
 	double power;
-	int i,j,k;
-	double small_g;
-	double big_sm_g, gtmp[3];
 	const int dimension = _speakers->dimension();
 	assert(dimension == 2 || dimension == 3);
 
-	spherical_to_cartesian (azi, ele, 1.0, cartdir[0], cartdir[1], cartdir[2]);
-	big_sm_g = -100000.0;
-
 	gains[0] = gains[1] = gains[2] = 0;
 	speaker_ids[0] = speaker_ids[1] = speaker_ids[2] = 0;
 
-	for (i = 0; i < _speakers->n_tuples(); i++) {
+	/* the speakers precompute which pair or triplet covers each direction */
 
-		small_g = 10000000.0;
+	const int tuple = _speakers->tuple_for_direction (azi, ele);
 
-		for (j = 0; j < dimension; j++) {
+	if (tuple >= 0 && tuple < _speakers->n_tuples()) {
 
-			gtmp[j] = 0.0;
+		const VBAPSpeakers::dvector& matrix (_speakers->matrix (tuple));
 
-			for (k = 0; k < dimension; k++) {
-				gtmp[j] += cartdir[k] * _speakers->matrix(i)[j * dimension + k];
-			}
+		spherical_to_cartesian (azi, ele, 1.0, cartdir[0], cartdir[1], cartdir[2]);
 
-			if (gtmp[j] < small_g) {
-				small_g = gtmp[j];
+		for (int j = 0; j < dimension; j++) {
+			for (int k = 0; k < dimension; k++) {
+				gains[j] += cartdir[k] * matrix[j * dimension + k];
 			}
 		}
 
-		if (small_g > big_sm_g) {
-
-			big_sm_g = small_g;
-
-			gains[0] = gtmp[0];
-			gains[1] = gtmp[1];
+		speaker_ids[0] = _speakers->speaker_for_tuple (tuple, 0);
+		speaker_ids[1] = _speakers->speaker_for_tuple (tuple, 1);
 
-			speaker_ids[0] = _speakers->speaker_for_tuple (i, 0);
-			speaker_ids[1] = _speakers->speaker_for_tuple (i, 1);
-
-			if (_speakers->dimension() == 3) {
-				gains[2] = gtmp[2];
-				speaker_ids[2] = _speakers->speaker_for_tuple (i, 2);
-			} else {
-				gains[2] = 0.0;
-				speaker_ids[2] = -1;
-			}
+		if (dimension == 3) {
+			speaker_ids[2] = _speakers->speaker_for_tuple (tuple, 2);
+		} else {
+			gains[2] = 0.0;
+			speaker_ids[2] = -1;
 		}
 	}
 
@@ -238,9 +225,12 @@ VBAPanner::distribute (BufferSet& inbufs, BufferSet& obufs, gain_t gain_coeffici
 void
 VBAPanner::distribute_one (AudioBuffer& srcbuf, BufferSet& obufs, gain_t gain_coefficient, pframes_t nframes, uint32_t which)
 {
-	Sample* const src = srcbuf.data();
-        Signal* signal (_signals[which]);
+	distribute_block (srcbuf.data(), obufs, gain_coefficient, 0, nframes, _signals[which]);
+}
 
+void
+VBAPanner::distribute_block (Sample const * src, BufferSet& obufs, gain_t gain_coefficient, pframes_t offset, pframes_t nframes, Signal* signal)
+{
 	/* VBAP may distribute the signal across up to 3 speakers depending on
 	   the configuration of the speakers.
 
@@ -259,45 +249,9 @@ VBAPanner::distribute_one (AudioBuffer& srcbuf, BufferSet& obufs, gain_t gain_co
            functions and not assignment/copying.
 	*/
 
-        vector<double>::size_type sz = signal->gains.size();
-
-        assert (sz == obufs.count().n_audio());
-
-        int8_t *outputs = (int8_t*)alloca(sz); // on the stack, no malloc
-
-        /* set initial state of each output "record"
-         */
-
-        for (uint32_t o = 0; o < sz; ++o) {
-                outputs[o] = 0;
-        }
+        assert (signal->gains.size() == obufs.count().n_audio());
 
-        /* for all outputs used this time and last time,
-           change the output record to show what has
-           happened.
-        */
-
-
-        for (int o = 0; o < 3; ++o) {
-                if (signal->outputs[o] != -1) {
-                        /* used last time */
-                        outputs[signal->outputs[o]] |= 1;
-                }
-
-                if (signal->desired_outputs[o] != -1) {
-                        /* used this time */
-                        outputs[signal->desired_outputs[o]] |= 1<<1;
-                }
-        }
-
-        /* at this point, we can test a speaker's status:
-
-           (*outputs[o] & 1)      <= in use before
-           (*outputs[o] & 2)      <= in use this time
-           (*outputs[o] & 3) == 3 <= in use both times
-            *outputs[o] == 0      <= not in use either time
-
-        */
+	src += offset;
 
 	for (int o = 0; o < 3; ++o) {
                 pan_t pan;
@@ -322,7 +276,7 @@ VBAPanner::distribute_one (AudioBuffer& srcbuf, BufferSet& obufs, gain_t gain_co
                         */
 
                         AudioBuffer& buf (obufs.get_audio (output));
-                        buf.accumulate_with_ramped_gain_from (srcbuf.data(), nframes, signal->gains[output], pan, 0);
+                        buf.accumulate_with_ramped_gain_from (src, nframes, signal->gains[output], pan, offset);
                         signal->gains[output] = pan;
 
                 } else {
@@ -330,7 +284,7 @@ VBAPanner::distribute_one (AudioBuffer& srcbuf, BufferSet& obufs, gain_t gain_co
                         /* signal to this output, same gain as before so just copy with gain
                          */
 
-                        mix_buffers_with_gain (obufs.get_audio (output).data(),src,nframes,pan);
+                        mix_buffers_with_gain (obufs.get_audio (output).data() + offset, src, nframes, pan);
                         signal->gains[output] = pan;
                 }
 	}
@@ -338,13 +292,28 @@ VBAPanner::distribute_one (AudioBuffer& srcbuf, BufferSet& obufs, gain_t gain_co
         /* clean up the outputs that were used last time but not this time
          */
 
-        for (uint32_t o = 0; o < sz; ++o) {
-                if (outputs[o] == 1) {
+        for (int o = 0; o < 3; ++o) {
+                const int output = signal->outputs[o];
+
+                if (output == -1 || signal->gains[output] == 0.0) {
+                        continue;
+                }
+
+                bool still_used = false;
+
+                for (int d = 0; d < 3; ++d) {
+                        if (signal->desired_outputs[d] == output) {
+                                still_used = true;
+                                break;
+                        }
+                }
+
+                if (!still_used) {
                         /* take signal and deliver with a rapid fade out
                          */
-                        AudioBuffer& buf (obufs.get_audio (o));
-                        buf.accumulate_with_ramped_gain_from (srcbuf.data(), nframes, signal->gains[o], 0.0, 0);
-                        signal->gains[o] = 0.0;
+                        AudioBuffer& buf (obufs.get_audio (output));
+                        buf.accumulate_with_ramped_gain_from (src, nframes, signal->gains[output], 0.0, offset);
+                        signal->gains[output] = 0.0;
                 }
         }
 
@@ -355,11 +324,66 @@ VBAPanner::distribute_one (AudioBuffer& srcbuf, BufferSet& obufs, gain_t gain_co
 }
 
 void
-VBAPanner::distribute_one_automated (AudioBuffer& /*src*/, BufferSet& /*obufs*/,
-                                     framepos_t /*start*/, framepos_t /*end*/,
-				     pframes_t /*nframes*/, pan_t** /*buffers*/, uint32_t /*which*/)
+VBAPanner::distribute_one_automated (AudioBuffer& srcbuf, BufferSet& obufs,
+                                     framepos_t start, framepos_t end,
+				     pframes_t nframes, pan_t** buffers, uint32_t which)
 {
-	/* XXX to be implemented */
+	Signal* signal (_signals[which]);
+	pan_t* const azimuth = buffers[0];
+	pan_t* width = 0;
+	pan_t* elevation = 0;
+
+	/* fetch positional data; width and elevation are only
+	   read per-sample when they are automated themselves.
+	*/
+
+	if (!_pannable->pan_azimuth_control->list()->curve().rt_safe_get_vector (start, end, azimuth, nframes)) {
+		/* fallback */
+		distribute_one (srcbuf, obufs, 1.0, nframes, which);
+		memcpy (signal->outputs, signal->desired_outputs, sizeof (signal->outputs));
+		return;
+	}
+
+	if (_signals.size() > 1 && _pannable->pan_width_control->automation_playback()) {
+		width = buffers[1];
+		if (!_pannable->pan_width_control->list()->curve().rt_safe_get_vector (start, end, width, nframes)) {
+			width = 0;
+		}
+	}
+
+	if (_speakers->dimension() == 3 && _pannable->pan_elevation_control->automation_playback()) {
+		elevation = buffers[2];
+		if (!_pannable->pan_elevation_control->list()->curve().rt_safe_get_vector (start, end, elevation, nframes)) {
+			elevation = 0;
+		}
+	}
+
+	const double fixed_width = _pannable->pan_width_control->get_value();
+	const double fixed_elevation = _pannable->pan_elevation_control->get_value();
+
+	/* Each block pans to the position found at its last frame, with the
+	   gains of every speaker involved ramping from where the previous
+	   block left them. Speaker selection comes from the precomputed
+	   lookup in VBAPSpeakers, so this costs little more per block than
+	   a few multiplies.
+	*/
+
+	for (pframes_t offset = 0; offset < nframes; offset += automation_block_size) {
+
+		const pframes_t len = (nframes - offset < automation_block_size) ? nframes - offset : automation_block_size;
+		const pframes_t last = offset + len - 1;
+
+		signal->direction = direction_for_signal (which,
+		                                          azimuth[last],
+		                                          width ? width[last] : fixed_width,
+		                                          elevation ? elevation[last] : fixed_elevation);
+
+		compute_gains (signal->desired_gains, signal->desired_outputs, signal->direction.azi, signal->direction.ele);
+
+		distribute_block (srcbuf.data(), obufs, 1.0, offset, len, signal);
+
+		memcpy (signal->outputs, signal->desired_outputs, sizeof (signal->outputs));
+	}
 }
 
 XMLNode&
@@ -82,10 +82,16 @@ private:
         std::vector<Signal*> _signals;
         boost::shared_ptr<VBAPSpeakers>  _speakers;
 
+	/* automated positions are evaluated once per block of this many
+	   frames, with gains interpolated across each block */
+	static const pframes_t automation_block_size = 64;
+
 	void compute_gains (double g[3], int ls[3], int azi, int ele);
+        PBD::AngularVector direction_for_signal (uint32_t which, double azimuth, double width, double elevation) const;
         void update ();
         void clear_signals ();
 
+	void distribute_block (Sample const * src, BufferSet& obufs, gain_t gain_coeff, pframes_t offset, pframes_t nframes, Signal* signal);
 	void distribute_one (AudioBuffer& src, BufferSet& obufs, gain_t gain_coeff, pframes_t nframes, uint32_t which);
 	void distribute_one_automated (AudioBuffer& src, BufferSet& obufs,
                                           framepos_t start, framepos_t end, pframes_t nframes,
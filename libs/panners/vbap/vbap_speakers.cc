@@ -75,6 +75,7 @@ VBAPSpeakers::update ()
 
 	if (_speakers.size() < 2) {
 		/* nothing to be done with less than two speakers */
+		build_tuple_grid ();
 		return;
 	}
 
@@ -88,6 +89,69 @@ VBAPSpeakers::update ()
 	} else {
 		choose_speaker_pairs ();
 	}
+
+	build_tuple_grid ();
+}
+
+int
+VBAPSpeakers::tuple_for_direction (int azi, int ele) const
+{
+	if (azi >= 0 && azi < grid_azimuths && ele >= 0 && ele < grid_elevations && !_tuple_grid.empty()) {
+		return _tuple_grid[ele * grid_azimuths + azi];
+	}
+
+	return search_tuple (azi, ele);
+}
+
+int
+VBAPSpeakers::search_tuple (int azi, int ele) const
+{
+	/* the tuple whose smallest gain for this direction is the largest */
+	double cartdir[3];
+	double big_sm_g = -100000.0;
+	int best = -1;
+
+	spherical_to_cartesian (azi, ele, 1.0, cartdir[0], cartdir[1], cartdir[2]);
+
+	for (int i = 0; i < n_tuples(); i++) {
+
+		double small_g = 10000000.0;
+
+		for (int j = 0; j < _dimension; j++) {
+
+			double g = 0.0;
+
+			for (int k = 0; k < _dimension; k++) {
+				g += cartdir[k] * _matrices[i][j * _dimension + k];
+			}
+
+			if (g < small_g) {
+				small_g = g;
+			}
+		}
+
+		if (small_g > big_sm_g) {
+			big_sm_g = small_g;
+			best = i;
+		}
+	}
+
+	return best;
+}
+
+void
+VBAPSpeakers::build_tuple_grid ()
+{
+	/* the grid is only ever resized once, so that a process thread
+	   looking up a direction never sees it reallocated.
+	*/
+	_tuple_grid.resize (grid_azimuths * grid_elevations);
+
+	for (int ele = 0; ele < grid_elevations; ++ele) {
+		for (int azi = 0; azi < grid_azimuths; ++azi) {
+			_tuple_grid[ele * grid_azimuths + azi] = search_tuple (azi, ele);
+		}
+	}
 }
 
 void
@@ -22,6 +22,8 @@
 #include <string>
 #include <vector>
 
+#include <stdint.h>
+
 #include <boost/utility.hpp>
 
 #include <pbd/signals.h>
@@ -38,9 +40,14 @@ public:
 	VBAPSpeakers (boost::shared_ptr<Speakers>);
 
 	typedef std::vector<double> dvector;
-	const dvector matrix (int tuple) const  { return _matrices[tuple]; }
+	const dvector& matrix (int tuple) const  { return _matrices[tuple]; }
 	int speaker_for_tuple (int tuple, int which) const { return _speaker_tuples[tuple][which]; }
 
+	/** @return the speaker pair or triplet to use for a direction,
+	 *  or -1 if there is none.
+	 */
+	int tuple_for_direction (int azi, int ele) const;
+
 	int           n_tuples () const  { return _matrices.size(); }
 	int           dimension() const { return _dimension; }
 
@@ -77,6 +84,14 @@ private:
 	std::vector<dvector>  _matrices;       /* holds matrices for a given speaker combinations */
 	std::vector<tmatrix>  _speaker_tuples; /* holds speakers IDs for a given combination */
 
+	/* tuple_for_direction() for every whole-degree direction that the
+	   panner produces (azimuth 0..360, elevation 0..90), so that panning
+	   does not have to search all speaker combinations.
+	*/
+	static const int grid_azimuths = 361;
+	static const int grid_elevations = 91;
+	std::vector<int16_t> _tuple_grid;
+
 	/* A struct for all loudspeakers */
 	struct ls_triplet_chain {
 		int ls_nos[3];
@@ -91,6 +106,8 @@ private:
 	static void   cross_prod(PBD::CartesianVector v1,PBD::CartesianVector v2, PBD::CartesianVector *res);
 
 	void update ();
+	int  search_tuple (int azi, int ele) const;
+	void build_tuple_grid ();
 	int  any_ls_inside_triplet (int a, int b, int c);
 	void add_ldsp_triplet (int i, int j, int k, struct ls_triplet_chain **ls_triplets);
 	int  lines_intersect (int i,int j,int k,int l);
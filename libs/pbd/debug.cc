@@ -51,6 +51,7 @@ DebugBits PBD::DEBUG::FileManager = PBD::new_debug_bit ("filemanager");
 DebugBits PBD::DEBUG::Pool = PBD::new_debug_bit ("pool");
 DebugBits PBD::DEBUG::EventLoop = PBD::new_debug_bit ("eventloop");
 DebugBits PBD::DEBUG::AbstractUI = PBD::new_debug_bit ("abstractui");
+DebugBits PBD::DEBUG::UIRequests = PBD::new_debug_bit ("uirequests");
 DebugBits PBD::DEBUG::FileUtils = PBD::new_debug_bit ("fileutils");
 DebugBits PBD::DEBUG::Configuration = PBD::new_debug_bit ("configuration");
 DebugBits PBD::DEBUG::UndoHistory = PBD::new_debug_bit ("undohistory");
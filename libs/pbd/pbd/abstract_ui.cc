@@ -64,6 +64,10 @@ Glib::Threads::Private<typename AbstractUI<R>::RequestBuffer> AbstractUI<R>::per
 template <typename RequestObject>
 AbstractUI<RequestObject>::AbstractUI (const string& name)
 	: BaseUI (name)
+	, request_stack (0)
+	, pending_requests (0)
+	, pending_requests_tail (0)
+	, wakeup_pending (0)
 {
 	void (AbstractUI<RequestObject>::*pmf)(pthread_t,string,uint32_t) = &AbstractUI<RequestObject>::register_thread;
 
@@ -185,16 +189,143 @@ AbstractUI<RequestObject>::get_request (RequestType rt)
 	return req;
 }
 
+/** Take everything pushed on to the request stack by threads without a
+ *  request buffer.
+ *  @return the requests, most recent first.
+ */
+template <typename RequestObject> PBD::EventLoop::BaseRequestObject*
+AbstractUI<RequestObject>::take_request_stack ()
+{
+	gpointer head;
+
+	do {
+		head = g_atomic_pointer_get (&request_stack);
+	} while (head && !g_atomic_pointer_compare_and_exchange (&request_stack, head, (gpointer) 0));
+
+	return (BaseRequestObject*) head;
+}
+
+/** Must be called with request_buffer_map_lock held, for requests from one
+ *  source in the reverse of the order they were sent, after clearing
+ *  coalesce_keys.
+ *  @return true if @param req was superseded by a later request and has
+ *  been marked invalid.
+ */
+template <typename RequestObject> bool
+AbstractUI<RequestObject>::coalesce (RequestObject* req)
+{
+	if (!req->valid) {
+		return false;
+	}
+
+	void* key = coalesce_key (req);
+
+	if (!key || coalesce_keys.insert (make_pair (req->type, key)).second) {
+		return false;
+	}
+
+	DEBUG_TRACE (PBD::DEBUG::AbstractUI, string_compose ("%1: request of type %2 superseded by a later one\n", event_loop_name(), req->type));
+
+	req->valid = false;
+
+	if (req->invalidation) {
+		req->invalidation->requests.remove (req);
+		req->invalidation = 0;
+	}
+
+	return true;
+}
+
+template <typename RequestObject> void
+AbstractUI<RequestObject>::add_latency (RequestObject const * req, int64_t& total_us, int64_t& max_us) const
+{
+	int64_t const latency = g_get_monotonic_time () - req->sent;
+
+	total_us += latency;
+	max_us = max (max_us, latency);
+}
+
 template <typename RequestObject> void
 AbstractUI<RequestObject>::handle_ui_requests ()
 {
 	RequestBufferMapIterator i;
 	RequestBufferVector vec;
+	uint32_t depth = 0;
+	uint64_t handled = 0;
+	uint64_t coalesced = 0;
+	int64_t total_latency_us = 0;
+	int64_t max_latency_us = 0;
+
+	/* any request sent from here on must wake the event loop again. This
+	 * has to happen before we look at the queues, so that a request can
+	 * never be left waiting without a wakeup.
+	 */
 
-	/* check all registered per-thread buffers first */
+	g_atomic_int_set (&wakeup_pending, 0);
 
 	request_buffer_map_lock.lock ();
 
+	/* move requests from threads without a buffer on to the end of the
+	 * pending list, in the order they were sent. They come off the stack
+	 * most recent first, which is the order coalescing needs.
+	 */
+
+	coalesce_keys.clear ();
+
+	RequestObject* oldest = 0;
+	RequestObject* newest = 0;
+
+	for (BaseRequestObject* r = take_request_stack (); r; ++depth) {
+		RequestObject* req = static_cast<RequestObject*> (r);
+		r = req->next;
+
+		if (coalesce (req)) {
+			++coalesced;
+		}
+
+		if (!newest) {
+			newest = req;
+		}
+
+		req->next = oldest;
+		oldest = req;
+	}
+
+	if (oldest) {
+		if (pending_requests_tail) {
+			pending_requests_tail->next = oldest;
+		} else {
+			pending_requests = oldest;
+		}
+		pending_requests_tail = newest;
+	}
+
+	/* drop requests from each registered thread that later requests from
+	 * the same thread make redundant
+	 */
+
+	for (i = request_buffers.begin(); i != request_buffers.end(); ++i) {
+
+		i->second->get_read_vector (&vec);
+		depth += vec.len[0] + vec.len[1];
+
+		coalesce_keys.clear ();
+
+		for (size_t n = vec.len[1]; n > 0; --n) {
+			if (coalesce (&vec.buf[1][n-1])) {
+				++coalesced;
+			}
+		}
+
+		for (size_t n = vec.len[0]; n > 0; --n) {
+			if (coalesce (&vec.buf[0][n-1])) {
+				++coalesced;
+			}
+		}
+	}
+
+	/* check all registered per-thread buffers first */
+
 	DEBUG_TRACE (PBD::DEBUG::AbstractUI, string_compose ("%1 check %2 request buffers for requests\n", event_loop_name(), request_buffers.size()));
 
 	for (i = request_buffers.begin(); i != request_buffers.end(); ++i) {
@@ -223,7 +354,9 @@ AbstractUI<RequestObject>::handle_ui_requests ()
 					DEBUG_TRACE (PBD::DEBUG::AbstractUI, string_compose ("%1: valid request, unlocking before calling\n", event_loop_name()));
 					request_buffer_map_lock.unlock ();
 					DEBUG_TRACE (PBD::DEBUG::AbstractUI, string_compose ("%1: valid request, calling ::do_request()\n", event_loop_name()));
+					add_latency (vec.buf[0], total_latency_us, max_latency_us);
 					do_request (vec.buf[0]);
+					++handled;
 
 					/* if the request was CallSlot, then we need to ensure that we reset the functor in the request, in case it
 					 * held a shared_ptr<>. Failure to do so can lead to dangling references to objects passed to PBD::Signals.
@@ -274,13 +407,20 @@ AbstractUI<RequestObject>::handle_ui_requests ()
 
 	request_buffer_map_lock.unlock ();
 
-	/* and now, the generic request buffer. same rules as above apply */
+	/* and now, the requests from threads without a buffer. same rules as
+	 * above apply. Each request is taken off the pending list before it
+	 * is executed, so a recursive call carries on where we left off.
+	 */
+
+	while (pending_requests) {
 
-	Glib::Threads::Mutex::Lock lm (request_list_lock);
+		RequestObject* req = pending_requests;
 
-	while (!request_list.empty()) {
-		RequestObject* req = request_list.front ();
-		request_list.pop_front ();
+		pending_requests = static_cast<RequestObject*> (req->next);
+		if (!pending_requests) {
+			pending_requests_tail = 0;
+		}
+		req->next = 0;
 
 		/* We need to use this lock, because its the one
 		 * returned by slot_invalidation_mutex() and protects
@@ -322,13 +462,6 @@ AbstractUI<RequestObject>::handle_ui_requests ()
 
 		request_buffer_map_lock.unlock ();
 
-		/* unlock the request lock while we execute the request, so
-		 * that we don't needlessly block other threads (note: not RT
-		 * threads since they have their own queue) from making requests.
-		 */
-
-		lm.release ();
-
 		DEBUG_TRACE (PBD::DEBUG::AbstractUI, string_compose ("%1/%2 execute request type %3\n", event_loop_name(), pthread_name(), req->type));
 
 		/* and lets do it ... this is a virtual call so that each
@@ -336,15 +469,36 @@ AbstractUI<RequestObject>::handle_ui_requests ()
 		 * some kind of central request type registration logic
 		 */
 
+		add_latency (req, total_latency_us, max_latency_us);
 		do_request (req);
+		++handled;
 
 		DEBUG_TRACE (PBD::DEBUG::AbstractUI, string_compose ("%1/%2 delete heap request type %3\n", event_loop_name(), pthread_name(), req->type));
 		delete req;
+	}
 
-		/* re-acquire the list lock so that we check again */
+	Glib::Threads::Mutex::Lock lm (stats_lock);
 
-		lm.acquire();
-	}
+	++stats.wakeups;
+	stats.handled += handled;
+	stats.coalesced += coalesced;
+	stats.max_depth = max (stats.max_depth, depth);
+	stats.total_latency_us += total_latency_us;
+	stats.max_latency_us = max (stats.max_latency_us, max_latency_us);
+}
+
+template <typename RequestObject> typename AbstractUI<RequestObject>::RequestStats
+AbstractUI<RequestObject>::request_stats () const
+{
+	Glib::Threads::Mutex::Lock lm (stats_lock);
+	return stats;
+}
+
+template <typename RequestObject> void
+AbstractUI<RequestObject>::reset_request_stats ()
+{
+	Glib::Threads::Mutex::Lock lm (stats_lock);
+	stats = RequestStats ();
 }
 
 template <typename RequestObject> void
@@ -382,23 +536,33 @@ AbstractUI<RequestObject>::send_request (RequestObject *req)
 
 		RequestBuffer* rbuf = per_thread_request_buffer.get ();
 
+		req->sent = g_get_monotonic_time ();
+
 		if (rbuf != 0) {
 			DEBUG_TRACE (PBD::DEBUG::AbstractUI, string_compose ("%1/%2 send per-thread request type %3 using ringbuffer @ %4\n", event_loop_name(), pthread_name(), req->type, rbuf));
 			rbuf->increment_write_ptr (1);
 		} else {
-			/* no per-thread buffer, so just use a list with a lock so that it remains
-			   single-reader/single-writer semantics
+			/* no per-thread buffer, so push the request on to the
+			   lock-free stack that any thread may add to
 			*/
 			DEBUG_TRACE (PBD::DEBUG::AbstractUI, string_compose ("%1/%2 send heap request type %3\n", event_loop_name(), pthread_name(), req->type));
-			Glib::Threads::Mutex::Lock lm (request_list_lock);
-			request_list.push_back (req);
+
+			gpointer head;
+
+			do {
+				head = g_atomic_pointer_get (&request_stack);
+				req->next = (BaseRequestObject*) head;
+			} while (!g_atomic_pointer_compare_and_exchange (&request_stack, head, (gpointer) static_cast<BaseRequestObject*> (req)));
 		}
 
 		/* send the UI event loop thread a wakeup so that it will look
-		   at the per-thread and generic request lists.
+		   at the per-thread and generic request lists, unless it has
+		   been woken already and has not yet started to look.
 		*/
 
-		signal_new_request ();
+		if (g_atomic_int_compare_and_exchange (&wakeup_pending, 0, 1)) {
+			signal_new_request ();
+		}
 	}
 }
 
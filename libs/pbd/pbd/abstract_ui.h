@@ -21,6 +21,7 @@
 #define __pbd_abstract_ui_h__
 
 #include <map>
+#include <set>
 #include <string>
 #include <pthread.h>
 
@@ -66,6 +67,20 @@ class ABSTRACT_UI_API AbstractUI : public BaseUI
 
 	static void* request_buffer_factory (uint32_t num_requests);
 
+	/** Counts of the requests handled by this UI's event loop */
+	struct RequestStats {
+		RequestStats () : wakeups (0), handled (0), coalesced (0), max_depth (0), total_latency_us (0), max_latency_us (0) {}
+		uint64_t wakeups;          ///< number of times queued requests were handled
+		uint64_t handled;          ///< requests executed
+		uint64_t coalesced;        ///< requests dropped because a later one superseded them
+		uint32_t max_depth;        ///< most requests found waiting at one wakeup
+		int64_t  total_latency_us; ///< total time from sending to executing requests
+		int64_t  max_latency_us;   ///< longest time from sending to executing a request
+	};
+
+	RequestStats request_stats () const;
+	void reset_request_stats ();
+
   protected:
 	struct RequestBuffer : public PBD::RingBufferNPT<RequestObject> {
                 bool dead;
@@ -93,15 +108,44 @@ class ABSTRACT_UI_API AbstractUI : public BaseUI
 	RequestBufferMap request_buffers;
         static Glib::Threads::Private<RequestBuffer> per_thread_request_buffer;
 
-	Glib::Threads::Mutex               request_list_lock;
-	std::list<RequestObject*> request_list;
+	/* Requests from threads without a request buffer are heap allocated
+	   and pushed on to a lock-free stack, which the event loop takes in
+	   one go and appends, in order, to the pending list.
+	*/
+	volatile gpointer request_stack;
+	RequestObject*    pending_requests;
+	RequestObject*    pending_requests_tail;
+
+	/* non-zero while the event loop has been woken but has not yet
+	   started to look at requests, so that senders don't wake it again
+	*/
+	mutable gint wakeup_pending;
+
+	mutable Glib::Threads::Mutex stats_lock;
+	RequestStats                 stats;
+
+	typedef std::set<std::pair<RequestType,void*> > CoalesceKeys;
+	CoalesceKeys coalesce_keys;
 
 	RequestObject* get_request (RequestType);
 	void handle_ui_requests ();
 	void send_request (RequestObject *);
 
 	virtual void do_request (RequestObject *) = 0;
+
+	/** Derived UIs may return a non-null key for requests that only need
+	 *  to be carried out once however many times they are sent, such as
+	 *  redrawing an object. Of several waiting requests of the same type
+	 *  and key, only the most recent is carried out.
+	 */
+	virtual void* coalesce_key (RequestObject const *) const { return 0; }
+
 	PBD::ScopedConnection new_thread_connection;
+
+  private:
+	BaseRequestObject* take_request_stack ();
+	bool coalesce (RequestObject*);
+	void add_latency (RequestObject const *, int64_t& total_us, int64_t& max_us) const;
 };
 
 #endif /* __pbd_abstract_ui_h__ */
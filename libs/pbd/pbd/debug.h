@@ -53,6 +53,7 @@ namespace PBD {
 		LIBPBD_API extern DebugBits Pool;
 		LIBPBD_API extern DebugBits EventLoop;
 		LIBPBD_API extern DebugBits AbstractUI;
+		LIBPBD_API extern DebugBits UIRequests;
 		LIBPBD_API extern DebugBits Configuration;
 		LIBPBD_API extern DebugBits FileUtils;
 		LIBPBD_API extern DebugBits UndoHistory;
@@ -60,8 +60,9 @@ class LIBPBD_API EventLoop
 	    PBD::EventLoop* event_loop;
 	    const char* file;
 	    int line;
+	    bool coalesce; ///< only the most recent of the waiting requests needs to be carried out
 
-	    InvalidationRecord() : event_loop (0) {}
+	    InvalidationRecord() : event_loop (0), coalesce (false) {}
         };
 
         static void* invalidate_request (void* data);
@@ -71,8 +72,10 @@ class LIBPBD_API EventLoop
             bool                    valid;
             InvalidationRecord*     invalidation;
 	    boost::function<void()> the_slot;
+	    int64_t                 sent;  ///< g_get_monotonic_time() when it was sent, for latency statistics
+	    BaseRequestObject*      next;  ///< chains requests from threads without a request buffer
 
-            BaseRequestObject() : valid (true), invalidation (0) {}
+            BaseRequestObject() : valid (true), invalidation (0), sent (0), next (0) {}
 	};
 
 	virtual void call_slot (InvalidationRecord*, const boost::function<void()>&) = 0;
@@ -0,0 +1,136 @@
+/*
+    Copyright (C) 2016 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __pbd_mpmc_queue_h__
+#define __pbd_mpmc_queue_h__
+
+#include <glib.h>
+
+#include "pbd/libpbd_visibility.h"
+
+namespace PBD {
+
+/** A fixed-size, lock-free FIFO queue that any number of threads may
+ *  push() to and pop() from (D. Vyukov's bounded queue).
+ *
+ *  Each cell carries a sequence number that tells a thread whether the
+ *  cell is ready to be written or read for its turn around the buffer,
+ *  so a thread only ever contends for the head or tail index. Nothing is
+ *  allocated after construction, so both operations are realtime safe.
+ *  The queue never grows: push() fails if it is full.
+ */
+template<class T>
+class /*LIBPBD_API*/ MPMCQueue
+{
+  public:
+	MPMCQueue (guint sz) {
+		guint power_of_two;
+		for (power_of_two = 1; 1U<<power_of_two < sz; power_of_two++) {}
+		size = 1<<power_of_two;
+		size_mask = size - 1;
+		cells = new Cell[size];
+		for (guint i = 0; i < size; ++i) {
+			g_atomic_int_set (&cells[i].sequence, i);
+		}
+		g_atomic_int_set (&enqueue_pos, 0);
+		g_atomic_int_set (&dequeue_pos, 0);
+	}
+
+	~MPMCQueue () {
+		delete [] cells;
+	}
+
+	guint bufsize () const { return size; }
+
+	/** @return an approximation of the number of queued items, which is
+	 *  only exact when no other thread is using the queue.
+	 */
+	guint read_space () const {
+		gint n = (gint) ((guint) g_atomic_int_get (&enqueue_pos) - (guint) g_atomic_int_get (&dequeue_pos));
+		return n > 0 ? n : 0;
+	}
+
+	/** Any thread. @return false if the queue is full */
+	bool push (T const & x) {
+		guint pos = g_atomic_int_get (&enqueue_pos);
+		Cell* cell;
+
+		while (true) {
+			cell = &cells[pos & size_mask];
+			gint dif = (gint) ((guint) g_atomic_int_get (&cell->sequence) - pos);
+			if (dif == 0) {
+				/* the cell is free for this turn: claim it */
+				if (g_atomic_int_compare_and_exchange (&enqueue_pos, (gint) pos, (gint) (pos + 1))) {
+					break;
+				}
+			} else if (dif < 0) {
+				/* the cell still holds an item from the previous turn */
+				return false;
+			}
+			pos = g_atomic_int_get (&enqueue_pos);
+		}
+
+		cell->data = x;
+		/* publish the item to readers */
+		g_atomic_int_set (&cell->sequence, pos + 1);
+		return true;
+	}
+
+	/** Any thread. @return false if the queue is empty */
+	bool pop (T& x) {
+		guint pos = g_atomic_int_get (&dequeue_pos);
+		Cell* cell;
+
+		while (true) {
+			cell = &cells[pos & size_mask];
+			gint dif = (gint) ((guint) g_atomic_int_get (&cell->sequence) - (pos + 1));
+			if (dif == 0) {
+				/* the cell holds an item for this turn: claim it */
+				if (g_atomic_int_compare_and_exchange (&dequeue_pos, (gint) pos, (gint) (pos + 1))) {
+					break;
+				}
+			} else if (dif < 0) {
+				/* nothing written to the cell yet */
+				return false;
+			}
+			pos = g_atomic_int_get (&dequeue_pos);
+		}
+
+		x = cell->data;
+		/* hand the cell back to writers for the next turn */
+		g_atomic_int_set (&cell->sequence, pos + size);
+		return true;
+	}
+
+  private:
+	struct Cell {
+		mutable gint sequence;
+		T            data;
+	};
+
+	Cell* cells;
+	guint size;
+	guint size_mask;
+	mutable gint enqueue_pos;
+	mutable gint dequeue_pos;
+};
+
+} /* namespace */
+
+#endif /* __pbd_mpmc_queue_h__ */
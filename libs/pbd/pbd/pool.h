@@ -27,6 +27,7 @@
 
 #include "pbd/libpbd_visibility.h"
 #include "pbd/ringbuffer.h"
+#include "pbd/mpmc_queue.h"
 
 /** A pool of data items that can be allocated, read from and written to
  *  without system memory allocation or locking.
@@ -41,7 +42,7 @@ class LIBPBD_API Pool
 	virtual void release (void *);
 
 	std::string name() const { return _name; }
-	guint available() const { return free_list.read_space(); }
+	virtual guint available() const { return free_list.read_space(); }
 	guint used() const { return free_list.bufsize() - available(); }
 	guint total() const { return free_list.bufsize(); }
 
@@ -56,6 +57,10 @@ class LIBPBD_API Pool
 #endif
 };
 
+/** A pool that one thread allocates from and any number of threads
+ *  release to. The free list is a lock-free queue, so no release
+ *  ever waits for another.
+ */
 class LIBPBD_API SingleAllocMultiReleasePool : public Pool
 {
   public:
@@ -65,11 +70,17 @@ class LIBPBD_API SingleAllocMultiReleasePool : public Pool
 	virtual void *alloc ();
 	virtual void release (void *);
 
+	guint available() const { return mt_free_list.read_space(); }
+
   private:
-        Glib::Threads::Mutex m_lock;
+	PBD::MPMCQueue<void*> mt_free_list;
 };
 
 
+/** A pool that any number of threads allocate from and one thread
+ *  releases to. The free list is a lock-free queue, so no allocation
+ *  ever waits for another.
+ */
 class LIBPBD_API MultiAllocSingleReleasePool : public Pool
 {
   public:
@@ -79,8 +90,10 @@ class LIBPBD_API MultiAllocSingleReleasePool : public Pool
 	virtual void *alloc ();
 	virtual void release (void *);
 
+	guint available() const { return mt_free_list.read_space(); }
+
   private:
-        Glib::Threads::Mutex m_lock;
+	PBD::MPMCQueue<void*> mt_free_list;
 };
 
 class LIBPBD_API PerThreadPool;
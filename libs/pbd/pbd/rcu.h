@@ -49,13 +49,34 @@ class /*LIBPBD_API*/ RCUManager
 {
   public:
 
-	RCUManager (T* new_rcu_value) {
+	/** @param count_reads true to count reader() calls in progress, so that
+	    update() can wait for them before deleting the old value's holder.
+	    This costs every reader() two atomic read-modify-writes, so it is only
+	    worth it for managers that are written often while being read.
+	*/
+	RCUManager (T* new_rcu_value, bool count_reads = false)
+		: _count_reads (count_reads)
+	{
 		x.m_rcu_value = new boost::shared_ptr<T> (new_rcu_value);
+		g_atomic_int_set (&_active_reads, 0);
 	}
 
 	virtual ~RCUManager() { delete x.m_rcu_value; }
 
-	boost::shared_ptr<T> reader () const { return *((boost::shared_ptr<T> *) g_atomic_pointer_get (&x.gptr)); }
+	boost::shared_ptr<T> reader () const {
+		if (!_count_reads) {
+			return *((boost::shared_ptr<T> *) g_atomic_pointer_get (&x.gptr));
+		}
+
+		boost::shared_ptr<T> rv;
+		/* announce the read, so that update() will not delete the
+		   shared_ptr<T> that we are copying from under us.
+		*/
+		g_atomic_int_inc (&_active_reads);
+		rv = *((boost::shared_ptr<T> *) g_atomic_pointer_get (&x.gptr));
+		g_atomic_int_dec_and_test (&_active_reads);
+		return rv;
+	}
 
 	/* this is an abstract base class - how these are implemented depends on the assumptions
 	   that one can make about the users of the RCUManager. See SerializedRCUManager below
@@ -79,6 +100,11 @@ class /*LIBPBD_API*/ RCUManager
 	    boost::shared_ptr<T>* m_rcu_value;
 	    mutable volatile gpointer gptr;
 	} x;
+
+	bool const _count_reads;
+
+	/** The number of reader() calls in progress, if _count_reads */
+	mutable volatile gint _active_reads;
 };
 
 
@@ -109,14 +135,17 @@ class /*LIBPBD_API*/ RCUManager
    flush() method that will unconditionally clear out the "dead wood" list. It
    must be used with significant caution, although the use of shared_ptr<T>
    means that no actual objects will be deleted incorrectly if this is misused.
+   A reader still holding an old value would delete it, though, which may be
+   in a realtime thread. cleanup() only removes what no reader is using, and
+   so is safe to call at any time from the writer's side.
 */
 template<class T>
 class /*LIBPBD_API*/ SerializedRCUManager : public RCUManager<T>
 {
 public:
 
-	SerializedRCUManager(T* new_rcu_value)
-		: RCUManager<T>(new_rcu_value)
+	SerializedRCUManager(T* new_rcu_value, bool count_reads = false)
+		: RCUManager<T>(new_rcu_value, count_reads)
 	{
 	}
 
@@ -124,17 +153,7 @@ public:
 	{
 		m_lock.lock();
 
-		// clean out any dead wood
-
-		typename std::list<boost::shared_ptr<T> >::iterator i;
-
-		for (i = m_dead_wood.begin(); i != m_dead_wood.end(); ) {
-			if ((*i).unique()) {
-				i = m_dead_wood.erase (i);
-			} else {
-				++i;
-			}
-		}
+		clean_dead_wood ();
 
 		/* store the current so that we can do compare and exchange
 		   when someone calls update(). Notice that we hold
@@ -174,6 +193,19 @@ public:
 
 			m_dead_wood.push_back (*current_write_old);
 
+			// a reader may have fetched the old pointer just before
+			// the exchange and still be copying from it; wait for it.
+			// readers that start now will see the new value. The copy
+			// is short, so yield at first, then sleep.
+
+			for (int n = 0; g_atomic_int_get (&this->_active_reads) != 0; ++n) {
+				if (n < 16) {
+					g_thread_yield ();
+				} else {
+					g_usleep (20);
+				}
+			}
+
 			// now delete it - this gets rid of the shared_ptr<T> but
 			// because dead_wood contains another shared_ptr<T> that
 			// references the same T, the underlying object lives on
@@ -188,12 +220,45 @@ public:
 		return ret;
 	}
 
+	/* for writers that build the new value from scratch: unlike
+	   write_copy()/update() this does not copy the current value first.
+	*/
+	bool replace (boost::shared_ptr<T> new_value)
+	{
+		m_lock.lock();
+
+		clean_dead_wood ();
+
+		current_write_old = RCUManager<T>::x.m_rcu_value;
+
+		return update (new_value);
+	}
+
 	void flush () {
 		Glib::Threads::Mutex::Lock lm (m_lock);
 		m_dead_wood.clear ();
 	}
 
+	void cleanup () {
+		Glib::Threads::Mutex::Lock lm (m_lock);
+		clean_dead_wood ();
+	}
+
 private:
+	/* called with m_lock held */
+	void clean_dead_wood ()
+	{
+		typename std::list<boost::shared_ptr<T> >::iterator i;
+
+		for (i = m_dead_wood.begin(); i != m_dead_wood.end(); ) {
+			if ((*i).unique()) {
+				i = m_dead_wood.erase (i);
+			} else {
+				++i;
+			}
+		}
+	}
+
 	Glib::Threads::Mutex                      m_lock;
 	boost::shared_ptr<T>*            current_write_old;
 	std::list<boost::shared_ptr<T> > m_dead_wood;
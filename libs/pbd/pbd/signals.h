@@ -21,7 +21,7 @@
 #define __pbd_signals_h__
 
 #include <list>
-#include <map>
+#include <vector>
 
 #ifdef nil
 #undef nil
@@ -38,6 +38,7 @@
 
 #include "pbd/libpbd_visibility.h"
 #include "pbd/event_loop.h"
+#include "pbd/rcu.h"
 
 #ifndef NDEBUG
 #define DEBUG_PBD_SIGNAL_CONNECTIONS
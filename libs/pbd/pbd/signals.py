@@ -101,18 +101,28 @@ def signal(f, n, v):
     print("private:", file=f)
 
     print("""
-	/** The slots that this signal will call on emission */
-	typedef std::map<boost::shared_ptr<Connection>, slot_function_type> Slots;
-	Slots _slots;
+	/** The slots that this signal will call on emission, in the order that
+	    they were connected. The list is never modified once published;
+	    (dis)connection publishes a new copy, so emission can use the list
+	    without taking a lock.
+	*/
+	typedef std::vector<std::pair<boost::shared_ptr<Connection>, slot_function_type> > Slots;
+	SerializedRCUManager<Slots> _slots;
+
+	/** Incremented each time a slot is disconnected */
+	mutable gint _generation;
 """, file=f)
 
     print("public:", file=f)
     print("", file=f)
+    print("\tSignal%d () : _slots (new Slots, true), _generation (0) {}" % n, file=f)
+    print("", file=f)
     print("\t~Signal%d () {" % n, file=f)
 
     print("\t\tGlib::Threads::Mutex::Lock lm (_mutex);", file=f)
+    print("\t\tboost::shared_ptr<Slots> s = _slots.reader ();", file=f)
     print("\t\t/* Tell our connection objects that we are going away, so they don't try to call us */", file=f)
-    print("\t\tfor (%sSlots::const_iterator i = _slots.begin(); i != _slots.end(); ++i) {" % typename, file=f)
+    print("\t\tfor (%sSlots::const_iterator i = s->begin(); i != s->end(); ++i) {" % typename, file=f)
 
     print("\t\t\ti->first->signal_going_away ();", file=f)
     print("\t\t}", file=f)
@@ -230,35 +240,30 @@ def signal(f, n, v):
     else:
         print("\ttypename C::result_type operator() (%s)" % comma_separated(Anan), file=f)
     print("\t{", file=f)
-    print("\t\t/* First, take a copy of our list of slots as it is now */", file=f)
+    print("\t\t/* First, get hold of our list of slots as it is now. This neither", file=f)
+    print("\t\t   locks nor allocates, and the list cannot change under us.", file=f)
+    print("\t\t*/", file=f)
     print("", file=f)
-    print("\t\tSlots s;", file=f)
-    print("\t\t{", file=f)
-    print("\t\t\tGlib::Threads::Mutex::Lock lm (_mutex);", file=f)
-    print("\t\t\ts = _slots;", file=f)
-    print("\t\t}", file=f)
+    print("\t\tboost::shared_ptr<Slots> s = _slots.reader ();", file=f)
+    print("\t\tgint const generation = g_atomic_int_get (&_generation);", file=f)
     print("", file=f)
     if not v:
         print("\t\tstd::list<R> r;", file=f)
-    print("\t\tfor (%sSlots::const_iterator i = s.begin(); i != s.end(); ++i) {" % typename, file=f)
+    print("\t\tfor (%sSlots::const_iterator i = s->begin(); i != s->end(); ++i) {" % typename, file=f)
     print("""
 			/* We may have just called a slot, and this may have resulted in
-			   disconnection of other slots from us.  The list copy means that
-			   this won't cause any problems with invalidated iterators, but we
-			   must check to see if the slot we are about to call is still on the list.
+			   disconnection of other slots from us. Our list is unaffected,
+			   but if anything has been disconnected since we started we
+			   must check that the slot we are about to call is still connected.
 			*/
-			bool still_there = false;
-			{
-				Glib::Threads::Mutex::Lock lm (_mutex);
-				still_there = _slots.find (i->first) != _slots.end ();
+			if (g_atomic_int_get (&_generation) != generation && !connected (i->first)) {
+				continue;
 			}
-
-			if (still_there) {""", file=f)
+""", file=f)
     if v:
-        print("\t\t\t\t(i->second)(%s);" % comma_separated(an), file=f)
+        print("\t\t\t(i->second)(%s);" % comma_separated(an), file=f)
     else:
-        print("\t\t\t\tr.push_back ((i->second)(%s));" % comma_separated(an), file=f)
-    print("\t\t\t}", file=f)
+        print("\t\t\tr.push_back ((i->second)(%s));" % comma_separated(an), file=f)
     print("\t\t}", file=f)
     print("", file=f)
     if not v:
@@ -269,8 +274,7 @@ def signal(f, n, v):
 
     print("""
 	bool empty () {
-		Glib::Threads::Mutex::Lock lm (_mutex);
-		return _slots.empty ();
+		return _slots.reader()->empty ();
 	}
 """, file=f)
 
@@ -293,7 +297,17 @@ def signal(f, n, v):
 #endif
 		boost::shared_ptr<Connection> c (new Connection (this));
 		Glib::Threads::Mutex::Lock lm (_mutex);
-		_slots[c] = f;
+		{
+			RCUWriter<Slots> writer (_slots);
+			boost::shared_ptr<Slots> s = writer.get_copy ();
+			s->push_back (std::make_pair (c, f));
+		}
+		/* drop our reference to the old list, unless an emission is
+		   still using it. Then it is released by a later (dis)connection,
+		   so that the emitter never frees it (and the slots' bound
+		   arguments) in its own, possibly realtime, thread.
+		*/
+		_slots.cleanup ();
 		return c;
 	}""", file=f)
 
@@ -301,10 +315,35 @@ def signal(f, n, v):
 	void disconnect (boost::shared_ptr<Connection> c)
 	{
 		Glib::Threads::Mutex::Lock lm (_mutex);
-		_slots.erase (c);
+		{
+			RCUWriter<Slots> writer (_slots);
+			boost::shared_ptr<Slots> s = writer.get_copy ();
+			for (%sSlots::iterator i = s->begin(); i != s->end(); ++i) {
+				if (i->first == c) {
+					s->erase (i);
+					break;
+				}
+			}
+		}
+		/* now that the new list is published, tell emitters to check
+		   the slots they are about to call
+		*/
+		g_atomic_int_inc (&_generation);
+		_slots.cleanup ();
 	}
-};    
-""", file=f)
+
+	bool connected (boost::shared_ptr<Connection> const & c) const
+	{
+		boost::shared_ptr<Slots> s = _slots.reader ();
+		for (%sSlots::const_iterator i = s->begin(); i != s->end(); ++i) {
+			if (i->first == c) {
+				return true;
+			}
+		}
+		return false;
+	}
+};
+""" % (typename, typename), file=f)
 
 for i in range(0, 6):
     signal(f, i, False)
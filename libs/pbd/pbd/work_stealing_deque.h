@@ -0,0 +1,138 @@
+/*
+    Copyright (C) 2016 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __pbd_work_stealing_deque_h__
+#define __pbd_work_stealing_deque_h__
+
+#include <glib.h>
+
+#include "pbd/libpbd_visibility.h"
+
+namespace PBD {
+
+/** A fixed-size, lock-free work-stealing deque (Chase & Lev, 2005).
+ *
+ *  One thread (the owner) may push() and pop() at the bottom end; any
+ *  number of other threads may steal() from the top end. Nothing is
+ *  allocated after construction, so all three operations are realtime
+ *  safe. The deque never grows: push() fails if it is full.
+ *
+ *  Indices run freely and wrap around; only their difference is used.
+ */
+template<class T>
+class /*LIBPBD_API*/ WorkStealingDeque
+{
+  public:
+	WorkStealingDeque (guint sz) {
+		guint power_of_two;
+		for (power_of_two = 1; 1U<<power_of_two < sz; power_of_two++) {}
+		size = 1<<power_of_two;
+		size_mask = size - 1;
+		buf = new T[size];
+		g_atomic_int_set (&top, 0);
+		g_atomic_int_set (&bottom, 0);
+	}
+
+	~WorkStealingDeque () {
+		delete [] buf;
+	}
+
+	guint bufsize () const { return size; }
+
+	/** @return an approximation of the number of queued items. It is
+	 *  only exact when called by the owner with no concurrent steal().
+	 */
+	guint read_space () const {
+		gint n = (gint) ((guint) g_atomic_int_get (&bottom) - (guint) g_atomic_int_get (&top));
+		return n > 0 ? n : 0;
+	}
+
+	/** Owner only. @return false if the deque is full */
+	bool push (T const & x) {
+		guint b = g_atomic_int_get (&bottom);
+		guint t = g_atomic_int_get (&top);
+		if ((gint) (b - t) >= (gint) size) {
+			return false;
+		}
+		buf[b & size_mask] = x;
+		/* publish the item; the store barrier orders it after the write above */
+		g_atomic_int_set (&bottom, b + 1);
+		return true;
+	}
+
+	/** Owner only. Take the most recently pushed item.
+	 *  @return false if the deque is empty
+	 */
+	bool pop (T& x) {
+		guint b = (guint) g_atomic_int_get (&bottom) - 1;
+		g_atomic_int_set (&bottom, b);
+		/* the (full) barrier in g_atomic_int_get orders the load of top
+		 * after the store to bottom, so a concurrent thief either sees the
+		 * reduced bottom or we see its incremented top.
+		 */
+		guint t = g_atomic_int_get (&top);
+		gint n = (gint) (b - t);
+
+		if (n < 0) {
+			/* empty */
+			g_atomic_int_set (&bottom, t);
+			return false;
+		}
+
+		x = buf[b & size_mask];
+
+		if (n > 0) {
+			/* more than one item left, no thief can reach this one */
+			return true;
+		}
+
+		/* last item: race against thieves for it */
+		bool const won = g_atomic_int_compare_and_exchange (&top, (gint) t, (gint) (t + 1));
+		g_atomic_int_set (&bottom, t + 1);
+		return won;
+	}
+
+	/** Any thread. Take the oldest item.
+	 *  @return false if the deque is empty or another thread won the race
+	 */
+	bool steal (T& x) {
+		guint t = g_atomic_int_get (&top);
+		guint b = g_atomic_int_get (&bottom);
+		if ((gint) (b - t) <= 0) {
+			return false;
+		}
+		T const item = buf[t & size_mask];
+		if (!g_atomic_int_compare_and_exchange (&top, (gint) t, (gint) (t + 1))) {
+			return false;
+		}
+		x = item;
+		return true;
+	}
+
+  private:
+	T*   buf;
+	guint size;
+	guint size_mask;
+	mutable gint top;
+	mutable gint bottom;
+};
+
+} /* namespace */
+
+#endif /* __pbd_work_stealing_deque_h__ */
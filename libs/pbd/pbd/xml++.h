@@ -77,6 +77,16 @@ public:
 	bool write() const;
 	bool write(const std::string& fn) { set_filename(fn); return write(); }
 
+	/** Read the tree from the binary cache file @a cache if it was written
+	 *  for the current contents of @a fn, otherwise parse @a fn (and try to
+	 *  update the cache).
+	 */
+	bool read_with_cache(const std::string& fn, const std::string& cache);
+	/** Write the tree to the binary cache file @a cache, to be used by
+	 *  read_with_cache() as long as @a fn does not change.
+	 */
+	bool write_cache(const std::string& fn, const std::string& cache) const;
+
 	void debug (FILE*) const;
 
 	const std::string& write_buffer() const;
@@ -85,10 +95,12 @@ public:
 
 private:
 	bool read_internal(bool validate);
+	bool read_cache(const std::string& fn, const std::string& cache);
 
 	std::string _filename;
 	XMLNode*    _root;
-	xmlDocPtr   _doc;
+	/** only created when needed by find() */
+	mutable xmlDocPtr _doc;
 	int         _compression;
 };
 
@@ -144,7 +156,6 @@ private:
 	std::string         _content;
 	XMLNodeList         _children;
 	XMLPropertyList     _proplist;
-	XMLPropertyMap      _propmap;
 	mutable XMLNodeList _selected_children;
 
 	void clear_lists ();
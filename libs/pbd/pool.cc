@@ -101,7 +101,13 @@ Pool::release (void *ptr)
 
 MultiAllocSingleReleasePool::MultiAllocSingleReleasePool (string n, unsigned long isize, unsigned long nitems)
 	: Pool (n, isize, nitems)
+	, mt_free_list (nitems)
 {
+	void* ptr;
+
+	while (free_list.read (&ptr, 1) == 1) {
+		mt_free_list.push (ptr);
+	}
 }
 
 MultiAllocSingleReleasePool::~MultiAllocSingleReleasePool ()
@@ -110,7 +116,13 @@ MultiAllocSingleReleasePool::~MultiAllocSingleReleasePool ()
 
 SingleAllocMultiReleasePool::SingleAllocMultiReleasePool (string n, unsigned long isize, unsigned long nitems)
 	: Pool (n, isize, nitems)
+	, mt_free_list (nitems)
 {
+	void* ptr;
+
+	while (free_list.read (&ptr, 1) == 1) {
+		mt_free_list.push (ptr);
+	}
 }
 
 SingleAllocMultiReleasePool::~SingleAllocMultiReleasePool ()
@@ -121,28 +133,40 @@ void*
 MultiAllocSingleReleasePool::alloc ()
 {
 	void *ptr;
-	Glib::Threads::Mutex::Lock guard (m_lock);
-	ptr = Pool::alloc ();
+
+	if (!mt_free_list.pop (ptr)) {
+		fatal << "CRITICAL: " << _name << " POOL OUT OF MEMORY - RECOMPILE WITH LARGER SIZE!!" << endmsg;
+		abort(); /*NOTREACHED*/
+		return 0;
+	}
+
 	return ptr;
 }
 
 void
 MultiAllocSingleReleasePool::release (void* ptr)
 {
-	Pool::release (ptr);
+	mt_free_list.push (ptr);
 }
 
 void*
 SingleAllocMultiReleasePool::alloc ()
 {
-	return Pool::alloc ();
+	void *ptr;
+
+	if (!mt_free_list.pop (ptr)) {
+		fatal << "CRITICAL: " << _name << " POOL OUT OF MEMORY - RECOMPILE WITH LARGER SIZE!!" << endmsg;
+		abort(); /*NOTREACHED*/
+		return 0;
+	}
+
+	return ptr;
 }
 
 void
 SingleAllocMultiReleasePool::release (void* ptr)
 {
-	Glib::Threads::Mutex::Lock guard (m_lock);
-	Pool::release (ptr);
+	mt_free_list.push (ptr);
 }
 
 /*-------------------------------------------------------*/
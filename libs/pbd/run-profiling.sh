@@ -0,0 +1,35 @@
+#!/bin/bash
+#
+# Run libpbd profiling tests.
+#
+# e.g. run-profiling.sh signal_emission 8 1000000
+#
+
+if [ "$1" == "" ]; then
+   echo "Syntax: run-profiling.sh [flag] <test> [<args>]"
+   exit 1;
+fi
+
+SCRIPTPATH=$( cd $(dirname $0) ; pwd -P )
+TOP="$SCRIPTPATH/../.."
+LIBS_DIR="$TOP/build/libs"
+
+export LD_LIBRARY_PATH=$LIBS_DIR/pbd:$LD_LIBRARY_PATH
+
+p=$1
+if [ "$p" == "--debug" -o "$p" == "--valgrind" -o "$p" == "--callgrind" ]; then
+  f=$p
+  p=$2
+  shift 1
+fi
+shift 1
+
+if [ "$f" == "--debug" ]; then
+        gdb --args $LIBS_DIR/pbd/$p "$@"
+elif [ "$f" == "--valgrind" ]; then
+        valgrind $LIBS_DIR/pbd/$p "$@"
+elif [ "$f" == "--callgrind" ]; then
+        valgrind --tool=callgrind $LIBS_DIR/pbd/$p "$@"
+else
+        $LIBS_DIR/pbd/$p "$@"
+fi
@@ -0,0 +1,173 @@
+#include <vector>
+#include <pthread.h>
+#include <sched.h>
+
+#include "pbd/mpmc_queue.h"
+#include "pbd/pool.h"
+
+#include "mpmc_queue_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MPMCQueueTest);
+
+using namespace std;
+using namespace PBD;
+
+static const guint n_producers = 4;
+static const guint items_per_producer = 50000;
+
+void
+MPMCQueueTest::testSingleThread ()
+{
+	MPMCQueue<int> q (5);
+
+	CPPUNIT_ASSERT_EQUAL (8U, q.bufsize ());
+
+	int x;
+	CPPUNIT_ASSERT (!q.pop (x));
+
+	/* go round the buffer a few times */
+	for (int i = 0; i < 20; ++i) {
+		for (int j = 0; j < 8; ++j) {
+			CPPUNIT_ASSERT (q.push (i * 8 + j));
+		}
+		CPPUNIT_ASSERT (!q.push (-1));
+		CPPUNIT_ASSERT_EQUAL (8U, q.read_space ());
+		for (int j = 0; j < 8; ++j) {
+			CPPUNIT_ASSERT (q.pop (x));
+			CPPUNIT_ASSERT_EQUAL (i * 8 + j, x);
+		}
+		CPPUNIT_ASSERT (!q.pop (x));
+	}
+}
+
+/* items carry the producer in the top byte and a sequence number below */
+
+struct QueueStress {
+	MPMCQueue<guint>* queue;
+	guint producer;
+};
+
+static void*
+queue_producer (void* arg)
+{
+	QueueStress* s = static_cast<QueueStress*> (arg);
+	guint const tag = s->producer << 24;
+
+	for (guint i = 0; i < items_per_producer; ++i) {
+		while (!s->queue->push (tag | i)) {
+			sched_yield ();
+		}
+	}
+	return 0;
+}
+
+void
+MPMCQueueTest::testQueueStress ()
+{
+	MPMCQueue<guint> queue (1024);
+	QueueStress stress[n_producers];
+	pthread_t threads[n_producers];
+	vector<guint> next (n_producers, 0);
+	guint const total = n_producers * items_per_producer;
+	guint x;
+
+	for (guint p = 0; p < n_producers; ++p) {
+		stress[p].queue = &queue;
+		stress[p].producer = p;
+		pthread_create (&threads[p], 0, queue_producer, &stress[p]);
+	}
+
+	for (guint n = 0; n < total; ) {
+		if (!queue.pop (x)) {
+			sched_yield ();
+			continue;
+		}
+		guint const p = x >> 24;
+		CPPUNIT_ASSERT (p < n_producers);
+		/* each producer's items arrive in order, and once */
+		CPPUNIT_ASSERT_EQUAL (next[p], x & 0xffffff);
+		++next[p];
+		++n;
+	}
+
+	for (guint p = 0; p < n_producers; ++p) {
+		pthread_join (threads[p], 0);
+	}
+
+	CPPUNIT_ASSERT (!queue.pop (x));
+}
+
+struct PoolStress {
+	Pool* pool;
+	MPMCQueue<void*>* handoff;
+};
+
+static void*
+pool_allocator (void* arg)
+{
+	PoolStress* s = static_cast<PoolStress*> (arg);
+
+	for (guint i = 0; i < items_per_producer; ++i) {
+		void* ptr = s->pool->alloc ();
+		/* nobody else may hold this item */
+		if (!g_atomic_int_compare_and_exchange ((gint*) ptr, 0, 1)) {
+			abort ();
+		}
+		while (!s->handoff->push (ptr)) {
+			sched_yield ();
+		}
+	}
+	return 0;
+}
+
+void
+MPMCQueueTest::testPoolStress ()
+{
+	/* several threads allocate, the test thread releases. The hand-off
+	 * queue is small enough that the pool can never run dry.
+	 */
+
+	guint const n_items = 200;
+
+	MultiAllocSingleReleasePool pool ("stress", sizeof (gint), n_items);
+	MPMCQueue<void*> handoff (n_items / 2);
+	PoolStress stress[n_producers];
+	pthread_t threads[n_producers];
+	guint const total = n_producers * items_per_producer;
+	vector<void*> items;
+
+	CPPUNIT_ASSERT_EQUAL (n_items, pool.available ());
+
+	/* mark every item as free */
+	for (guint i = 0; i < n_items; ++i) {
+		items.push_back (pool.alloc ());
+		*((gint*) items.back ()) = 0;
+	}
+	CPPUNIT_ASSERT_EQUAL (0U, pool.available ());
+	for (guint i = 0; i < n_items; ++i) {
+		pool.release (items[i]);
+	}
+
+	for (guint p = 0; p < n_producers; ++p) {
+		stress[p].pool = &pool;
+		stress[p].handoff = &handoff;
+		pthread_create (&threads[p], 0, pool_allocator, &stress[p]);
+	}
+
+	for (guint n = 0; n < total; ) {
+		void* ptr;
+		if (!handoff.pop (ptr)) {
+			sched_yield ();
+			continue;
+		}
+		CPPUNIT_ASSERT (g_atomic_int_compare_and_exchange ((gint*) ptr, 1, 0));
+		pool.release (ptr);
+		++n;
+	}
+
+	for (guint p = 0; p < n_producers; ++p) {
+		pthread_join (threads[p], 0);
+	}
+
+	CPPUNIT_ASSERT_EQUAL (n_items, pool.available ());
+}
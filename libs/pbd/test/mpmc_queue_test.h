@@ -0,0 +1,22 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * Stress the lock-free queue and the pools built on it from several
+ * threads at once, checking that nothing is lost or handed out twice.
+ * Their throughput is measured by the mpmc_queue profiling program in
+ * libs/ardour.
+ */
+class MPMCQueueTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (MPMCQueueTest);
+	CPPUNIT_TEST (testSingleThread);
+	CPPUNIT_TEST (testQueueStress);
+	CPPUNIT_TEST (testPoolStress);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void testSingleThread ();
+	void testQueueStress ();
+	void testPoolStress ();
+};
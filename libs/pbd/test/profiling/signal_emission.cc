@@ -0,0 +1,54 @@
+/* The cost of emitting a PBD signal with a number of slots connected. */
+
+#include <cstdlib>
+#include <iostream>
+
+#include <glib.h>
+
+#include "pbd/signals.h"
+
+using namespace std;
+
+class Counter
+{
+public:
+	Counter () : n (0) {}
+	void receiver (int x) { n += x; }
+	int n;
+};
+
+int
+main (int argc, char* argv[])
+{
+	int const n_slots = argc > 1 ? atoi (argv[1]) : 8;
+	int const n_emissions = argc > 2 ? atoi (argv[2]) : 1000000;
+
+	if (n_slots <= 0 || n_emissions <= 0) {
+		cerr << argv[0] << ": [<slots> [<emissions>]]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	PBD::Signal1<void, int> sig;
+	Counter* counters = new Counter[n_slots];
+	PBD::ScopedConnectionList connections;
+
+	for (int i = 0; i < n_slots; ++i) {
+		sig.connect_same_thread (connections, boost::bind (&Counter::receiver, &counters[i], _1));
+	}
+
+	gint64 const start = g_get_monotonic_time ();
+
+	for (int i = 0; i < n_emissions; ++i) {
+		sig (1);
+	}
+
+	gint64 const elapsed = g_get_monotonic_time () - start;
+
+	cout << n_emissions << " emissions to " << n_slots << " slots: "
+	     << (elapsed * 1000.0 / n_emissions) << " ns per emission" << endl;
+
+	connections.drop_connections ();
+	delete [] counters;
+
+	return 0;
+}
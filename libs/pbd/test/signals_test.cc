@@ -89,3 +89,77 @@ SignalsTest::testScopedConnectionList ()
 
 	CPPUNIT_ASSERT_EQUAL (1, N);
 }
+
+/** A receiver that disconnects another when it is called */
+class Disconnector
+{
+public:
+	Disconnector (PBD::ScopedConnection& c) : _c (c) {}
+
+	void receiver () {
+		++N;
+		_c.disconnect ();
+	}
+
+private:
+	PBD::ScopedConnection& _c;
+};
+
+void
+SignalsTest::testDisconnectDuringEmission ()
+{
+	Emitter* e = new Emitter;
+	PBD::ScopedConnection c;
+	PBD::ScopedConnection d;
+	Disconnector dis (d);
+
+	/* slots are called in the order they were connected, so the first
+	   slot disconnects the second before it would be called.
+	*/
+	e->Fred.connect_same_thread (c, boost::bind (&Disconnector::receiver, &dis));
+	e->Fred.connect_same_thread (d, boost::bind (&receiver));
+
+	N = 0;
+	e->emit ();
+	CPPUNIT_ASSERT_EQUAL (1, N);
+
+	N = 0;
+	e->emit ();
+	CPPUNIT_ASSERT_EQUAL (1, N);
+
+	delete e;
+}
+
+class Counter
+{
+public:
+	Counter () : n (0) {}
+	void receiver (int x) { n += x; }
+	int n;
+};
+
+/** Every one of several slots sees every emission. The cost
+ *  of emission is measured by the signal_emission profiling program in
+ *  test/profiling.
+ */
+void
+SignalsTest::testEmissionToSeveralSlots ()
+{
+	PBD::Signal1<void, int> sig;
+	Counter counters[8];
+	PBD::ScopedConnectionList connections;
+
+	for (int i = 0; i < 8; ++i) {
+		sig.connect_same_thread (connections, boost::bind (&Counter::receiver, &counters[i], _1));
+	}
+
+	int const n_emissions = 1000;
+
+	for (int i = 0; i < n_emissions; ++i) {
+		sig (1);
+	}
+
+	for (int i = 0; i < 8; ++i) {
+		CPPUNIT_ASSERT_EQUAL (n_emissions, counters[i].n);
+	}
+}
@@ -5,6 +5,7 @@
 
 #include <unistd.h>
 #include <stdlib.h>
+#include <sstream>
 
 #ifdef PLATFORM_WINDOWS
 #include <fcntl.h>
@@ -17,6 +18,7 @@
 #include <libxml/xpath.h>
 
 #include "pbd/file_utils.h"
+#include "pbd/xml++.h"
 
 #include "test_common.h"
 
@@ -48,6 +50,14 @@ write_xml(const string& filename)
 	return true;
 }
 
+string
+dump (const XMLTree& tree)
+{
+	stringstream s;
+	tree.root()->dump (s);
+	return s.str();
+}
+
 }
 
 void
@@ -77,3 +87,78 @@ XMLTest::testXMLFilenameEncoding ()
 		CPPUNIT_ASSERT (write_xml (output_path));
 	}
 }
+
+void
+XMLTest::testXMLWriteRead ()
+{
+	std::string session_path;
+	CPPUNIT_ASSERT (find_file (test_search_path (), "TestSession.ardour", session_path));
+
+	XMLTree tree (session_path);
+	CPPUNIT_ASSERT (tree.root ());
+
+	string output_path = Glib::build_filename (test_output_directory ("XMLWriteRead"), "TestSession.ardour");
+	CPPUNIT_ASSERT (tree.write (output_path));
+
+	XMLTree copy (output_path);
+	CPPUNIT_ASSERT (copy.root ());
+	CPPUNIT_ASSERT_EQUAL (dump (tree), dump (copy));
+
+	/* find() still works on trees that were read from a file */
+	CPPUNIT_ASSERT_EQUAL ((size_t) 72, copy.find ("//Source")->size ());
+}
+
+void
+XMLTest::testXMLStreamRead ()
+{
+	std::string session_path;
+	CPPUNIT_ASSERT (find_file (test_search_path (), "TestSession.ardour", session_path));
+
+	/* the test session is indented, which must not add any nodes */
+	XMLTree streamed (session_path);
+	CPPUNIT_ASSERT (streamed.root ());
+	CPPUNIT_ASSERT_EQUAL (string ("Config"), streamed.root()->children().front()->name());
+
+	std::string contents = Glib::file_get_contents (session_path);
+
+	/* read_buffer() parses into a libxml document and copies that, as
+	 * reading a file did before it was streamed
+	 */
+	xmlKeepBlanksDefault(0);
+	XMLTree parsed;
+	CPPUNIT_ASSERT (parsed.read_buffer (contents));
+	CPPUNIT_ASSERT_EQUAL (dump (parsed), dump (streamed));
+}
+
+void
+XMLTest::testXMLCache ()
+{
+	std::string session_path;
+	CPPUNIT_ASSERT (find_file (test_search_path (), "TestSession.ardour", session_path));
+
+	string output_dir = test_output_directory ("XMLCache");
+	string xml_path = Glib::build_filename (output_dir, "TestSession.ardour");
+	string cache_path = xml_path + ".cache";
+
+	XMLTree tree (session_path);
+	CPPUNIT_ASSERT (tree.write (xml_path));
+
+	/* no cache yet: parses the file and writes the cache */
+	g_remove (cache_path.c_str ());
+	XMLTree parsed;
+	CPPUNIT_ASSERT (parsed.read_with_cache (xml_path, cache_path));
+	CPPUNIT_ASSERT (Glib::file_test (cache_path, Glib::FILE_TEST_EXISTS));
+
+	XMLTree cached;
+	CPPUNIT_ASSERT (cached.read_with_cache (xml_path, cache_path));
+	CPPUNIT_ASSERT_EQUAL (dump (parsed), dump (cached));
+
+	/* a cache for different contents must not be used */
+	XMLTree other;
+	other.set_root (new XMLNode ("Other"));
+	CPPUNIT_ASSERT (other.write_cache (session_path, cache_path));
+
+	XMLTree reread;
+	CPPUNIT_ASSERT (reread.read_with_cache (xml_path, cache_path));
+	CPPUNIT_ASSERT_EQUAL (dump (parsed), dump (reread));
+}
@@ -5,8 +5,14 @@ class XMLTest : public CppUnit::TestFixture
 {
 	CPPUNIT_TEST_SUITE (XMLTest);
 	CPPUNIT_TEST (testXMLFilenameEncoding);
+	CPPUNIT_TEST (testXMLWriteRead);
+	CPPUNIT_TEST (testXMLStreamRead);
+	CPPUNIT_TEST (testXMLCache);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
 	void testXMLFilenameEncoding ();
+	void testXMLWriteRead ();
+	void testXMLStreamRead ();
+	void testXMLCache ();
 };
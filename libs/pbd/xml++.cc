@@ -6,8 +6,17 @@
  */
 
 #include <iostream>
+#include <vector>
+#include <cstring>
+#include <stdint.h>
+
+#include <glib.h>
+#include "pbd/gstdio_compat.h"
+
 #include "pbd/xml++.h"
 #include <libxml/debugXML.h>
+#include <libxml/xmlreader.h>
+#include <libxml/xmlwriter.h>
 #include <libxml/xpath.h>
 #include <libxml/xpathInternals.h>
 
@@ -16,7 +25,9 @@ xmlChar* xml_version = xmlCharStrdup("1.0");
 using namespace std;
 
 static XMLNode*           readnode(xmlNodePtr);
+static XMLNode*           readstream(xmlTextReaderPtr);
 static void               writenode(xmlDocPtr, XMLNode*, xmlNodePtr, int);
+static bool               writestream(xmlTextWriterPtr, const XMLNode*, bool);
 static XMLSharedNodeList* find_impl(xmlXPathContext* ctxt, const string& xpath);
 
 XMLTree::XMLTree()
@@ -82,38 +93,52 @@ XMLTree::read_internal(bool validate)
 		_doc = 0;
 	}
 
-	/* create a parser context */
-	xmlParserCtxtPtr ctxt = xmlNewParserCtxt();
-	if (ctxt == NULL) {
-		return false;
-	}
-
-	xmlKeepBlanksDefault(0);
-	/* parse the file, activating the DTD validation option */
 	if (validate) {
+
+		/* create a parser context */
+		xmlParserCtxtPtr ctxt = xmlNewParserCtxt();
+		if (ctxt == NULL) {
+			return false;
+		}
+
+		xmlKeepBlanksDefault(0);
+		/* parse the file, activating the DTD validation option */
 		_doc = xmlCtxtReadFile(ctxt, _filename.c_str(), NULL, XML_PARSE_DTDVALID);
-	} else {
-		_doc = xmlCtxtReadFile(ctxt, _filename.c_str(), NULL, XML_PARSE_HUGE);
-	}
 
-	/* check if parsing suceeded */
-	if (_doc == NULL) {
-		xmlFreeParserCtxt(ctxt);
-		return false;
-	} else {
-		/* check if validation suceeded */
-		if (validate && ctxt->valid == 0) {
+		/* check if parsing suceeded */
+		if (_doc == NULL) {
+			xmlFreeParserCtxt(ctxt);
+			return false;
+		} else if (ctxt->valid == 0) {
+			/* check if validation suceeded */
 			xmlFreeParserCtxt(ctxt);
 			throw XMLException("Failed to validate document " + _filename);
 		}
+
+		_root = readnode(xmlDocGetRootElement(_doc));
+
+		/* free up the parser context */
+		xmlFreeParserCtxt(ctxt);
+
+		return true;
 	}
 
-	_root = readnode(xmlDocGetRootElement(_doc));
+	/* build our nodes while parsing the file, rather than parsing it into
+	 * a libxml document first and then copying that. The document is only
+	 * created if find() needs it. Like the document parser, drop the
+	 * whitespace that only indents the file.
+	 */
+	xmlKeepBlanksDefault(0);
+	xmlTextReaderPtr reader = xmlReaderForFile (_filename.c_str(), NULL, XML_PARSE_HUGE | XML_PARSE_NOBLANKS);
+	if (reader == NULL) {
+		return false;
+	}
 
-	/* free up the parser context */
-	xmlFreeParserCtxt(ctxt);
+	_root = readstream (reader);
 
-	return true;
+	xmlFreeTextReader (reader);
+
+	return _root != 0;
 }
 
 bool
@@ -138,25 +163,299 @@ XMLTree::read_buffer(const string& buffer)
 }
 
 
+/* Binary cache of a tree: a header identifying the XML file it was made
+ * from, followed by the nodes in document order. Every node is stored as
+ * its name, content flag, content, properties and children; strings as a
+ * 32 bit length followed by the bytes. Everything is in host byte order,
+ * caches are not meant to be portable.
+ */
+
+static const char     cache_magic[8] = { 'X', 'M', 'L', 'C', 'A', 'C', 'H', 'E' };
+static const uint32_t cache_version = 1;
+
+struct XMLCacheHeader {
+	char     magic[8];
+	uint32_t version;
+	uint32_t byte_order;
+	uint64_t file_size;
+	int64_t  file_mtime;
+	uint64_t file_hash;
+};
+
+/** FNV-1a */
+static uint64_t
+cache_hash (const char* data, size_t len)
+{
+	uint64_t h = 14695981039346656037ULL;
+	for (size_t i = 0; i < len; ++i) {
+		h ^= (unsigned char) data[i];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+/** Fill in the header for the current contents of @a fn */
+static bool
+cache_header (const string& fn, XMLCacheHeader& hdr)
+{
+	GStatBuf statbuf;
+	gchar* contents;
+	gsize length;
+
+	if (g_stat (fn.c_str(), &statbuf) != 0) {
+		return false;
+	}
+
+	if (!g_file_get_contents (fn.c_str(), &contents, &length, NULL)) {
+		return false;
+	}
+
+	memcpy (hdr.magic, cache_magic, sizeof (hdr.magic));
+	hdr.version = cache_version;
+	hdr.byte_order = 0x01020304;
+	hdr.file_size = length;
+	hdr.file_mtime = statbuf.st_mtime;
+	hdr.file_hash = cache_hash (contents, length);
+
+	g_free (contents);
+
+	return true;
+}
+
+static void
+cache_put (string& buf, uint32_t v)
+{
+	buf.append ((const char*) &v, sizeof (v));
+}
+
+static void
+cache_put (string& buf, const string& str)
+{
+	cache_put (buf, (uint32_t) str.length());
+	buf.append (str);
+}
+
+static void
+cache_node (string& buf, const XMLNode& node)
+{
+	cache_put (buf, node.name());
+	buf.push_back (node.is_content() ? 1 : 0);
+	cache_put (buf, node.content());
+
+	const XMLPropertyList& props (node.properties());
+	cache_put (buf, (uint32_t) props.size());
+	for (XMLPropertyConstIterator i = props.begin(); i != props.end(); ++i) {
+		cache_put (buf, (*i)->name());
+		cache_put (buf, (*i)->value());
+	}
+
+	const XMLNodeList& children (node.children());
+	cache_put (buf, (uint32_t) children.size());
+	for (XMLNodeConstIterator i = children.begin(); i != children.end(); ++i) {
+		cache_node (buf, **i);
+	}
+}
+
+namespace {
+
+class CacheReader {
+  public:
+	CacheReader (const char* data, size_t len) : _ptr (data), _end (data + len) {}
+
+	bool get (uint32_t& v) {
+		if (_end - _ptr < (ptrdiff_t) sizeof (v)) {
+			return false;
+		}
+		memcpy (&v, _ptr, sizeof (v));
+		_ptr += sizeof (v);
+		return true;
+	}
+
+	bool get (char& c) {
+		if (_ptr == _end) {
+			return false;
+		}
+		c = *_ptr++;
+		return true;
+	}
+
+	bool get (string& str) {
+		uint32_t len;
+		if (!get (len) || (size_t) (_end - _ptr) < len) {
+			return false;
+		}
+		str.assign (_ptr, len);
+		_ptr += len;
+		return true;
+	}
+
+	XMLNode* node () {
+		string name, content, value;
+		char is_content;
+		uint32_t n;
+
+		if (!get (name) || !get (is_content) || !get (content) || !get (n)) {
+			return 0;
+		}
+
+		XMLNode* node = new XMLNode (name);
+
+		if (is_content) {
+			node->set_content (content);
+		}
+
+		for (; n > 0; --n) {
+			if (!get (name) || !get (value)) {
+				delete node;
+				return 0;
+			}
+			node->add_property (name.c_str(), value);
+		}
+
+		if (!get (n)) {
+			delete node;
+			return 0;
+		}
+
+		for (; n > 0; --n) {
+			XMLNode* child = this->node ();
+			if (!child) {
+				delete node;
+				return 0;
+			}
+			node->add_child_nocopy (*child);
+		}
+
+		return node;
+	}
+
+	bool at_end () const { return _ptr == _end; }
+
+  private:
+	const char* _ptr;
+	const char* _end;
+};
+
+}
+
+bool
+XMLTree::read_with_cache(const string& fn, const string& cache)
+{
+	set_filename (fn);
+
+	if (read_cache (fn, cache)) {
+		return true;
+	}
+
+	if (!read_internal (false)) {
+		return false;
+	}
+
+	/* not fatal if this fails, e.g. for read-only sessions */
+	write_cache (fn, cache);
+
+	return true;
+}
+
+bool
+XMLTree::read_cache(const string& fn, const string& cache)
+{
+	XMLCacheHeader hdr;
+	XMLCacheHeader current;
+	gchar* contents;
+	gsize length;
+
+	if (!g_file_get_contents (cache.c_str(), &contents, &length, NULL)) {
+		return false;
+	}
+
+	if (length < sizeof (hdr) || !cache_header (fn, current)) {
+		g_free (contents);
+		return false;
+	}
+
+	memcpy (&hdr, contents, sizeof (hdr));
+
+	if (memcmp (hdr.magic, current.magic, sizeof (hdr.magic)) ||
+	    hdr.version != current.version ||
+	    hdr.byte_order != current.byte_order ||
+	    hdr.file_size != current.file_size ||
+	    hdr.file_mtime != current.file_mtime ||
+	    hdr.file_hash != current.file_hash) {
+		g_free (contents);
+		return false;
+	}
+
+	CacheReader reader (contents + sizeof (hdr), length - sizeof (hdr));
+	XMLNode* root = reader.node ();
+
+	g_free (contents);
+
+	if (!root || !reader.at_end ()) {
+		delete root;
+		return false;
+	}
+
+	delete _root;
+	_root = root;
+
+	if (_doc) {
+		xmlFreeDoc (_doc);
+		_doc = 0;
+	}
+
+	return true;
+}
+
+bool
+XMLTree::write_cache(const string& fn, const string& cache) const
+{
+	XMLCacheHeader hdr;
+	string buf;
+
+	if (!_root || !cache_header (fn, hdr)) {
+		return false;
+	}
+
+	buf.append ((const char*) &hdr, sizeof (hdr));
+	cache_node (buf, *_root);
+
+	return g_file_set_contents (cache.c_str(), buf.data(), buf.length(), NULL);
+}
+
 bool
 XMLTree::write() const
 {
-	xmlDocPtr doc;
-	XMLNodeList children;
-	int result;
+	xmlTextWriterPtr writer;
+	bool ok;
+
+	if (!_root) {
+		return false;
+	}
+
+	/* write our nodes straight to the file, without building a libxml
+	 * document first.
+	 */
+	writer = xmlNewTextWriterFilename (_filename.c_str(), _compression);
+	if (!writer) {
+		return false;
+	}
+
+	xmlTextWriterSetIndent (writer, 1);
+	xmlTextWriterSetIndentString (writer, (const xmlChar*) "  ");
+
+	ok = xmlTextWriterStartDocument (writer, "1.0", "UTF-8", NULL) >= 0
+		&& writestream (writer, _root, true)
+		&& xmlTextWriterEndDocument (writer) >= 0
+		&& xmlTextWriterFlush (writer) >= 0;
 
-	xmlKeepBlanksDefault(0);
-	doc = xmlNewDoc(xml_version);
-	xmlSetDocCompressMode(doc, _compression);
-	writenode(doc, _root, doc->children, 1);
-	result = xmlSaveFormatFileEnc(_filename.c_str(), doc, "UTF-8", 1);
 #ifndef NDEBUG
-	if (result == -1) {
+	if (!ok) {
 		xmlErrorPtr xerr = xmlGetLastError ();
 		if (!xerr) {
-			std::cerr << "unknown XML error during xmlSaveFormatFileEnc()." << std::endl;
+			std::cerr << "unknown XML error while writing " << _filename << std::endl;
 		} else {
-			std::cerr << "xmlSaveFormatFileEnc: error"
+			std::cerr << "XMLTree::write: error"
 				<< " domain: " << xerr->domain
 				<< " code: " << xerr->code
 				<< " msg: " << xerr->message
@@ -164,13 +463,9 @@ XMLTree::write() const
 		}
 	}
 #endif
-	xmlFreeDoc(doc);
+	xmlFreeTextWriter (writer);
 
-	if (result == -1) {
-		return false;
-	}
-
-	return true;
+	return ok;
 }
 
 void
@@ -242,7 +537,6 @@ XMLNode::clear_lists ()
 	XMLPropertyIterator curprop;
 
 	_selected_children.clear ();
-	_propmap.clear ();
 
 	for (curchild = _children.begin(); curchild != _children.end();	++curchild) {
 		delete *curchild;
@@ -262,22 +556,20 @@ XMLNode::operator= (const XMLNode& from)
 {
 	if (&from != this) {
 
-		XMLPropertyList props;
-		XMLPropertyIterator curprop;
-		XMLNodeList nodes;
-		XMLNodeIterator curnode;
+		XMLPropertyConstIterator curprop;
+		XMLNodeConstIterator curnode;
 
 		clear_lists ();
 
 		_name = from.name();
 		set_content(from.content());
 
-		props = from.properties();
+		const XMLPropertyList& props (from.properties());
 		for (curprop = props.begin(); curprop != props.end(); ++curprop) {
 			add_property((*curprop)->name().c_str(), (*curprop)->value());
 		}
 
-		nodes = from.children();
+		const XMLNodeList& nodes (from.children());
 		for (curnode = nodes.begin(); curnode != nodes.end(); ++curnode) {
 			add_child_copy(**curnode);
 		}
@@ -345,7 +637,9 @@ XMLNode::children(const string& n) const
 XMLNode*
 XMLNode::add_child(const char* n)
 {
-	return add_child_copy(XMLNode (n));
+	XMLNode* child = new XMLNode(n);
+	_children.insert(_children.end(), child);
+	return child;
 }
 
 void
@@ -373,6 +667,10 @@ XMLTree::find(const string xpath, XMLNode* node) const
 		writenode(doc, node, doc->children, 1);
 		ctxt = xmlXPathNewContext(doc);
 	} else {
+		if (!_doc && !_filename.empty()) {
+			/* the file was read without keeping a document */
+			_doc = xmlReadFile(_filename.c_str(), NULL, XML_PARSE_HUGE | XML_PARSE_NOBLANKS);
+		}
 		ctxt = xmlXPathNewContext(_doc);
 	}
 
@@ -404,14 +702,17 @@ XMLNode::add_content(const string& c)
 	return add_child_copy(XMLNode (string(), c));
 }
 
+/* Nodes have few properties, so a linear search of the list is faster
+ * than maintaining a map, and needs no std::string for the name.
+ */
+
 XMLProperty*
 XMLNode::property(const char* n)
 {
-	string ns(n);
-	map<string,XMLProperty*>::iterator iter;
-
-	if ((iter = _propmap.find(ns)) != _propmap.end()) {
-		return iter->second;
+	for (XMLPropertyIterator i = _proplist.begin(); i != _proplist.end(); ++i) {
+		if ((*i)->name() == n) {
+			return *i;
+		}
 	}
 
 	return 0;
@@ -420,10 +721,10 @@ XMLNode::property(const char* n)
 XMLProperty*
 XMLNode::property(const string& ns)
 {
-	map<string,XMLProperty*>::iterator iter;
-
-	if ((iter = _propmap.find(ns)) != _propmap.end()) {
-		return iter->second;
+	for (XMLPropertyIterator i = _proplist.begin(); i != _proplist.end(); ++i) {
+		if ((*i)->name() == ns) {
+			return *i;
+		}
 	}
 
 	return 0;
@@ -433,20 +734,15 @@ XMLProperty*
 XMLNode::add_property(const char* n, const string& v)
 {
 	string ns(n);
-        map<string,XMLProperty*>::iterator iter;
+	XMLProperty* tmp = property(ns);
 
-        if ((iter = _propmap.find(ns)) != _propmap.end()) {
-                iter->second->set_value (v);
-                return iter->second;
+	if (tmp) {
+		tmp->set_value (v);
+		return tmp;
 	}
 
-	XMLProperty* tmp = new XMLProperty(ns, v);
+	tmp = new XMLProperty(ns, v);
 
-	if (!tmp) {
-		return 0;
-	}
-
-	_propmap[tmp->name()] = tmp;
 	_proplist.insert(_proplist.end(), tmp);
 
 	return tmp;
@@ -470,11 +766,12 @@ XMLNode::add_property(const char* name, const long value)
 void
 XMLNode::remove_property(const string& n)
 {
-	if (_propmap.find(n) != _propmap.end()) {
-		XMLProperty* p = _propmap[n];
-		_proplist.remove (p);
-		delete p;
-		_propmap.erase(n);
+	for (XMLPropertyIterator i = _proplist.begin(); i != _proplist.end(); ++i) {
+		if ((*i)->name() == n) {
+			delete *i;
+			_proplist.erase (i);
+			return;
+		}
 	}
 }
 
@@ -593,13 +890,134 @@ readnode(xmlNodePtr node)
 	return tmp;
 }
 
+/** Build our nodes from the events of @a reader, the equivalent of parsing
+ *  into a document and calling readnode() on the root element.
+ */
+static XMLNode*
+readstream(xmlTextReaderPtr reader)
+{
+	vector<XMLNode*> open_nodes;
+	XMLNode* root = 0;
+	XMLNode* node;
+	const xmlChar* value;
+	bool empty;
+	int type;
+	int ret;
+
+	while ((ret = xmlTextReaderRead(reader)) == 1) {
+
+		switch ((type = xmlTextReaderNodeType(reader))) {
+		case XML_READER_TYPE_ELEMENT:
+			node = new XMLNode((const char*) xmlTextReaderConstLocalName(reader));
+			empty = xmlTextReaderIsEmptyElement(reader);
+
+			while (xmlTextReaderMoveToNextAttribute(reader) == 1) {
+				if (xmlTextReaderIsNamespaceDecl(reader)) {
+					continue;
+				}
+				value = xmlTextReaderConstValue(reader);
+				node->add_property((const char*) xmlTextReaderConstLocalName(reader), value ? (const char*) value : "");
+			}
+			break;
+
+		case XML_READER_TYPE_TEXT:
+		case XML_READER_TYPE_CDATA:
+		case XML_READER_TYPE_WHITESPACE:
+		case XML_READER_TYPE_SIGNIFICANT_WHITESPACE:
+		case XML_READER_TYPE_COMMENT:
+			node = new XMLNode(type == XML_READER_TYPE_COMMENT ? "comment" : "text");
+			value = xmlTextReaderConstValue(reader);
+			node->set_content(value ? (const char*) value : "");
+			empty = true;
+			break;
+
+		case XML_READER_TYPE_END_ELEMENT:
+			if (!open_nodes.empty()) {
+				open_nodes.pop_back();
+			}
+			continue;
+
+		default:
+			/* processing instructions, DTDs ... */
+			continue;
+		}
+
+		if (!open_nodes.empty()) {
+			open_nodes.back()->add_child_nocopy(*node);
+		} else if (!root && type == XML_READER_TYPE_ELEMENT) {
+			root = node;
+		} else {
+			/* comments etc. outside of the root element */
+			delete node;
+			continue;
+		}
+
+		if (!empty) {
+			open_nodes.push_back(node);
+		}
+	}
+
+	if (ret != 0) {
+		delete root;
+		return 0;
+	}
+
+	return root;
+}
+
+static bool
+writestream(xmlTextWriterPtr writer, const XMLNode* n, bool indent)
+{
+	if (n->is_content()) {
+		return xmlTextWriterWriteString(writer, (const xmlChar*) n->content().c_str()) >= 0;
+	}
+
+	if (xmlTextWriterStartElement(writer, (const xmlChar*) n->name().c_str()) < 0) {
+		return false;
+	}
+
+	const XMLPropertyList& props (n->properties());
+	for (XMLPropertyConstIterator curprop = props.begin(); curprop != props.end(); ++curprop) {
+		if (xmlTextWriterWriteAttribute(writer, (const xmlChar*) (*curprop)->name().c_str(), (const xmlChar*) (*curprop)->value().c_str()) < 0) {
+			return false;
+		}
+	}
+
+	const XMLNodeList& children (n->children());
+	bool child_indent = indent;
+
+	/* like xmlSaveFormatFile(), do not indent inside elements with text */
+	for (XMLNodeConstIterator curchild = children.begin(); child_indent && curchild != children.end(); ++curchild) {
+		if ((*curchild)->is_content()) {
+			child_indent = false;
+			xmlTextWriterSetIndent(writer, 0);
+		}
+	}
+
+	for (XMLNodeConstIterator curchild = children.begin(); curchild != children.end(); ++curchild) {
+		if (!writestream(writer, *curchild, child_indent)) {
+			return false;
+		}
+	}
+
+	if (xmlTextWriterEndElement(writer) < 0) {
+		return false;
+	}
+
+	if (child_indent != indent) {
+		/* the writer only ends the line if it was indenting */
+		xmlTextWriterSetIndent(writer, 1);
+		return xmlTextWriterWriteRaw(writer, (const xmlChar*) "\n") >= 0;
+	}
+
+	return true;
+}
+
 static void
 writenode(xmlDocPtr doc, XMLNode* n, xmlNodePtr p, int root = 0)
 {
-	XMLPropertyList props;
-	XMLPropertyIterator curprop;
-	XMLNodeList children;
-	XMLNodeIterator curchild;
+	XMLPropertyConstIterator curprop;
+	XMLNodeConstIterator curchild;
 	xmlNodePtr node;
 
 	if (root) {
@@ -613,12 +1031,12 @@ writenode(xmlDocPtr doc, XMLNode* n, xmlNodePtr p, int root = 0)
 		xmlNodeSetContentLen(node, (const xmlChar*)n->content().c_str(), n->content().length());
 	}
 
-	props = n->properties();
+	const XMLPropertyList& props (n->properties());
 	for (curprop = props.begin(); curprop != props.end(); ++curprop) {
 		xmlSetProp(node, (const xmlChar*) (*curprop)->name().c_str(), (const xmlChar*) (*curprop)->value().c_str());
 	}
 
-	children = n->children();
+	const XMLNodeList& children (n->children());
 	for (curchild = children.begin(); curchild != children.end(); ++curchild) {
 		writenode(doc, *curchild, node);
 	}